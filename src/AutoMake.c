@@ -24,6 +24,23 @@
 #include "types.h"
 #include "maths.h"
 #include "ini.h"
+#include "bench.h"
+#include "trace.h"
+#include "os.h"
+#include "builddb.h"
+#include "hdrcost.h"
+#include "incpath.h"
+#include "explain.h"
+#include "stamp.h"
+#include "cfgcache.h"
+#include "confh.h"
+#include "hotplace.h"
+#include "deadsrc.h"
+#include "prebuilt.h"
+#include "delta.h"
+#include "lzimg.h"
+#include "dist.h"
+#include "rcache.h"
 
 /*-----------------------------------------------------------------------------
  Section: Macro Definitions
@@ -31,7 +48,7 @@
 #define VERSION             "1.0.0"
 #define SOFTNAME            "AutoMake"
 
-#define MAX_C_FILES         (128)       /**< ͨһĿ¼cļ */
+#define MAX_CONFIGS         (8)         /**< -configs/-matrixʱ */
 
 #define DEFAULT_APP_NAME    "rtos"
 #define DEFAULT_SRC_DIR     "./"        /**< ĬԴĿ¼ */
@@ -46,6 +63,22 @@
 #define DEFAULT_LDFLAGS     " --specs=nano.specs"
 #define DEFAULT_EXCLUDE     ""  //bsp/test
 
+#define TRACE_SUFFIX        "_trace"    /**< ٰ汾Ŀ¼׺ */
+#define TRACE_DIR           "_trace"    /**< ٴڱĿ¼еλ */
+#define CONFIGS_SUFFIX      "_configs"  /**< makefileĿ¼׺ */
+#define CC_RSP              "cc.rsp"    /**< -rspʱӦļ(ڱĿ¼) */
+#define OBJS_RSP            "objs.rsp"  /**< -rspʱĿļӦļ */
+#define AR_LIST             ".lst"      /**< -arʱ̬Աб(lib<Ŀ¼>.lst) */
+#define LTO_STAMP           "lto.flags" /**< ӰĿļLTO, ıʱȫر */
+#define LTO_LINK_STAMP      "lto_link.flags" /**< ӰӵLTO, ıʱ */
+
+/** -confhʱдļ */
+#define FIXDEP_CMD          "\t@$(AUTOMAKE) -fixdep \"$(@:%%.o=%%.d)\"\n"
+
+#define INI_FILE            "./AutoMake.ini"
+#define CPROJECT_FILE       "./.cproject"
+#define CFG_CACHE_FILE      "./.automake_cfg"   /**< õı */
+
 #define FILE_HEAD           \
     "################################################################################\n"  \
     "# Automatically-generated file. Do not edit! by Liuning\n"                           \
@@ -54,34 +87,84 @@
 /*-----------------------------------------------------------------------------
  Section: Type Definitions
  ----------------------------------------------------------------------------*/
-/**  */
+/** ģʽ */
+typedef enum
+{
+    MODE_MAKE = 0,              /**< makefile */
+    MODE_BENCH,                 /**< ڷл׼ */
+    MODE_TRACE,                 /**< ٵļ */
+    MODE_BUILD,                 /**< makefile, ¼ʱ */
+    MODE_REPORT,                /**< ʱƱ */
+    MODE_HDRCOST,               /**< ͳƸͷļԤ */
+    MODE_INCPATH,               /**< ͳ-IĿ¼Ĳв˳ */
+    MODE_EXPLAIN,               /**< ĿļΪʲôҪ± */
+    MODE_HOTPLACE,              /**< ݰȵ㺯RAM */
+    MODE_DEADSRC,               /**< ҳȫ--gc-sectionsԴļ */
+} run_mode_e;
+
+/** ԴĿ¼(һ, ù) */
 typedef struct
 {
-    char SRC_DIR[256];          /**< ԴĿ¼ */
-    char BUILD_DIR[256];        /**< Ŀ¼ */
-    char APP[128];              /**< Ӧó */
-    char CROSS_COMPILE[128];    /**< gcc */
-    char I[2048];               /**< -Iͷļ */
-    char CCFLAGS[512];          /**< gcc */
-    char LDFLAGS[512];          /**< ld */
-    char L[1024];               /**< -L̬· */
-    char LIBS[512];             /**< -l̬ */
-    char LD[128];               /**< ldļ */
-    char EXCLUDE[1024 * 2];     /**< · */
-    char OTHER_D[64];           /**< -D */
-} make_cfg_t;
+    char path[MAX_PATH];        /**< Ŀ¼, "./\\app\\aid" */
+    int file_num;               /**< c/Sļ */
+    char (*pfile)[MAX_PATH];    /**< c/Sļ */
+} src_dir_t;
+
+/** ַ(Ӧļ) */
+typedef struct
+{
+    char *pbuf;
+    int len;
+    int max;
+} str_buf_t;
 
 /*-----------------------------------------------------------------------------
  Section: Local Variables
  ----------------------------------------------------------------------------*/
 static pcfg_t the_cfg;
 static make_cfg_t make_cfg;
+static make_cfg_t trace_cfg;
+static int the_obj_cnt;         /**< Դļ */
+static bool_e the_hdrcost;      /**< ʱռԴļͷļ */
+static bool_e the_incpath;      /**< ʱռԴļ-IĿ¼ */
+static bool_e the_rsp;          /**< 뼰ӲдӦļ */
+static bool_e the_confh;        /**< -Dдͷļ, õĺر */
+static bool_e the_lto;          /**< ʱŻ */
+static int the_lto_part;        /**< -ltoʱӷ */
+static bool_e the_lto_dep;      /**< 뼰ӹLTOļ */
+static bool_e the_hot;          /**< Ŀ¼hot.ld, ȵ㺯RAM */
+static bool_e the_matrix;       /**< ȡiniVARIANTS.cproject */
+static int the_ar;              /**< ÿĿ¼һ̬: 0, 1 thin, 2 */
+static str_buf_t the_ar_tops;   /**< -arʱõĶĿ¼(" app bsp ") */
+static bool_e the_prebuilt;     /**< PREBUILT_DIRS */
+static char the_top[MAX_PATH];  /**< makefileĿ¼(ԱĿ¼) */
+static const char *the_dist;    /**< -distĹб */
+static const char *the_cache;   /**< -cache/-cache-rwԶ̻ */
+static bool_e the_cache_rw;     /**< ϴԶ̻ */
+static str_buf_t the_objs;      /**< -rsp/-arʱõĿļ */
+static str_buf_t the_shared;    /**< -rsp/-arʱõĿļ */
+static src_dir_t *the_src;      /**< ԴĿ¼(Ŀ¼ǰ) */
+static int the_src_num;
+static int the_src_max;
+static make_cfg_t the_configs[MAX_CONFIGS];   /**< -configsʱĸ */
+static int the_config_num;
+static const make_cfg_t *the_share;     /**< ɵ, ɹĿļ */
+static int the_share_num;
+static bool_e the_share_used[MAX_CONFIGS];  /**< õЩõĿļ */
+static const char *const the_inputs[] = {INI_FILE, CPROJECT_FILE, NULL}; /**< ļ */
 
 /*-----------------------------------------------------------------------------
  Section: Local Function Prototypes
  ----------------------------------------------------------------------------*/
 /* None */
 
+/*-----------------------------------------------------------------------------
+ Section: Global Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern int
+cproject_cfg_get_all(pcfg_t *pcfgs,
+        int max);
+
 /*-----------------------------------------------------------------------------
  Section: Function Definitions
  ----------------------------------------------------------------------------*/
@@ -104,6 +187,42 @@ file_delete(const char *pfile)
     return OK;
 }
 
+/**
+ ******************************************************************************
+ * @brief   ׷ַ
+ * @param[in]  *ps   : ַ
+ * @param[in]  *pstr : ׷
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ڴ治
+ ******************************************************************************
+ */
+static status_t
+str_add(str_buf_t *ps,
+        const char *pstr)
+{
+    int len = strlen(pstr);
+    int max;
+    char *p;
+
+    if (ps->len + len + 1 > ps->max)
+    {
+        max = MAX(ps->max * 2, ps->len + len + 1);
+        max = MAX(max, 1024);
+        p = realloc(ps->pbuf, max);
+        if (!p)
+        {
+            return ERROR;
+        }
+        ps->pbuf = p;
+        ps->max = max;
+    }
+    memcpy(ps->pbuf + ps->len, pstr, len + 1);
+    ps->len += len;
+
+    return OK;
+}
+
 /**
  ******************************************************************************
  * @brief   ɾĿ¼
@@ -211,36 +330,153 @@ check_path(const char *path)
  * @brief   չĿ¼(-I -L)
  * @param[in]  *phead : ͷ
  * @param[in]  *pin   : Ŀ¼
- * @param[out] *pout  : ַ
- * @param[in]  len    : 泤
+ * @param[out] **pout : ַ(malloc, Ȳ)
  *
- * @retval  OK : ɹ
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ڴ治
  ******************************************************************************
  */
 status_t
 path_ex(const char *phead,
         const char *pin,
-        char *pout,
-        int len)
+        char **pout)
 {
     //: "sys/lib;app/meter"
     //: -L"../sys/lib" -L"../app/meter"
+    int n = 0;
     char *p;
+    char *q;
+    char *tmp;
     char *delim = ";| ";
-    char tmp[1024];
 
-    strncpy(tmp, pin, sizeof(tmp));
-    p = strtok(tmp, delim);
+    //ÿĿ¼' ' phead '"../' '"'
+    for (p = (char *)pin; *p; p++)
+    {
+        if (!strchr(delim, *p) && ((p == pin) || strchr(delim, p[-1])))
+        {
+            n++;
+        }
+    }
+    tmp = strdup(pin);
+    *pout = malloc(strlen(pin) + n * (strlen(phead) + 6) + 1);
+    if (!tmp || !*pout)
+    {
+        free(tmp);
+        free(*pout);
+        *pout = NULL;
+        return ERROR;
+    }
 
+    q = *pout;
+    *q = 0;
+    p = strtok(tmp, delim);
     while (p)
     {
-        pout += sprintf(pout, " %s\"../%s\"", phead, p);
+        q += sprintf(q, " %s\"../%s\"", phead, p);
         p = strtok(NULL, delim);
     }
+    free(tmp);
 
     return OK;
 }
 
+/**
+ ******************************************************************************
+ * @brief   ȡ·һ("./_BUILD_Debug""_BUILD_Debug")
+ * @param[in]  *path : ·
+ *
+ * @return  һ
+ ******************************************************************************
+ */
+static const char *
+path_name(const char *path)
+{
+    const char *p = path;
+
+    for (; *path; path++)
+    {
+        if ((*path == '/') || (*path == '\\'))
+        {
+            p = path + 1;
+        }
+    }
+    return p;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ɱĿ¼صԴĿ¼·("./out/_BUILD""../..")
+ * @param[in]  *pdir : Ŀ¼(ԴĿ¼)
+ * @param[out] *pout : ·
+ * @param[in]  len   : 泤
+ *
+ * @return  None
+ ******************************************************************************
+ */
+static void
+path_root(const char *pdir,
+        char *pout,
+        int len)
+{
+    int n = 0;
+    const char *p;
+
+    pout[0] = 0;
+    for (p = pdir; *p; )
+    {
+        while ((*p == '/') || (*p == '\\'))
+        {
+            p++;
+        }
+        if (!*p)
+        {
+            break;
+        }
+        if (!((p[0] == '.') && ((p[1] == '/') || (p[1] == '\\') || !p[1])) && (n + 4 < len))
+        {
+            n += sprintf(pout + n, n ? "/.." : "..");
+        }
+        while (*p && (*p != '/') && (*p != '\\'))
+        {
+            p++;
+        }
+    }
+    if (!n)
+    {
+        snprintf(pout, len, ".");
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ıʶ(汾ִļ޸ʱ, ), ָ
+ *
+ * @return  ʶַ
+ *
+ * @note    AutoMake(ɽ򻺴ṹܲͬ)ʱϴεɽ
+ ******************************************************************************
+ */
+static const char *
+build_id(void)
+{
+    char self[MAX_PATH];
+    struct _stat buf;
+    static char id[64];
+
+    if (!id[0])
+    {
+        if (GetModuleFileName(NULL, self, sizeof(self)) && !_stat(self, &buf))
+        {
+            snprintf(id, sizeof(id), "%s %ld %ld", VERSION, (long)buf.st_mtime, (long)buf.st_size);
+        }
+        else
+        {
+            snprintf(id, sizeof(id), "%s %s %s", VERSION, __DATE__, __TIME__);
+        }
+    }
+    return id;
+}
+
 /**
  ******************************************************************************
  * @brief   ȡ
@@ -253,11 +489,28 @@ path_ex(const char *phead,
 static status_t
 make_cfg_init(make_cfg_t *pcfg)
 {
+    static make_cfg_t cache;
+    uint64 key;
+    char *pstr[2];
+
     /*
+     * 0. ini.cprojectûб仯ʱֱʹϴνĽ
      * 1. ļжȡ
      * 2. .cprojectжȡ
      * 3. Ĭֵ
      */
+    key = stamp_key(build_id(), the_inputs);
+    if (OK == cfgcache_load(CFG_CACHE_FILE, key, &cache, sizeof(cache),
+            pstr, ARRAY_SIZE(pstr)))
+    {
+        //-D, 
+        memcpy(cache.OTHER_D, pcfg->OTHER_D, sizeof(cache.OTHER_D));
+        memcpy(pcfg, &cache, sizeof(*pcfg));
+        pcfg->I = pstr[0];
+        pcfg->L = pstr[1];
+        return OK;
+    }
+
     if (0 != ini_get_info(&the_cfg))
     {
         printf("ini get info err!\n");
@@ -268,9 +521,9 @@ make_cfg_init(make_cfg_t *pcfg)
 #if 0
     strncpy(pcfg->APP, DEFAULT_APP_NAME, sizeof(pcfg->APP));
     strncpy(pcfg->CROSS_COMPILE, DEFAULT_COMPILE, sizeof(pcfg->CROSS_COMPILE));
-    path_ex("-I", DEFAULT_I, pcfg->I, sizeof(pcfg->I));
+    path_ex("-I", DEFAULT_I, &pcfg->I);
     strncpy(pcfg->CCFLAGS, DEFAULT_CCFLAGS, sizeof(pcfg->CCFLAGS));
-    path_ex("-L", DEFAULT_L, pcfg->L, sizeof(pcfg->L));
+    path_ex("-L", DEFAULT_L, &pcfg->L);
     strncpy(pcfg->LIBS, DEFAULT_LIBS, sizeof(pcfg->LIBS));
     strncpy(pcfg->LD, DEFAULT_LD, sizeof(pcfg->LD));
     strncpy(pcfg->LDFLAGS, DEFAULT_LDFLAGS, sizeof(pcfg->LDFLAGS));
@@ -280,23 +533,82 @@ make_cfg_init(make_cfg_t *pcfg)
     strncpy(pcfg->BUILD_DIR, the_cfg.BUILD_DIR, sizeof(pcfg->BUILD_DIR));
     strncpy(pcfg->APP, the_cfg.APP, sizeof(pcfg->APP));
     strncpy(pcfg->CROSS_COMPILE, the_cfg.CROSS_COMPILE, sizeof(pcfg->CROSS_COMPILE));
-    path_ex("-I", the_cfg.I, pcfg->I, sizeof(pcfg->I));
+    if ((OK != path_ex("-I", the_cfg.I, &pcfg->I))
+            || (OK != path_ex("-L", the_cfg.L, &pcfg->L)))
+    {
+        return ERROR;
+    }
     strncpy(pcfg->CCFLAGS, the_cfg.CCFLAGS, sizeof(pcfg->CCFLAGS));
-    path_ex("-L", the_cfg.L, pcfg->L, sizeof(pcfg->L));
     strncpy(pcfg->LIBS, the_cfg.LIBS, sizeof(pcfg->LIBS));
     strncpy(pcfg->LD, the_cfg.LD, sizeof(pcfg->LD));
     strncpy(pcfg->LDFLAGS, the_cfg.LDFLAGS, sizeof(pcfg->LDFLAGS));
     strncpy(pcfg->EXCLUDE, the_cfg.EXCLUDE, sizeof(pcfg->EXCLUDE));
+    strncpy(pcfg->BENCH_SIM, the_cfg.BENCH_SIM, sizeof(pcfg->BENCH_SIM));
+    strncpy(pcfg->BENCH_FUNCS, the_cfg.BENCH_FUNCS, sizeof(pcfg->BENCH_FUNCS));
+    pcfg->BENCH_CPI = atof(the_cfg.BENCH_CPI);
+    strncpy(pcfg->TRACE_DIRS, the_cfg.TRACE_DIRS, sizeof(pcfg->TRACE_DIRS));
+    strncpy(pcfg->MAKE, the_cfg.MAKE, sizeof(pcfg->MAKE));
+    strncpy(pcfg->PREBUILT_DIRS, the_cfg.PREBUILT_DIRS, sizeof(pcfg->PREBUILT_DIRS));
+    strncpy(pcfg->PREBUILT_STORE, the_cfg.PREBUILT_STORE, sizeof(pcfg->PREBUILT_STORE));
+    strncpy(pcfg->DELTA_REF, the_cfg.DELTA_REF, sizeof(pcfg->DELTA_REF));
+    strncpy(pcfg->LZ_SECTIONS, the_cfg.LZ_SECTIONS, sizeof(pcfg->LZ_SECTIONS));
 #endif
 
+    //ûiniʱոմĬini, ¼ָ
+    memcpy(&cache, pcfg, sizeof(cache));
+    cache.OTHER_D[0] = 0;
+    pstr[0] = pcfg->I;
+    pstr[1] = pcfg->L;
+    cfgcache_save(CFG_CACHE_FILE, stamp_key(build_id(), the_inputs), &cache, sizeof(cache),
+            (const char *const *)pstr, ARRAY_SIZE(pstr));
+
     return OK;
 }
 
+/**
+ ******************************************************************************
+ * @brief   ǷΪĿ¼(_trace, _configs, _), Դʱ
+ * @param[in]  *path  : ԴĿ¼µĿ¼
+ * @param[in]  *pname : Ŀ¼
+ *
+ * @retval  E_TRUE  : Ŀ¼
+ * @retval  E_FALSE : ԴĿ¼
+ *
+ * @note    ɵsources.mk, _BUILDtoolsͬǰ׺ԴĿ¼
+ ******************************************************************************
+ */
+static bool_e
+is_build_dir(const char *path,
+        const char *pname)
+{
+    int len;
+    char tmp[MAX_PATH];
+    struct _stat buf;
+    const char *pbuild = path_name(make_cfg.BUILD_DIR);
+
+    len = strlen(pbuild);
+    if (strncmp(pname, pbuild, len))
+    {
+        return E_FALSE;
+    }
+    if (!pname[len])
+    {
+        return E_TRUE;
+    }
+    if (pname[len] != '_')
+    {
+        return E_FALSE;
+    }
+    snprintf(tmp, sizeof(tmp), "%s/sources.mk", path);
+    return _stat(tmp, &buf) ? E_FALSE : E_TRUE;
+}
+
 /**
  ******************************************************************************
  * @brief   жĿ¼/ļǷ񲻲
- * @param[in]  *pcfg     : 
- * @param[in]  *path : ·
+ * @param[in]  *pcfg    : 
+ * @param[in]  *path    : ·
+ * @param[in]  verbose  : ųʱǷӡ
  *
  * @retval  TRUE  : 
  * @retval  FALSE : 
@@ -304,15 +616,16 @@ make_cfg_init(make_cfg_t *pcfg)
  */
 static bool_e
 is_path_need_compile(const make_cfg_t *pcfg,
-        const char *path)
+        const char *path,
+        bool_e verbose)
 {
     //bsp/test|sys/test
 
     int i;
-    char *p;
-    char *delim = ";| ";
+    int len;
+    const char *p = pcfg->EXCLUDE;
+    const char *delim = ";| ";
     char path_tmp[MAX_PATH + 1];
-    char exclude_tmp[MAX_PATH + 1];
 
     if (!strcmp("./", path))
     {
@@ -326,127 +639,445 @@ is_path_need_compile(const make_cfg_t *pcfg,
     }
     path_tmp[i] = 0;
 
-    for (i = 0; (i < MAX_PATH) && pcfg->EXCLUDE[i]; i++)
-    {
-        exclude_tmp[i] = (pcfg->EXCLUDE[i] == '\\') ? '/' : pcfg->EXCLUDE[i];
-    }
-    exclude_tmp[i] = 0;
-
-    p = strtok(exclude_tmp, delim);
-
-    while (p)
+    //EXCLUDEԭȽ(, Ȳ)
+    while (*p)
     {
-        if (!strcmp(p, path_tmp))
+        p += strspn(p, delim);
+        len = strcspn(p, delim);
+        for (i = 0; (i < len) && (((p[i] == '\\') ? '/' : p[i]) == path_tmp[i]); i++)
+        {
+        }
+        if (len && (i == len) && !path_tmp[len])
         {
-            printf("exclude path: %s\n", path_tmp);
+            if (verbose)
+            {
+                printf("exclude path: %s\n", path_tmp);
+            }
             return FALSE;
         }
-        p = strtok(NULL, delim);
+        p += len;
     }
     return TRUE;
 }
 
 /**
  ******************************************************************************
- * @brief   subdir.mkļ
- * @param[in]  *pcfg     : 
- * @param[in]  *path     : ·
- * @param[in]  *proot    : ʱ·
- * @param[in]  file_name : ļб
- * @param[in]  file_cnt  : ļ
- *
- * @retval  OK    : ɹ
- * @retval  ERROR : ʧ
+ * @brief   жĿ¼Ƿ(ϼĿ¼ųʱ)
+ * @param[in]  *pcfg    : 
+ * @param[in]  *dir     : Ŀ¼
+ * @param[in]  verbose  : Ŀ¼ųʱǷӡ
  *
- * @note
- *  1. C_SRCS += xx.c
- *  2. OBJS += xx.o
- *  3. C_DEPS += xx.d
- *  4. app/aid/%.o: ../app/aid/%.c
- *      @echo 'Building file: $<'
- *      @echo 'Invoking: Cross ARM C Compiler'
- *      arm-none-eabi-gcc .....
- *      @echo 'Finished building: $<'
- *      @echo ' '
+ * @retval  TRUE  : 
+ * @retval  FALSE : 
  ******************************************************************************
  */
-status_t
-subdir_mk_create(const make_cfg_t *pcfg,
-        const char *path,
-        const char *proot,
-        char file_name[MAX_C_FILES][MAX_PATH],
-        int file_cnt)
+static bool_e
+is_dir_need_compile(const make_cfg_t *pcfg,
+        const char *dir,
+        bool_e verbose)
 {
     int i;
-    int j;
-    bool_e have_S = FALSE;
+    int len;
+    char c;
     char tmp[MAX_PATH];
-    FILE *pfd = NULL;
-    status_t ret = ERROR;
 
-//    printf("path: %s, root:%s\n", path, proot);
-    do
-    {
-        //Ŀ¼
-        snprintf(tmp, sizeof(tmp), "%s%s", proot, path + 2);
-        if (OK != dir_create(tmp))
-        {
-            break;
-        }
+    strncpy(tmp, dir, sizeof(tmp) - 1);
+    tmp[sizeof(tmp) - 1] = 0;
+    len = strlen(tmp);
 
-        //subdir.mkļ
-        snprintf(tmp, sizeof(tmp), "%s%s/subdir.mk", proot, path + 2);
-        pfd = fopen(tmp, "w+");
-        if (!pfd)
-        {
-            break;
-        }
-        fprintf(pfd, FILE_HEAD);
-        fprintf(pfd, "# Add inputs and outputs from these tool invocations to the build variables \n");
-        //1. C_SRCS
-        fprintf(pfd, "C_SRCS += ");
-        for (i = 0; i < file_cnt; i++)
+    //ǰ3ַ"./\"
+    for (i = 3; i < len; i++)
+    {
+        if ((tmp[i] == '\\') || (tmp[i] == '/'))
         {
-            for (j = 0; (j < MAX_PATH) && file_name[i][j + 3]; j++)
+            c = tmp[i];
+            tmp[i] = 0;
+            if (TRUE != is_path_need_compile(pcfg, tmp, FALSE))
             {
-                tmp[j] = (file_name[i][j + 3] == '\\') ? '/' : file_name[i][j + 3];
+                return FALSE;
             }
-            if (tmp[j - 1] != 'c') continue; //ֻ.cļ
-            tmp[j - 1] = 0;
-            fprintf(pfd, "\\\n../%sc ", tmp); //*.c
+            tmp[i] = c;
         }
+    }
+    return is_path_need_compile(pcfg, dir, verbose);
+}
 
-        //2. S_UPPER_SRCS
-        fprintf(pfd, "\n\nS_UPPER_SRCS += ");
-        for (i = 0; i < file_cnt; i++)
+/**
+ ******************************************************************************
+ * @brief   жĿ¼ǷҪ(-finstrument-functions)
+ * @param[in]  *pcfg : 
+ * @param[in]  *path : ·
+ *
+ * @retval  TRUE  : Ҫ(TRACE_DIRSеĿ¼Ŀ¼)
+ * @retval  FALSE : Ҫ
+ ******************************************************************************
+ */
+static bool_e
+is_path_need_trace(const make_cfg_t *pcfg,
+        const char *path)
+{
+    int i;
+    int len;
+    char *p;
+    char *delim = ";| ";
+    char path_tmp[MAX_PATH + 1];
+    char trace_tmp[sizeof(pcfg->TRACE_DIRS)];
+
+    if (!pcfg->TRACE || (strlen(path) < 3))
+    {
+        return FALSE;
+    }
+    path += 3;
+
+    for (i = 0; (i < MAX_PATH) && path[i]; i++)
+    {
+        path_tmp[i] = (path[i] == '\\') ? '/' : path[i];
+    }
+    path_tmp[i] = 0;
+
+    for (i = 0; (i < (int)sizeof(trace_tmp) - 1) && pcfg->TRACE_DIRS[i]; i++)
+    {
+        trace_tmp[i] = (pcfg->TRACE_DIRS[i] == '\\') ? '/' : pcfg->TRACE_DIRS[i];
+    }
+    trace_tmp[i] = 0;
+
+    for (p = strtok(trace_tmp, delim); p; p = strtok(NULL, delim))
+    {
+        len = strlen(p);
+        while ((len > 0) && (p[len - 1] == '/'))
         {
-            for (j = 0; (j < MAX_PATH) && file_name[i][j + 3]; j++)
-            {
-                tmp[j] = (file_name[i][j + 3] == '\\') ? '/' : file_name[i][j + 3];
-            }
-            if (tmp[j - 1] != 'S') continue; //ֻ.Sļ
-            tmp[j - 1] = 0;
-            fprintf(pfd, "\\\n../%sS ", tmp); //*.S
-            have_S = TRUE;
+            p[--len] = 0;
         }
-
-        //3. OBJS
-        fprintf(pfd, "\n\nOBJS += ");
-        for (i = 0; i < file_cnt; i++)
+        if (!strncmp(p, path_tmp, len) && ((path_tmp[len] == 0) || (path_tmp[len] == '/')))
         {
-            for (j = 0; (j < MAX_PATH) && file_name[i][j + 3]; j++)
-            {
-                tmp[j] = (file_name[i][j + 3] == '\\') ? '/' : file_name[i][j + 3];
-            }
-            tmp[j - 1] = 0;
-            fprintf(pfd, "\\\n./%so ", tmp); //*.o
+            return TRUE;
         }
+    }
+    return FALSE;
+}
 
-        //4. S_UPPER_DEPS
-        fprintf(pfd, "\n\nS_UPPER_DEPS += ");
-        for (i = 0; i < file_cnt; i++)
-        {
-            for (j = 0; (j < MAX_PATH) && file_name[i][j + 3]; j++)
+/**
+ ******************************************************************************
+ * @brief   ɱõٰ汾ı
+ * @param[in]  *pcfg   : 
+ * @param[out] *ptrace : ٰ汾
+ *
+ * @return  None
+ ******************************************************************************
+ */
+static void
+trace_cfg_get(const make_cfg_t *pcfg,
+        make_cfg_t *ptrace)
+{
+    memcpy(ptrace, pcfg, sizeof(*ptrace));
+    strncat(ptrace->BUILD_DIR, TRACE_SUFFIX,
+            sizeof(ptrace->BUILD_DIR) - strlen(ptrace->BUILD_DIR) - 1);
+    ptrace->TRACE = TRUE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   еgcc
+ * @param[in]  *pcfg : 
+ *
+ * @return  gcc(-confhʱȥ-D, Ϊ-includeͷļ)
+ ******************************************************************************
+ */
+static const char *
+cc_flags(const make_cfg_t *pcfg)
+{
+    static char flags[MEMBER_SIZE(make_cfg_t, CCFLAGS) + sizeof(CONFH_FILE) + 32];
+
+    if (!the_confh && !the_lto)
+    {
+        return pcfg->CCFLAGS;
+    }
+    if (the_confh)
+    {
+        confh_strip(pcfg->CCFLAGS, flags, MEMBER_SIZE(make_cfg_t, CCFLAGS));
+        strcat(flags, " -include " CONFH_FILE);
+    }
+    else
+    {
+        strcpy(flags, pcfg->CCFLAGS);
+    }
+    if (the_lto)
+    {
+        strcat(flags, " -flto");
+    }
+
+    return flags;
+}
+
+/**
+ ******************************************************************************
+ * @brief   LTOļlto.flagslto_link.flags, ݲʱд
+ * @param[in]  *proot : ʱ·
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note    -fltoĿļֻм, LTOȫر. δù
+ *          -ltoıĿ¼, Ҳ
+ ******************************************************************************
+ */
+static status_t
+lto_stamp_create(const char *proot)
+{
+    int len;
+    char tmp[MAX_PATH];
+    char flags[64];
+    struct _stat buf;
+
+    snprintf(tmp, sizeof(tmp), "%s/%s", proot, LTO_STAMP);
+    the_lto_dep = (the_lto || !_stat(tmp, &buf)) ? TRUE : FALSE;
+    if (!the_lto_dep)
+    {
+        return OK;
+    }
+    len = snprintf(flags, sizeof(flags), "%s\n", the_lto ? "-flto" : "");
+    if (OK != os_fupdate(tmp, flags, len))
+    {
+        return ERROR;
+    }
+    snprintf(tmp, sizeof(tmp), "%s/%s", proot, LTO_LINK_STAMP);
+    len = the_lto ? snprintf(flags, sizeof(flags), "-flto-partition=balanced %d\n", the_lto_part)
+            : snprintf(flags, sizeof(flags), "\n");
+
+    return os_fupdate(tmp, flags, len);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ɱӦļcc.rsp(gcc @cc.rsp), ݲʱд
+ * @param[in]  *pcfg  : 
+ * @param[in]  *proot : ʱ·
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note    Ӧļзбת, -I·ͳһΪ'/'
+ ******************************************************************************
+ */
+static status_t
+rsp_cc_create(const make_cfg_t *pcfg,
+        const char *proot)
+{
+    int pos;
+    char *p;
+    char tmp[MAX_PATH];
+    str_buf_t rsp = {NULL, 0, 0};
+    status_t ret = ERROR;
+
+    do
+    {
+        if ((OK != str_add(&rsp, cc_flags(pcfg)))
+                || (OK != str_add(&rsp, (pcfg->OTHER_D[0] && !the_confh) ? " " : ""))
+                || (OK != str_add(&rsp, the_confh ? "" : pcfg->OTHER_D)))
+        {
+            break;
+        }
+        pos = rsp.len;
+        if ((OK != str_add(&rsp, pcfg->I))
+                || (OK != str_add(&rsp, "\n")))
+        {
+            break;
+        }
+        for (p = rsp.pbuf + pos; *p; p++)
+        {
+            if (*p == '\\')
+            {
+                *p = '/';
+            }
+        }
+        snprintf(tmp, sizeof(tmp), "%s/%s", proot, CC_RSP);
+        ret = os_fupdate(tmp, rsp.pbuf, rsp.len);
+    } while (0);
+    free(rsp.pbuf);
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ĿļӦļobjs.rsp, ݲʱд
+ * @param[in]  *proot : ʱ·
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+static status_t
+rsp_objs_create(const char *proot)
+{
+    char tmp[MAX_PATH];
+
+    //ûĿļʱpbufҲΪNULL
+    if ((OK != str_add(&the_objs, ""))
+            || (OK != str_add(&the_objs, the_shared.pbuf ? the_shared.pbuf : "")))
+    {
+        return ERROR;
+    }
+    snprintf(tmp, sizeof(tmp), "%s/%s", proot, OBJS_RSP);
+
+    return os_fupdate(tmp, the_objs.pbuf, the_objs.len);
+}
+
+/**
+ ******************************************************************************
+ * @brief   subdir.mkļ
+ * @param[in]  *pcfg     : 
+ * @param[in]  *path     : ·
+ * @param[in]  *proot    : ʱ·
+ * @param[in]  file_name : ļб
+ * @param[in]  file_cnt  : ļ
+ * @param[in]  *pshare   : ĿļıĿ¼("../_BUILD_Debug"), NULL
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note
+ *  0. ʱֻSHARED_OBJS += ../_BUILD_Debug/xx.o, ɸĿ¼makefile
+ *  1. C_SRCS += xx.c
+ *  2. OBJS += xx.o
+ *  3. C_DEPS += xx.d
+ *  4. app/aid/%.o: ../app/aid/%.c
+ *      @echo 'Building file: $<'
+ *      @echo 'Invoking: Cross ARM C Compiler'
+ *      arm-none-eabi-gcc .....
+ *      @echo 'Finished building: $<'
+ *      @echo ' '
+ ******************************************************************************
+ */
+status_t
+subdir_mk_create(const make_cfg_t *pcfg,
+        const char *path,
+        const char *proot,
+        const char *const file_name[],
+        int file_cnt,
+        const char *pshare)
+{
+    int i;
+    int j;
+    bool_e have_S = FALSE;
+    char tmp[MAX_PATH];
+    char dir[MAX_PATH];
+    FILE *pfd = NULL;
+    status_t ret = ERROR;
+
+//    printf("path: %s, root:%s\n", path, proot);
+    do
+    {
+        //Ŀ¼
+        snprintf(tmp, sizeof(tmp), "%s%s", proot, path + 2);
+        if (OK != dir_create(tmp))
+        {
+            break;
+        }
+
+        //subdir.mkļ
+        snprintf(tmp, sizeof(tmp), "%s%s/subdir.mk", proot, path + 2);
+        pfd = fopen(tmp, "w+");
+        if (!pfd)
+        {
+            break;
+        }
+        fprintf(pfd, FILE_HEAD);
+
+        //0. ɵͬ, ֱĿļ
+        if (pshare)
+        {
+            fprintf(pfd, "# Same command line as %s, objects are built there\n", pshare);
+            fprintf(pfd, "SHARED_OBJS += ");
+            for (i = 0; i < file_cnt; i++)
+            {
+                for (j = 0; (j < MAX_PATH) && file_name[i][j + 3]; j++)
+                {
+                    tmp[j] = (file_name[i][j + 3] == '\\') ? '/' : file_name[i][j + 3];
+                }
+                tmp[j - 1] = 0;
+                fprintf(pfd, "\\\n%s/%so ", pshare, tmp); //*.o
+                if (the_rsp || the_ar)
+                {
+                    snprintf(dir, sizeof(dir), "%s/%so\n", pshare, tmp);
+                    if (OK != str_add(&the_shared, dir))
+                    {
+                        break;
+                    }
+                }
+            }
+            if (i < file_cnt)
+            {
+                break;
+            }
+            for (j = 0; (j < MAX_PATH) && path[j + 3]; j++)
+            {
+                dir[j] = (path[j + 3] == '\\') ? '/' : path[j + 3];
+            }
+            dir[j] = 0;
+            fprintf(pfd, "\n\n%s/%s/%%.o:\n", pshare, dir);
+            fprintf(pfd, "\t$(MAKE) --no-print-directory -C %s %s/$*.o\n\n", pshare, dir);
+            ret = OK;
+            break;
+        }
+
+        fprintf(pfd, "# Add inputs and outputs from these tool invocations to the build variables \n");
+        //1. C_SRCS
+        fprintf(pfd, "C_SRCS += ");
+        for (i = 0; i < file_cnt; i++)
+        {
+            for (j = 0; (j < MAX_PATH) && file_name[i][j + 3]; j++)
+            {
+                tmp[j] = (file_name[i][j + 3] == '\\') ? '/' : file_name[i][j + 3];
+            }
+            if (tmp[j - 1] != 'c') continue; //ֻ.cļ
+            tmp[j - 1] = 0;
+            fprintf(pfd, "\\\n../%sc ", tmp); //*.c
+        }
+
+        //2. S_UPPER_SRCS
+        fprintf(pfd, "\n\nS_UPPER_SRCS += ");
+        for (i = 0; i < file_cnt; i++)
+        {
+            for (j = 0; (j < MAX_PATH) && file_name[i][j + 3]; j++)
+            {
+                tmp[j] = (file_name[i][j + 3] == '\\') ? '/' : file_name[i][j + 3];
+            }
+            if (tmp[j - 1] != 'S') continue; //ֻ.Sļ
+            tmp[j - 1] = 0;
+            fprintf(pfd, "\\\n../%sS ", tmp); //*.S
+            have_S = TRUE;
+        }
+
+        //3. OBJS
+        fprintf(pfd, "\n\nOBJS += ");
+        for (i = 0; i < file_cnt; i++)
+        {
+            for (j = 0; (j < MAX_PATH) && file_name[i][j + 3]; j++)
+            {
+                tmp[j] = (file_name[i][j + 3] == '\\') ? '/' : file_name[i][j + 3];
+            }
+            tmp[j - 1] = 0;
+            fprintf(pfd, "\\\n./%so ", tmp); //*.o
+            if (the_rsp || the_ar)
+            {
+                snprintf(dir, sizeof(dir), "./%so\n", tmp);
+                if (OK != str_add(&the_objs, dir))
+                {
+                    break;
+                }
+            }
+        }
+        if (i < file_cnt)
+        {
+            break;
+        }
+
+        //4. S_UPPER_DEPS
+        fprintf(pfd, "\n\nS_UPPER_DEPS += ");
+        for (i = 0; i < file_cnt; i++)
+        {
+            for (j = 0; (j < MAX_PATH) && file_name[i][j + 3]; j++)
             {
                 tmp[j] = (file_name[i][j + 3] == '\\') ? '/' : file_name[i][j + 3];
             }
@@ -478,35 +1109,56 @@ subdir_mk_create(const make_cfg_t *pcfg,
 
         if (have_S) //лļ
         {
-            fprintf(pfd, "%s/%%.o: ../%s/%%.S\n", tmp, tmp);
+            fprintf(pfd, "%s/%%.o: ../%s/%%.S%s\n", tmp, tmp, the_lto_dep ? " " LTO_STAMP : "");
             fprintf(pfd, "\t@echo 'Building file: $<'\n");
             fprintf(pfd, "\t@echo 'Invoking: Cross ARM GNU Assembler'\n");
-            fprintf(pfd, "\t%sgcc %s ", pcfg->CROSS_COMPILE, pcfg->CCFLAGS);
+            fprintf(pfd, "\t$(CC_WRAP) %sgcc %s ", pcfg->CROSS_COMPILE, cc_flags(pcfg));
             fprintf(pfd, "-x assembler-with-cpp -MMD -MP -MF\"$(@:%%.o=%%.d)\" -MT\"$(@)\" -c -o \"$@\" \"$<\"\n");
+            if (the_confh)
+            {
+                fprintf(pfd, FIXDEP_CMD);
+            }
             fprintf(pfd, "\t@echo 'Finished building: $<'\n");
             fprintf(pfd, "\t@echo ' '\n\n");
         }
 
-        fprintf(pfd, "%s/%%.o: ../%s/%%.c\n", tmp, tmp);
+        //-rspʱ仯(cc.rspݸı)Ҳ±
+        fprintf(pfd, "%s/%%.o: ../%s/%%.c%s%s\n", tmp, tmp, the_rsp ? " " CC_RSP : "",
+                the_lto_dep ? " " LTO_STAMP : "");
         fprintf(pfd, "\t@echo 'Building file: $<'\n");
         fprintf(pfd, "\t@echo 'Invoking: Cross ARM C Compiler'\n");
-        if (pcfg->OTHER_D[0])
+        if (the_rsp)
+        {
+            fprintf(pfd, "\t$(CC_WRAP) %sgcc @%s", pcfg->CROSS_COMPILE, CC_RSP);
+        }
+        else if (pcfg->OTHER_D[0] && !the_confh)
         {
-            fprintf(pfd, "\t%sgcc %s %s%s", pcfg->CROSS_COMPILE, pcfg->CCFLAGS, pcfg->OTHER_D, pcfg->I);
+            fprintf(pfd, "\t$(CC_WRAP) %sgcc %s %s%s", pcfg->CROSS_COMPILE, cc_flags(pcfg), pcfg->OTHER_D, pcfg->I);
         }
         else
         {
-            fprintf(pfd, "\t%sgcc %s%s", pcfg->CROSS_COMPILE, pcfg->CCFLAGS, pcfg->I);
+            fprintf(pfd, "\t$(CC_WRAP) %sgcc %s%s", pcfg->CROSS_COMPILE, cc_flags(pcfg), pcfg->I);
+        }
+        if (TRUE == is_path_need_trace(pcfg, path))
+        {
+            fprintf(pfd, " -finstrument-functions");
         }
         fprintf(pfd, " -std=gnu11 -MMD -MP -MF\"$(@:%%.o=%%.d)\" -MT\"$(@)\" -c -o \"$@\" \"$<\"\n");
+        if (the_confh)
+        {
+            fprintf(pfd, FIXDEP_CMD);
+        }
         fprintf(pfd, "\t@echo 'Finished building: $<'\n");
         fprintf(pfd, "\t@echo ' '\n\n\n");
 
-        fclose(pfd);
-
         ret = OK;
     } while (0);
 
+    if (pfd)
+    {
+        fclose(pfd);
+    }
+
     return ret;
 }
 
@@ -543,6 +1195,7 @@ sources_mk_init(const char *proot)
                      "S_UPPER_SRCS := \n"
                      "O_SRCS := \n"
                      "OBJS := \n"
+                     "SHARED_OBJS := \n"
                      "SECONDARY_FLASH := \n"
                      "SECONDARY_SIZE := \n"
                      "ASM_DEPS := \n"
@@ -616,7 +1269,7 @@ sources_mk_end(FILE *pfd)
  * @retval  OK    : ɹ
  * @retval  ERROR : ʧ
  *
- * @note    ҪLIBS := -lsxos -lmeter_sp5 -lm
+ * @note    ҪLIBS := -lsxos -lmeter_sp5 -lm, USER_OBJSΪõĿļ
  ******************************************************************************
  */
 status_t
@@ -637,7 +1290,7 @@ objects_mk_create(const make_cfg_t *pcfg,
         }
         fprintf(pfd, FILE_HEAD);
 
-        fprintf(pfd, "USER_OBJS :=\n\nLIBS := %s\n\n", pcfg->LIBS);
+        fprintf(pfd, "USER_OBJS := $(SHARED_OBJS)\n\nLIBS := %s\n\n", pcfg->LIBS);
         fclose(pfd);
         ret = OK;
     } while (0);
@@ -673,7 +1326,17 @@ makefile_init(const char *proot)
         fprintf(pfd, FILE_HEAD);
 
         fprintf(pfd, "-include ../makefile.init\n\n"
-                     "RM := cs-rm -rf\n\n"
+                     "RM := cs-rm -rf\n"
+                     "AUTOMAKE ?= AutoMake\n\n"
+                     "# AutoMake -buildʱ¼ÿĿıʱ\n"
+                     "ifeq ($(BUILD_STATS),1)\n"
+                     "CC_WRAP = $(AUTOMAKE) -cc $@ --\n"
+                     "endif\n\n"
+                     "# ˹б(AUTOMAKE_DIST=host[:port],...)Զ̻\n"
+                     "# (AUTOMAKE_CACHE=http://host[:port]/)ʱAutoMake\n"
+                     "ifneq ($(" DIST_ENV ")$(" RCACHE_ENV "),)\n"
+                     "CC_WRAP = $(AUTOMAKE) -cc $@ --\n"
+                     "endif\n\n"
                      "# All of the sources participating in the build are defined here\n"
                      "-include sources.mk\n");
     } while (0);
@@ -713,24 +1376,249 @@ makefile_add(FILE *pfd,
 
 /**
  ******************************************************************************
- * @brief   رmakefile
- * @param[in]  *pfd   : ļ
- * @param[in]  *pcfg  : 
+ * @brief   ¼Ŀ¼ĶĿ¼(-arʱÿĿ¼һ̬)
+ * @param[in]  *path : ԴĿ¼
  *
  * @retval  OK    : ɹ
- * @retval  ERROR : ʧ
+ * @retval  ERROR : ڴ治
+ *
+ * @note    ԴĿ¼еļκο, ΪĿļ
  ******************************************************************************
  */
-status_t
-makefile_end(FILE *pfd,
-        const make_cfg_t *pcfg)
+static status_t
+ar_top_add(const char *path)
 {
-    if (pfd)
+    int i;
+    char top[MAX_PATH];
+
+    if (strlen(path) <= 3)
     {
-        fprintf(pfd,
-                "-include subdir.mk\n"
-                "-include objects.mk\n\n"
-                "ifneq ($(MAKECMDGOALS),clean)\n"
+        return OK;
+    }
+    top[0] = ' ';
+    for (i = 0; (i < MAX_PATH - 3) && path[i + 3] && (path[i + 3] != '\\') && (path[i + 3] != '/'); i++)
+    {
+        top[i + 1] = path[i + 3];
+    }
+    top[i + 1] = ' ';
+    top[i + 2] = 0;
+    if (!the_ar_tops.len && (OK != str_add(&the_ar_tops, " ")))
+    {
+        return ERROR;
+    }
+    if (strstr(the_ar_tops.pbuf, top))
+    {
+        return OK;
+    }
+
+    return str_add(&the_ar_tops, top + 1);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ɸ̬ĳԱбlib<Ŀ¼>.lst, ݲʱд
+ * @param[in]  *proot : ʱ·
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note    ԱLIB_app_OBJSһ: üapp/µĿļ.
+ *          ɾԴļб仯, ֮´, ¾ɳԱ
+ ******************************************************************************
+ */
+static status_t
+ar_lst_create(const char *proot)
+{
+    int i;
+    int n;
+    char *p;
+    const char *q;
+    const char *r;
+    const char *pend;
+    const char *plist[2];
+    char tmp[MAX_PATH];
+    char tops[MAX_PATH * 4];
+    str_buf_t lst = {NULL, 0, 0};
+    status_t ret = OK;
+
+    //lenΪ0ʱpbufпһõ
+    plist[0] = the_objs.len ? the_objs.pbuf : NULL;
+    plist[1] = the_shared.len ? the_shared.pbuf : NULL;
+    strncpy(tops, the_ar_tops.pbuf ? the_ar_tops.pbuf : "", sizeof(tops) - 1);
+    tops[sizeof(tops) - 1] = 0;
+    for (p = strtok(tops, " "); p && (OK == ret); p = strtok(NULL, " "))
+    {
+        //ûгԱʱpbufҲΪNULL
+        lst.len = 0;
+        ret = str_add(&lst, "");
+        n = strlen(p);
+        for (i = 0; (i < 2) && (OK == ret); i++)
+        {
+            for (q = plist[i]; q && (pend = strchr(q, '\n')) && (OK == ret); q = pend + 1)
+            {
+                //"./app/x.o""../_BUILD_Debug/app/x.o", ȥĿ¼Ƚ϶Ŀ¼
+                r = q + 2;
+                if (!strncmp(q, "../", 3))
+                {
+                    r = strchr(q + 3, '/');
+                    r = (r && (r < pend)) ? r + 1 : pend;
+                }
+                if ((r + n < pend) && !strncmp(r, p, n) && (r[n] == '/'))
+                {
+                    snprintf(tmp, sizeof(tmp), "%.*s", (int)(pend - q + 1), q);
+                    ret = str_add(&lst, tmp);
+                }
+            }
+        }
+        if (OK == ret)
+        {
+            snprintf(tmp, sizeof(tmp), "%s/lib%s" AR_LIST, proot, p);
+            ret = os_fupdate(tmp, lst.pbuf, lst.len);
+        }
+    }
+    free(lst.pbuf);
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   AR_DIRS: üõĹõıĿ¼
+ * @param[in]  *pfd : makefileļ
+ *
+ * @return  None
+ *
+ * @note    $(filter $(addsuffix /app/%,$(AR_DIRS)),$(OBJS) $(USER_OBJS))Ϊ
+ *          app/µȫĿļ
+ ******************************************************************************
+ */
+static void
+ar_dirs_write(FILE *pfd)
+{
+    int j;
+
+    fprintf(pfd, "# Build directories of the objects\nAR_DIRS := .");
+    for (j = 0; j < the_share_num; j++)
+    {
+        if (the_share_used[j])
+        {
+            fprintf(pfd, " ../%s", path_name(the_share[j].BUILD_DIR));
+        }
+    }
+    fprintf(pfd, "\n\n");
+}
+
+/**
+ ******************************************************************************
+ * @brief   Ŀ¼ľ̬
+ * @param[in]  *pfd  : makefileļ
+ * @param[in]  *pcfg : 
+ *
+ * @return  None
+ *
+ * @note
+ *  1. LIB_app_OBJSΪapp/µĿļ(ar_dirs_write), б仯ʱ´;
+ *     ɾԴļʱĿļûб仯, ɳԱбlibapp.lst(ar_lst_create)
+ *  2. ɾٴ, ȥɾԴļĳԱ. thinֻ¼Ŀļ·,
+ *     ʱ; -ar fullʱɿɵ
+ *  3. LOOSE_OBJSΪκοĿļ(Ŀ¼, _trace, _hot)
+ ******************************************************************************
+ */
+static void
+ar_mk_write(FILE *pfd,
+        const make_cfg_t *pcfg)
+{
+    char *p;
+    char *delim = " ";
+    char tops[MAX_PATH * 4];
+
+    fprintf(pfd, "# Static archive per top-level directory\nLIB_ARCHIVES :=\nLIB_OBJS :=\n\n");
+
+    strncpy(tops, the_ar_tops.pbuf ? the_ar_tops.pbuf : "", sizeof(tops) - 1);
+    tops[sizeof(tops) - 1] = 0;
+    for (p = strtok(tops, delim); p; p = strtok(NULL, delim))
+    {
+        fprintf(pfd,
+                "LIB_%s_OBJS := $(filter $(addsuffix /%s/%%,$(AR_DIRS)),$(OBJS) $(USER_OBJS))\n"
+                "LIB_ARCHIVES += lib%s.a\n"
+                "LIB_OBJS += $(LIB_%s_OBJS)\n\n"
+                "lib%s.a: $(LIB_%s_OBJS) lib%s" AR_LIST "\n"
+                "\t@echo 'Archiving: $@'\n"
+                "\t-@$(RM) \"$@\"\n"
+                "\t%sar rcs%s \"$@\" $(LIB_%s_OBJS)\n"
+                "\t@echo ' '\n\n",
+                p, p, p, p, p, p, p, pcfg->CROSS_COMPILE, (the_ar == 1) ? "T" : "", p);
+    }
+    fprintf(pfd, "LOOSE_OBJS := $(filter-out $(LIB_OBJS),$(OBJS) $(USER_OBJS))\n\n");
+}
+
+/**
+ ******************************************************************************
+ * @brief   ѹ̼Ĺ: LZ_SECTIONSеĶobjcopyΪʱ.binѹ
+ * @param[in]  *pfd  : makefileļ
+ * @param[in]  *pcfg : 
+ *
+ * @return  None
+ ******************************************************************************
+ */
+static void
+lz_mk_write(FILE *pfd,
+        const make_cfg_t *pcfg)
+{
+    char *p;
+    char sections[MEMBER_SIZE(make_cfg_t, LZ_SECTIONS)];
+
+    fprintf(pfd,
+            "SECONDARY_FLASH += %s" LZIMG_SUFFIX "\n\n"
+            "%s" LZIMG_SUFFIX ": %s.elf\n"
+            "\t@echo 'Invoking: Compressed Flash Image'\n"
+            "\t%sobjcopy -O binary",
+            pcfg->APP, pcfg->APP, pcfg->APP, pcfg->CROSS_COMPILE);
+    strncpy(sections, pcfg->LZ_SECTIONS, sizeof(sections));
+    for (p = strtok(sections, "|"); p; p = strtok(NULL, "|"))
+    {
+        fprintf(pfd, " -j %s", p);
+    }
+    fprintf(pfd,
+            " \"%s.elf\" \"%s" LZIMG_SUFFIX ".bin\"\n"
+            "\t$(AUTOMAKE) -lz \"%s" LZIMG_SUFFIX ".bin\" \"$@\"\n"
+            "\t-@$(RM) \"%s" LZIMG_SUFFIX ".bin\"\n"
+            "\t@echo 'Finished building: $@'\n"
+            "\t@echo ' '\n\n",
+            pcfg->APP, pcfg->APP, pcfg->APP, pcfg->APP);
+}
+
+/**
+ ******************************************************************************
+ * @brief   رmakefile
+ * @param[in]  *pfd   : ļ
+ * @param[in]  *pcfg  : 
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+status_t
+makefile_end(FILE *pfd,
+        const make_cfg_t *pcfg)
+{
+    int i;
+    int j;
+    char lto[96];
+    char deps[128];
+    char objs[192];
+    char ref[MAX_PATH];
+    char ref_dep[MAX_PATH * 2];
+    char root[MAX_PATH];
+    const char *pdeps;
+    const char *pobjs;
+
+    if (pfd)
+    {
+        fprintf(pfd,
+                "-include subdir.mk\n"
+                "-include objects.mk\n\n"
+                "ifneq ($(MAKECMDGOALS),clean)\n"
                 "ifneq ($(strip $(ASM_DEPS)),)\n"
                 "-include $(ASM_DEPS)\n"
                 "endif\n"
@@ -752,17 +1640,72 @@ makefile_end(FILE *pfd,
                 pcfg->APP, pcfg->APP, pcfg->APP
                 );
 
+        //-ltoʱӷб, "+"ʹgccmakejobserver
+        lto[0] = 0;
+        if (the_lto)
+        {
+            snprintf(lto, sizeof(lto), " -flto=auto -flto-partition=balanced --param lto-partitions=%d",
+                    the_lto_part);
+        }
+
+        //-arʱӸ(--whole-archiveֱĿļͬ, ŵ
+        //ǺҲ©), ΪĿļ
+        if (the_ar || the_prebuilt)
+        {
+            ar_dirs_write(pfd);
+        }
+        if (the_prebuilt)
+        {
+            prebuilt_mk_write(pfd);
+        }
+        if (the_ar)
+        {
+            ar_mk_write(pfd, pcfg);
+            pdeps = "$(LIB_ARCHIVES) $(LOOSE_OBJS)";
+            pobjs = "-Wl,--whole-archive $(LIB_ARCHIVES) -Wl,--no-whole-archive $(LOOSE_OBJS)";
+        }
+        else
+        {
+            pdeps = the_rsp ? "$(OBJS) $(USER_OBJS) " OBJS_RSP : "$(OBJS) $(USER_OBJS)";
+            pobjs = the_rsp ? "@" OBJS_RSP : "$(OBJS) $(USER_OBJS)";
+        }
+
+        //ֿеԤͬ; ļ仯ʱprebuilt_xx.ok
+        if (the_prebuilt)
+        {
+            snprintf(deps, sizeof(deps), "%s $(PREBUILT_LIBS) $(PREBUILT_OK)", pdeps);
+            snprintf(objs, sizeof(objs), "%s -Wl,--whole-archive $(PREBUILT_LIBS) -Wl,--no-whole-archive", pobjs);
+            pdeps = deps;
+            pobjs = objs;
+        }
+
+        //-rspʱĿļбobjs.rsp, б仯(ɾļ)Ҳ
+        //-hotplaceʱhot.ldӽű.text֮ǰ, ѡȡҲ
         fprintf(pfd,
                 "# Tool invocations\n"
-                "%s.elf: $(OBJS) $(USER_OBJS)\n"
+                "%s.elf: %s%s%s\n"
                 "\t@echo 'Building target: $@'\n"
                 "\t@echo 'Invoking: Cross ARM C Linker'\n"
-                "\t%sgcc %s -T \"../%s\" -Xlinker --gc-sections%s "
-                "-Wl,-Map,\"%s.map\" %s -o \"%s.elf\" $(OBJS) $(USER_OBJS) $(LIBS)\n"
+                "\t%s$(CC_WRAP) %sgcc %s%s -T \"../%s\"%s -Xlinker --gc-sections%s "
+                "-Wl,-Map,\"%s.map\" %s -o \"%s.elf\" %s $(LIBS)\n"
                 "\t@echo 'Finished building target: $@'\n"
                 "\t@echo ' '\n\n",
-                pcfg->APP, pcfg->CROSS_COMPILE, pcfg->CCFLAGS, pcfg->LD,
-                pcfg->L, pcfg->APP, pcfg->LDFLAGS, pcfg->APP
+                pcfg->APP, pdeps,
+                the_lto_dep ? " " LTO_STAMP " " LTO_LINK_STAMP : "", the_hot ? " " HOTPLACE_LD : "",
+                the_lto ? "+" : "", pcfg->CROSS_COMPILE, pcfg->CCFLAGS, lto, pcfg->LD,
+                the_hot ? " -T \"" HOTPLACE_LD "\"" : "", pcfg->L, pcfg->APP,
+                pcfg->LDFLAGS, pcfg->APP, pobjs
+                );
+
+        //-deadsrc: ͬһ, гĶ
+        fprintf(pfd,
+                "%s: %s\n"
+                "\t%sgcc %s%s -T \"../%s\"%s -Xlinker --gc-sections -Xlinker --print-gc-sections%s "
+                "-Wl,-Map,\"%s\" %s -o \"%s\" %s $(LIBS) 2> \"%s\"\n\n",
+                DEADSRC_GC, pdeps,
+                pcfg->CROSS_COMPILE, pcfg->CCFLAGS, lto, pcfg->LD,
+                the_hot ? " -T \"" HOTPLACE_LD "\"" : "", pcfg->L, DEADSRC_MAP,
+                pcfg->LDFLAGS, DEADSRC_ELF, pobjs, DEADSRC_GC
                 );
 
         fprintf(pfd,
@@ -774,6 +1717,44 @@ makefile_end(FILE *pfd,
                 pcfg->APP, pcfg->APP, pcfg->CROSS_COMPILE, pcfg->APP, pcfg->APP
                 );
 
+        //DELTA_REF: ο̼µ.binɲ, .binһ
+        if (pcfg->DELTA_REF[0])
+        {
+            //·ԴĿ¼, makeڱĿ¼ִ; еĿոת
+            if ((pcfg->DELTA_REF[0] == '/') || (pcfg->DELTA_REF[0] == '\\') || (pcfg->DELTA_REF[1] == ':'))
+            {
+                snprintf(ref, sizeof(ref), "%s", pcfg->DELTA_REF);
+            }
+            else
+            {
+                snprintf(ref, sizeof(ref), "../%s", pcfg->DELTA_REF);
+            }
+            for (i = 0, j = 0; ref[i] && (j < (int)sizeof(ref_dep) - 2); i++)
+            {
+                if (ref[i] == ' ')
+                {
+                    ref_dep[j++] = '\\';
+                }
+                ref_dep[j++] = ref[i];
+            }
+            ref_dep[j] = 0;
+            fprintf(pfd,
+                    "SECONDARY_FLASH += %s" DELTA_SUFFIX "\n\n"
+                    "%s" DELTA_SUFFIX ": %s.bin %s\n"
+                    "\t@echo 'Invoking: Firmware Delta'\n"
+                    "\t$(AUTOMAKE) -delta \"%s\" \"%s.bin\" \"$@\"\n"
+                    "\t@echo 'Finished building: $@'\n"
+                    "\t@echo ' '\n\n",
+                    pcfg->APP, pcfg->APP, pcfg->APP, ref_dep, ref, pcfg->APP
+                    );
+        }
+
+        //LZ_SECTIONS: ѡеobjcopyһ, ֿѹ(߳)
+        if (pcfg->LZ_SECTIONS[0])
+        {
+            lz_mk_write(pfd, pcfg);
+        }
+
         fprintf(pfd,
                 "%s.siz: %s.elf\n"
                 "\t@echo 'Invoking: Cross ARM GNU Print Size'\n"
@@ -783,16 +1764,22 @@ makefile_end(FILE *pfd,
                 pcfg->APP, pcfg->APP, pcfg->CROSS_COMPILE, pcfg->APP
                 );
 
+        //-benchԴĿ¼ִ(ȡ), Ŀ¼ֹܲһ
+        path_root(pcfg->BUILD_DIR, root, sizeof(root));
         fprintf(pfd,
                 "# Other Targets\n"
                 "clean:\n"
-                "\t-$(RM) $(OBJS)$(SECONDARY_FLASH)$(SECONDARY_SIZE)$(ASM_DEPS)$(S_UPPER_DEPS)$(C_DEPS) %s.elf\n"
+                "\t-$(RM) $(OBJS)$(SECONDARY_FLASH)$(SECONDARY_SIZE)$(ASM_DEPS)$(S_UPPER_DEPS)$(C_DEPS)$(LIB_ARCHIVES) %s.elf\n"
                 "\t-@echo ' '\n\n"
-                "secondary-outputs: $(SECONDARY_FLASH) $(SECONDARY_SIZE)\n\n"
-                ".PHONY: all clean dependents\n"
+                "bench: %s.elf\n"
+                "\t@echo 'Invoking: Instruction Set Simulator Benchmark'\n"
+                "\tcd \"%s\" && $(AUTOMAKE) -bench\n"
+                "\t@echo ' '\n\n"
+                "secondary-outputs: $(SECONDARY_FLASH) $(SECONDARY_SIZE)%s\n\n"
+                ".PHONY: all clean dependents bench\n"
                 ".SECONDARY:\n\n"
                 "-include ../makefile.targets",
-                pcfg->APP
+                pcfg->APP, pcfg->APP, root, the_prebuilt ? " $(PREBUILT_PUB)" : ""
                 );
         fclose(pfd);
     }
@@ -868,146 +1855,395 @@ build_bat_create(const make_cfg_t *pcfg,
 
 /**
  ******************************************************************************
- * @brief   ݹԴ·, subdir.mk ͬʱmakefilesources.mk
- * @param[in]  *pcfg        : 
- * @param[in]  *dir         : Դ·
- * @param[in]  *proot       : ʱ·
- * @param[in]  *pmakefile   : makefileļ
- * @param[in]  *psources_mk : sources_mkļ
+ * @brief   Զ(ٴRAMƴ)subdir.mk, makefile
+ * @param[in]  *pcfg      : 
+ * @param[in]  *proot     : ʱ·
+ * @param[in]  *pmakefile : makefileļ
+ * @param[in]  *pdir      : ڱĿ¼еλ
+ * @param[in]  *pname     : Դļ(.c)
+ * @param[in]  pcreate    : Դļĺ
  *
  * @retval  OK    : ɹ
  * @retval  ERROR : ʧ
+ *
+ * @note    Զ뱾-finstrument-functions
  ******************************************************************************
  */
-status_t
-traverse_src(const make_cfg_t *pcfg,
-        const char *dir,
+static status_t
+gen_mk_create(const make_cfg_t *pcfg,
         const char *proot,
         FILE *pmakefile,
-        FILE *psources_mk)
+        const char *pdir,
+        const char *pname,
+        status_t (*pcreate)(const char *))
 {
-    if (TRUE != is_path_need_compile(pcfg, dir))
+    FILE *pfd = NULL;
+    char tmp[MAX_PATH];
+    status_t ret = ERROR;
+
+    do
     {
-        return OK; //Ҫ
-    }
+        snprintf(tmp, sizeof(tmp), "%s/%s", proot, pdir);
+        if (OK != dir_create(tmp))
+        {
+            break;
+        }
 
-    status_t ret = ERROR;
+        snprintf(tmp, sizeof(tmp), "%s/%s/%s.c", proot, pdir, pname);
+        if (OK != pcreate(tmp))
+        {
+            break;
+        }
+
+        snprintf(tmp, sizeof(tmp), "%s/%s/subdir.mk", proot, pdir);
+        pfd = fopen(tmp, "w+");
+        if (!pfd)
+        {
+            break;
+        }
+        fprintf(pfd, FILE_HEAD);
+        fprintf(pfd, "OBJS += \\\n./%s/%s.o \n\n", pdir, pname);
+        snprintf(tmp, sizeof(tmp), "./%s/%s.o\n", pdir, pname);
+        if (the_rsp && (OK != str_add(&the_objs, tmp)))
+        {
+            fclose(pfd);
+            break;
+        }
+        fprintf(pfd, "C_DEPS += \\\n./%s/%s.d \n\n\n", pdir, pname);
+        fprintf(pfd, "%s/%%.o: ./%s/%%.c%s\n", pdir, pdir, the_lto_dep ? " " LTO_STAMP : "");
+        fprintf(pfd, "\t@echo 'Building file: $<'\n");
+        fprintf(pfd, "\t@echo 'Invoking: Cross ARM C Compiler'\n");
+        fprintf(pfd, "\t$(CC_WRAP) %sgcc %s -std=gnu11 -MMD -MP -MF\"$(@:%%.o=%%.d)\" -MT\"$(@)\" -c -o \"$@\" \"$<\"\n",
+                pcfg->CROSS_COMPILE, cc_flags(pcfg));
+        if (the_confh)
+        {
+            fprintf(pfd, FIXDEP_CMD);
+        }
+        fprintf(pfd, "\t@echo 'Finished building: $<'\n");
+        fprintf(pfd, "\t@echo ' '\n\n\n");
+        fclose(pfd);
+
+        fprintf(pmakefile, "-include %s/subdir.mk\n", pdir);
+        ret = OK;
+    } while (0);
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ݹԴ·, ¼Ŀ¼µc/Sļ
+ * @param[in]  *pcfgs : (ùһα)
+ * @param[in]  num    : 
+ * @param[in]  *dir   : Դ·
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note    Ŀ¼ڱĿ¼¼, ɵmakefileе˳һ
+ ******************************************************************************
+ */
+static status_t
+src_scan(const make_cfg_t *pcfgs,
+        int num,
+        const char *dir)
+{
+    int i;
+    int len;
+    int max = 0;
+    void *p;
+    src_dir_t sd;
+    status_t ret = OK;
     char szFind[MAX_PATH], szFile[MAX_PATH];
     WIN32_FIND_DATA FindFileData;
-    strcpy(szFind, dir);
-    strcat(szFind, "\\*.*");
-    HANDLE hFind = FindFirstFile(szFind, &FindFileData);
+    HANDLE hFind;
+
+    //öĿ¼ٱ
+    for (i = 0; (i < num) && (TRUE != is_path_need_compile(&pcfgs[i], dir, FALSE)); i++)
+    {
+    }
+    if (i == num)
+    {
+        return OK;
+    }
+
+    stamp_dir_add(dir);
+    snprintf(szFind, sizeof(szFind), "%s\\*.*", dir);
+    hFind = FindFirstFile(szFind, &FindFileData);
     if (INVALID_HANDLE_VALUE == hFind)
     {
         return ERROR;
     }
 
-    int file_cnt = 0; //Ŀ¼cļ
-    char file_name[MAX_C_FILES][MAX_PATH]; //todo: Ǹmalloc
-
-    memset(file_name, 0x00, sizeof(file_name));
+    memset(&sd, 0x00, sizeof(sd));
+    strncpy(sd.path, dir, sizeof(sd.path) - 1);
 
     while (TRUE)
     {
-        if (FindFileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+        if (FindFileData.cFileName[0] != '.')
         {
-            if (FindFileData.cFileName[0] != '.') //ҲΪproot
+            snprintf(szFile, sizeof(szFile), "%s\\%s", dir, FindFileData.cFileName);
+            if (FindFileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
             {
-                strcpy(szFile, dir);
-                strcat(szFile, "\\");
-                strcat(szFile, FindFileData.cFileName);
-                if (strcmp(szFile + 3, pcfg->BUILD_DIR + 2)) //fixme: պ
+                //Ŀ¼_traceȱ
+                if ((strcmp(dir, make_cfg.SRC_DIR)
+                            || (E_TRUE != is_build_dir(szFile, FindFileData.cFileName)))
+                        && (OK != src_scan(pcfgs, num, szFile)))
                 {
-                    if (OK != traverse_src(pcfg, szFile, proot, pmakefile, psources_mk))
-                    {
-                        return ERROR;
-                    }
+                    ret = ERROR;
+                    break;
                 }
             }
-        }
-        else
-        {
-            if (FindFileData.cFileName[0] != '.')
+            else
             {
                 //ֻc/Sļ
-                int len = strlen(FindFileData.cFileName);
-                if ((FindFileData.cFileName[len - 2] == '.')
+                len = strlen(FindFileData.cFileName);
+                if ((len > 2) && (FindFileData.cFileName[len - 2] == '.')
                         && ((FindFileData.cFileName[len - 1] == 'c')
                                 || (FindFileData.cFileName[len - 1] == 'S')))
                 {
-                    strcpy(szFile, dir);
-                    strcat(szFile, "\\");
-                    strcat(szFile, FindFileData.cFileName);
-                    if (TRUE == is_path_need_compile(pcfg, szFile))
+                    if (sd.file_num >= max)
                     {
-                        strncpy(file_name[file_cnt], szFile, MAX_PATH);
-                        file_cnt++;
+                        max = max ? (max * 2) : 16;
+                        p = realloc(sd.pfile, max * sizeof(*sd.pfile));
+                        if (!p)
+                        {
+                            ret = ERROR;
+                            break;
+                        }
+                        sd.pfile = p;
                     }
+                    strcpy(sd.pfile[sd.file_num++], szFile);
                 }
             }
         }
         if (!FindNextFile(hFind, &FindFileData))
             break;
     }
+    FindClose(hFind);
 
-    do
+    if ((OK == ret) && (sd.file_num > 0))
     {
-        if (file_cnt <= 0)
-        {
-            ret = OK;
-            break;
-        }
-        //subdir.mk
-        if (OK != subdir_mk_create(pcfg, dir, proot, file_name, file_cnt))
-        {
-            break;
-        }
-        //sources.mk
-        if (OK != sources_mk_add(psources_mk, dir))
-        {
-            break;
-        }
-        //makefile
-        if (OK != makefile_add(pmakefile, dir))
+        if (the_src_num >= the_src_max)
         {
-            break;
+            the_src_max = the_src_max ? (the_src_max * 2) : 64;
+            p = realloc(the_src, the_src_max * sizeof(*the_src));
+            if (!p)
+            {
+                free(sd.pfile);
+                return ERROR;
+            }
+            the_src = p;
         }
-        ret = OK;
-    } while (0);
+        the_src[the_src_num++] = sd;
+        return OK;
+    }
+    free(sd.pfile);
 
     return ret;
 }
 
 /**
  ******************************************************************************
- * @brief   AutoMake
- * @param[in]  *pcfg  : 
- * @param[in]  *psrc  : Դ·
- * @param[in]  *proot : ʱ·
+ * @brief   ҿɹĿļ
+ * @param[in]  *pcfg : 
+ * @param[in]  *psd  : ԴĿ¼
  *
- * @retval  OK    : ɹ
- * @retval  ERROR : ʧ
+ * @retval  -1  : û(Լ)
+ * @retval >=0  : the_shareе
+ *
+ * @note    ļͬұȫһʱŹ
  ******************************************************************************
  */
-status_t
-auto_make_bulid(const make_cfg_t *pcfg,
-        const char *psrc,
-        const char *proot)
+static int
+src_share_find(const make_cfg_t *pcfg,
+        const src_dir_t *psd)
 {
-    status_t ret = ERROR;
-    FILE *pmakefile = NULL;
-    FILE *psources_mk = NULL;
+    int i;
+    int j;
+    const make_cfg_t *po;
 
-    do
+    for (i = 0; i < the_share_num; i++)
     {
-        //1. ɾʱ·(ͨж)
-        if (OK != dir_delete(proot))
+        po = &the_share[i];
+        if (strcmp(po->CROSS_COMPILE, pcfg->CROSS_COMPILE)
+                || strcmp(po->CCFLAGS, pcfg->CCFLAGS)
+                || strcmp(po->OTHER_D, pcfg->OTHER_D)
+                || strcmp(po->I, pcfg->I)
+                || (is_path_need_trace(po, psd->path) != is_path_need_trace(pcfg, psd->path))
+                || (TRUE != is_dir_need_compile(po, psd->path, FALSE)))
         {
-            break;
+            continue;
         }
-
-        //2. ʱ·
-        if (OK != dir_create(proot))
+        for (j = 0; (j < psd->file_num)
+                && (is_path_need_compile(po, psd->pfile[j], FALSE)
+                        == is_path_need_compile(pcfg, psd->pfile[j], FALSE)); j++)
+        {
+        }
+        if (j == psd->file_num)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ɱsubdir.mk ͬʱmakefilesources.mk
+ * @param[in]  *pcfg        : 
+ * @param[in]  *proot       : ʱ·
+ * @param[in]  *pmakefile   : makefileļ
+ * @param[in]  *psources_mk : sources_mkļ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+static status_t
+src_generate(const make_cfg_t *pcfg,
+        const char *proot,
+        FILE *pmakefile,
+        FILE *psources_mk)
+{
+    int i;
+    int j;
+    int cnt;
+    int max = 1;
+    const char *pshare;
+    const char **pfiles;
+    const src_dir_t *psd;
+    char share[MAX_PATH];
+    status_t ret = OK;
+
+    for (i = 0; i < the_src_num; i++)
+    {
+        max = MAX(max, the_src[i].file_num);
+    }
+    pfiles = malloc(max * sizeof(*pfiles));
+    if (!pfiles)
+    {
+        return ERROR;
+    }
+
+    //0. PREBUILT_DIRSеĿ¼ԴļݼڲֿвԤ
+    //   (ٰ汾Ŀ¼ͬ, ʹ)
+    prebuilt_init(pcfg, the_top);
+    the_prebuilt = (pcfg->PREBUILT_DIRS[0] && !pcfg->TRACE) ? TRUE : FALSE;
+    for (i = 0; the_prebuilt && (OK == ret) && (i < the_src_num); i++)
+    {
+        psd = &the_src[i];
+        if (TRUE != is_dir_need_compile(pcfg, psd->path, FALSE))
+        {
+            continue;
+        }
+        for (j = 0; (OK == ret) && (j < psd->file_num); j++)
+        {
+            if (TRUE == is_path_need_compile(pcfg, psd->pfile[j], FALSE))
+            {
+                ret = prebuilt_add(psd->pfile[j]);
+            }
+        }
+    }
+    if (the_prebuilt && (OK == ret))
+    {
+        prebuilt_lookup(pcfg, cc_flags(pcfg));
+    }
+
+    for (i = 0; (OK == ret) && (i < the_src_num); i++)
+    {
+        psd = &the_src[i];
+        if (TRUE != is_dir_need_compile(pcfg, psd->path, TRUE))
+        {
+            continue; //Ҫ
+        }
+        if (the_prebuilt && prebuilt_hit(psd->path))
+        {
+            continue; //ӲֿеԤ
+        }
+
+        for (cnt = 0, j = 0; j < psd->file_num; j++)
+        {
+            if (TRUE != is_path_need_compile(pcfg, psd->pfile[j], TRUE))
+            {
+                continue;
+            }
+            if (the_hdrcost && (OK != hdrcost_add(psd->pfile[j])))
+            {
+                ret = ERROR;
+                break;
+            }
+            if (the_incpath && (OK != incpath_add(psd->pfile[j])))
+            {
+                ret = ERROR;
+                break;
+            }
+            pfiles[cnt++] = psd->pfile[j];
+        }
+        if ((OK != ret) || (cnt <= 0))
+        {
+            continue;
+        }
+
+        pshare = NULL;
+        j = src_share_find(pcfg, psd);
+        if (j >= 0)
+        {
+            the_share_used[j] = TRUE;
+            snprintf(share, sizeof(share), "../%s", path_name(the_share[j].BUILD_DIR));
+            pshare = share;
+        }
+        else if (pcfg != &trace_cfg) //_trace汾all, 
+        {
+            the_obj_cnt += cnt;
+        }
+
+        //subdir.mk, sources.mk, makefile
+        if ((OK != subdir_mk_create(pcfg, psd->path, proot, pfiles, cnt, pshare))
+                || (the_ar && (OK != ar_top_add(psd->path)))
+                || (OK != sources_mk_add(psources_mk, psd->path))
+                || (OK != makefile_add(pmakefile, psd->path)))
+        {
+            ret = ERROR;
+        }
+    }
+    free(pfiles);
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   AutoMake
+ * @param[in]  *pcfg  : 
+ * @param[in]  *psrc  : Դ·
+ * @param[in]  *proot : ʱ·
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+status_t
+auto_make_bulid(const make_cfg_t *pcfg,
+        const char *psrc,
+        const char *proot)
+{
+    status_t ret = ERROR;
+    FILE *pmakefile = NULL;
+    FILE *psources_mk = NULL;
+    char tmp[MAX_PATH];
+    struct _stat buf;
+
+    do
+    {
+        //1. ɾʱ·(ͨж)
+        if (OK != dir_delete(proot))
+        {
+            break;
+        }
+
+        //2. ʱ·
+        if (OK != dir_create(proot))
         {
             break;
         }
@@ -1018,6 +2254,31 @@ auto_make_bulid(const make_cfg_t *pcfg,
             break;
         }
 
+        //3.1 -Dдͷļ(cc.rsp, в-D)
+        if (the_confh && (OK != confh_create(pcfg, proot)))
+        {
+            break;
+        }
+
+        //3.2 LTOļ(ɹ)
+        if (OK != lto_stamp_create(proot))
+        {
+            break;
+        }
+
+        //3.2.1 -hotplaceɹhot.ldʱƴ(÷ֱж)
+        snprintf(tmp, sizeof(tmp), "%s/%s", proot, HOTPLACE_LD);
+        the_hot = _stat(tmp, &buf) ? FALSE : TRUE;
+
+        //3.3 дcc.rsp
+        the_objs.len = 0;
+        the_shared.len = 0;
+        the_ar_tops.len = 0;
+        if (the_rsp && (OK != rsp_cc_create(pcfg, proot)))
+        {
+            break;
+        }
+
         //4. ʼmakefileļ
         pmakefile = makefile_init(proot);
         if (!pmakefile)
@@ -1032,23 +2293,54 @@ auto_make_bulid(const make_cfg_t *pcfg,
             break;
         }
 
-        //6. ݹԴĿ¼, subdir.mk ͬʱmakefilesources.mk
-        if (OK != traverse_src(pcfg, psrc, proot, pmakefile, psources_mk))
+        //6. ݹԴĿ¼(ʱѹͬ), subdir.mk ͬʱmakefilesources.mk
+        if ((0 == the_src_num) && (OK != src_scan(pcfg, 1, psrc)))
+        {
+            break;
+        }
+        if (OK != src_generate(pcfg, proot, pmakefile, psources_mk))
+        {
+            break;
+        }
+
+        //6.1 ٰ汾ٴ
+        if (pcfg->TRACE && (OK != gen_mk_create(pcfg, proot, pmakefile, TRACE_DIR, "trace", trace_src_create)))
+        {
+            break;
+        }
+
+        //6.1.1 hot.ldʱRAMƴ
+        if (the_hot && (OK != gen_mk_create(pcfg, proot, pmakefile, HOTPLACE_DIR, "ramfunc",
+                hotplace_src_create)))
         {
             break;
         }
 
-        //7. βsources.mk
+        //6.2 -arʱ̬ĳԱб(objs.rsp, лᲢ빲õĿļ)
+        if (the_ar && (OK != ar_lst_create(proot)))
+        {
+            break;
+        }
+
+        //6.3 Ŀļбдobjs.rsp(õǰ, $(OBJS) $(USER_OBJS)˳һ)
+        if (the_rsp && (OK != rsp_objs_create(proot)))
+        {
+            break;
+        }
+
+        //7. βsources.mk(ͬʱرļ)
         if (OK != sources_mk_end(psources_mk))
         {
             break;
         }
+        psources_mk = NULL;
 
-        //8. βmakefile
+        //8. βmakefile(ͬʱرļ)
         if (OK != makefile_end(pmakefile, pcfg))
         {
             break;
         }
+        pmakefile = NULL;
 
         //9. build.batļ
         if (OK != build_bat_create(pcfg, proot))
@@ -1071,6 +2363,354 @@ auto_make_bulid(const make_cfg_t *pcfg,
     return ret;
 }
 
+/**
+ ******************************************************************************
+ * @brief   ִmake벢ʱʷݿ
+ * @param[in]  *pcfg     : 
+ * @param[in]  jobs      : 
+ * @param[in]  obj_total : Դļ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+static status_t
+make_run(const make_cfg_t *pcfg,
+        int jobs,
+        int obj_total)
+{
+    int i;
+    int status;
+    int argc = 7;
+    uint32 ms;
+    char self[MAX_PATH];
+    char times[MAX_PATH];
+    char jobs_opt[16];
+    char automake[MAX_PATH + 16];
+    char dist[1024];
+    char cache[1024];
+    char *argv[11];
+
+    //װҪҵ
+    if (!GetModuleFileName(NULL, self, sizeof(self)))
+    {
+        strncpy(self, SOFTNAME, sizeof(self));
+    }
+    snprintf(automake, sizeof(automake), "AUTOMAKE=\"%s\"", self); //·ппո
+    snprintf(jobs_opt, sizeof(jobs_opt), "-j%d", jobs);
+    snprintf(times, sizeof(times), "%s/.build_times", pcfg->BUILD_DIR);
+    remove(times);
+    snprintf(times, sizeof(times), "%s/%s", pcfg->BUILD_DIR, DIST_REFUSED);
+    remove(times);
+    for (i = 0; i < the_config_num; i++)
+    {
+        snprintf(times, sizeof(times), "%s/.build_times", the_configs[i].BUILD_DIR);
+        remove(times);
+        snprintf(times, sizeof(times), "%s/%s", the_configs[i].BUILD_DIR, DIST_REFUSED);
+        remove(times);
+    }
+
+    argv[0] = (char *)pcfg->MAKE;
+    argv[1] = "-C";
+    argv[2] = (char *)pcfg->BUILD_DIR;
+    argv[3] = "all";
+    argv[4] = jobs_opt;
+    argv[5] = "BUILD_STATS=1";
+    argv[6] = automake;
+    if (the_dist)
+    {
+        snprintf(dist, sizeof(dist), DIST_ENV "=%s", the_dist);
+        argv[argc++] = dist;
+    }
+    if (the_cache)
+    {
+        snprintf(cache, sizeof(cache), RCACHE_ENV "=%s", the_cache);
+        argv[argc++] = cache;
+        argv[argc++] = (E_TRUE == the_cache_rw) ? RCACHE_RW_ENV "=1" : RCACHE_RW_ENV "=0";
+    }
+    argv[argc] = NULL;
+
+    printf("ʼ(%s)...\n", jobs_opt);
+    ms = os_ms();
+    status = os_run(argv, NULL, NULL);
+    ms = os_ms() - ms;
+    printf("%s, ʱ%.2fs\n", status ? "ʧ" : "", ms / 1000.0);
+
+    //-configsʱܸĿ¼еĺʱ
+    if (OK != builddb_record(pcfg, the_config_num ? the_configs : pcfg, the_config_num ? the_config_num : 1,
+            jobs, ms, obj_total, status, the_lto))
+    {
+        printf("޷д¼!\n");
+    }
+
+    return status ? ERROR : OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   .cprojectеһ(iniеһ汾)õ
+ * @param[in]  *pbase : (ini)
+ * @param[in]  *pcp   : .cprojectûini汾
+ * @param[out] *pcfg  : õı, Ŀ¼ΪBUILD_DIR_
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ڴ治
+ *
+ * @note    ·, ׼Բini, /Ӳȡ.cproject
+ *          (-matrixʱȡiniиð汾һ)
+ ******************************************************************************
+ */
+static status_t
+configs_cfg_get(const make_cfg_t *pbase,
+        const pcfg_t *pcp,
+        make_cfg_t *pcfg)
+{
+    int i;
+    char c;
+
+    memcpy(pcfg, pbase, sizeof(*pcfg));
+    strncpy(pcfg->NAME, pcp->NAME, sizeof(pcfg->NAME) - 1);
+    for (i = 0; pcfg->NAME[i]; i++)
+    {
+        //Ŀ¼makeĿ
+        c = pcfg->NAME[i] | 0x20;
+        if (!isdigit(pcfg->NAME[i]) && !islower(c) && (pcfg->NAME[i] != '-'))
+        {
+            pcfg->NAME[i] = '_';
+        }
+    }
+    snprintf(pcfg->BUILD_DIR, sizeof(pcfg->BUILD_DIR), "%s_%s", pbase->BUILD_DIR, pcfg->NAME);
+
+    if ((OK != path_ex("-I", pcp->I, &pcfg->I))
+            || (OK != path_ex("-L", pcp->L, &pcfg->L)))
+    {
+        return ERROR;
+    }
+    strncpy(pcfg->CCFLAGS, pcp->CCFLAGS, sizeof(pcfg->CCFLAGS));
+    strncpy(pcfg->LIBS, pcp->LIBS, sizeof(pcfg->LIBS));
+    strncpy(pcfg->LD, pcp->LD, sizeof(pcfg->LD));
+    strncpy(pcfg->LDFLAGS, pcp->LDFLAGS, sizeof(pcfg->LDFLAGS));
+    strncpy(pcfg->EXCLUDE, pcp->EXCLUDE, sizeof(pcfg->EXCLUDE));
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȫõmakefile
+ * @param[in]  *pbase : 
+ * @param[in]  *pcfgs : õı
+ * @param[in]  num    : 
+ * @param[in]  deps   : deps[k][j]ΪTRUEʾkjĿļ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note    ûйùϵmake -jб
+ ******************************************************************************
+ */
+static status_t
+configs_mk_create(const make_cfg_t *pbase,
+        const make_cfg_t *pcfgs,
+        int num,
+        bool_e deps[MAX_CONFIGS][MAX_CONFIGS])
+{
+    int j;
+    int k;
+    FILE *pfd = NULL;
+    char root[MAX_PATH];
+    char tmp[MAX_PATH];
+    status_t ret = ERROR;
+
+    do
+    {
+        snprintf(root, sizeof(root), "%s%s", pbase->BUILD_DIR, CONFIGS_SUFFIX);
+        if (OK != dir_create(root))
+        {
+            break;
+        }
+        snprintf(tmp, sizeof(tmp), "%s/makefile", root);
+        pfd = fopen(tmp, "w+");
+        if (!pfd)
+        {
+            break;
+        }
+        fprintf(pfd, FILE_HEAD);
+
+        fprintf(pfd, "# All Target\nall:");
+        for (k = 0; k < num; k++)
+        {
+            fprintf(pfd, " %s", pcfgs[k].NAME);
+        }
+        fprintf(pfd, "\n\n");
+
+        //ĿļҪȱõñ
+        for (k = 0; k < num; k++)
+        {
+            fprintf(pfd, "%s:", pcfgs[k].NAME);
+            for (j = 0; j < num; j++)
+            {
+                if (deps[k][j])
+                {
+                    fprintf(pfd, " %s", pcfgs[j].NAME);
+                }
+            }
+            fprintf(pfd, "\n\t$(MAKE) -C ../%s all\n\n", path_name(pcfgs[k].BUILD_DIR));
+        }
+
+        fprintf(pfd, "# Other Targets\nclean:\n");
+        for (k = 0; k < num; k++)
+        {
+            fprintf(pfd, "\t-$(MAKE) -C ../%s clean\n", path_name(pcfgs[k].BUILD_DIR));
+        }
+        fprintf(pfd, "\n.PHONY: all clean");
+        for (k = 0; k < num; k++)
+        {
+            fprintf(pfd, " %s", pcfgs[k].NAME);
+        }
+        fprintf(pfd, "\n");
+        fclose(pfd);
+
+        ret = build_bat_create(pbase, root);
+    } while (0);
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȡ.cprojectеȫ(-matrixʱΪiniеȫ汾)ı
+ * @param[in]  *pbase : (ini)
+ *
+ * @retval  OK    : ɹ, the_configs
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+static status_t
+configs_get(const make_cfg_t *pbase)
+{
+    int k;
+    int num;
+    static pcfg_t cps[MAX_CONFIGS];
+
+    the_config_num = 0;
+    num = the_matrix ? ini_get_variants(cps, MAX_CONFIGS) : cproject_cfg_get_all(cps, MAX_CONFIGS);
+    if (num <= 0)
+    {
+        printf(the_matrix ? "ûҵiniеVARIANTS!\n" : "ûҵ.cprojectе!\n");
+        return ERROR;
+    }
+    for (k = 0; k < num; k++)
+    {
+        if (OK != configs_cfg_get(pbase, &cps[k], &the_configs[k]))
+        {
+            return ERROR;
+        }
+    }
+    the_config_num = num;
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   Ϊ.cprojectеȫ(-matrixʱΪiniеȫ汾)makefile
+ * @param[in]  *pbase : (ini)
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note
+ *  1. ԴĿ¼ֻһ, ֻǱͬ
+ *  2. ĳĿ¼ǰȫһʱ, ֱӹĿļ
+ ******************************************************************************
+ */
+static status_t
+configs_make(const make_cfg_t *pbase)
+{
+    int k;
+    int num;
+    static bool_e deps[MAX_CONFIGS][MAX_CONFIGS];
+
+    if (OK != configs_get(pbase))
+    {
+        return ERROR;
+    }
+    num = the_config_num;
+
+    if (OK != src_scan(the_configs, num, pbase->SRC_DIR))
+    {
+        return ERROR;
+    }
+
+    for (k = 0; k < num; k++)
+    {
+        printf("%s: %s\n", the_configs[k].NAME, the_configs[k].BUILD_DIR);
+        the_share = the_configs;
+        the_share_num = k;
+        memset(the_share_used, 0x00, sizeof(the_share_used));
+        if (OK != auto_make_bulid(&the_configs[k], the_configs[k].SRC_DIR, the_configs[k].BUILD_DIR))
+        {
+            return ERROR;
+        }
+        memcpy(deps[k], the_share_used, sizeof(deps[k]));
+    }
+    the_share_num = 0;
+
+    return configs_mk_create(pbase, the_configs, num, deps);
+}
+
+/**
+ ******************************************************************************
+ * @brief   makefile(üٰ汾)
+ * @param[in]  configs : ǷΪ.cprojectеȫ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+static status_t
+makefile_generate(bool_e configs)
+{
+    //Ԥʱɾָ
+    if (configs)
+    {
+        snprintf(the_top, sizeof(the_top), "../%s%s", path_name(make_cfg.BUILD_DIR), CONFIGS_SUFFIX);
+    }
+    else
+    {
+        strcpy(the_top, ".");
+    }
+
+    if (configs)
+    {
+        //.cprojectеȫ(Debug/Release...)iniеȫ汾, make -C BUILD_DIR_configs
+        if (OK != configs_make(&make_cfg))
+        {
+            printf("ɶmakefileʧܣ\n");
+            return ERROR;
+        }
+    }
+    else if (OK != auto_make_bulid(&make_cfg, make_cfg.SRC_DIR, make_cfg.BUILD_DIR))
+    {
+        printf("makefileʧܣ\n");
+        return ERROR;
+    }
+
+    //ɺٰ汾(make -C BUILD_DIR_trace)
+    if (make_cfg.TRACE_DIRS[0])
+    {
+        trace_cfg_get(&make_cfg, &trace_cfg);
+        if (OK != auto_make_bulid(&trace_cfg, trace_cfg.SRC_DIR, trace_cfg.BUILD_DIR))
+        {
+            printf("ɸٰ汾makefileʧܣ\n");
+            return ERROR;
+        }
+    }
+
+    return OK;
+}
+
 /**
  ******************************************************************************
  * @brief   Զ
@@ -1084,17 +2724,238 @@ auto_make_bulid(const make_cfg_t *pcfg,
 int main(int argc,
         char **argv)
 {
+    int i;
     int ret = EXIT_FAILURE;
     time_t start;
+    run_mode_e mode = MODE_MAKE;
+    const char *pdump = NULL;
+    const char *pprof = NULL;
+    char *pend;
+    uint32 budget = 0;
+    struct _stat buf;
+    int jobs = 0;
+    int last = 20;
+    uint32 ms;
+    bool_e configs = FALSE;
+    uint64 key;
+    char args[128];
+    static make_cfg_t top_cfg;
+
+    //װ(makefile): AutoMake -cc <Ŀ> -- <...>
+    if ((argc > 4) && !strcmp(argv[1], "-cc") && !strcmp(argv[3], "--"))
+    {
+        return builddb_cc(argv[2], argv + 4);
+    }
+
+    //дļ(makefile): AutoMake -fixdep <xx.d>, ָưд¼¼
+    if ((argc == 3) && !strcmp(argv[1], "-fixdep"))
+    {
+        if (confh_fixdep(argv[2]))
+        {
+            return 1;
+        }
+        (void)explain_refresh(argv[2]);
+        return 0;
+    }
+
+    //Ԥ(makefile): AutoMake -publish <ֿеλ> <> <.d...>
+    if ((argc > 3) && !strcmp(argv[1], "-publish"))
+    {
+        return prebuilt_publish(argc - 2, argv + 2);
+    }
+
+    //Ԥ(makefile): AutoMake -prebuilt <ֿеλ> <> <Ŀ¼>
+    if ((argc == 5) && !strcmp(argv[1], "-prebuilt"))
+    {
+        return prebuilt_check(argc - 2, argv + 2);
+    }
+
+    //ɲ(makefile): AutoMake -delta <ο̼> <¹̼> <ְ>
+    if ((argc == 5) && !strcmp(argv[1], "-delta"))
+    {
+        return delta_make(argc - 2, argv + 2);
+    }
+
+    //ϻԭ֤: AutoMake -patch <ο̼> <ְ> <̼>
+    if ((argc == 5) && !strcmp(argv[1], "-patch"))
+    {
+        return delta_apply(argc - 2, argv + 2);
+    }
+
+    //ѹ̼(makefile): AutoMake -lz <ԭʼ̼> <ѹ̼>
+    if ((argc == 4) && !strcmp(argv[1], "-lz"))
+    {
+        return lzimg_make(argc - 2, argv + 2);
+    }
+
+    //ֲʽĹ: AutoMake -worker [˿] []
+    if ((argc >= 2) && !strcmp(argv[1], "-worker"))
+    {
+        return dist_worker(argc - 2, argv + 2);
+    }
+
+    //̨ϴԶ̻(ɱװ): AutoMake -cache-put <> <ļ>
+    if ((argc == 4) && !strcmp(argv[1], "-cache-put"))
+    {
+        return rcache_upload(argc - 2, argv + 2);
+    }
+
+    //ػ: AutoMake -cache-server [˿] [Ŀ¼]
+    if ((argc >= 2) && !strcmp(argv[1], "-cache-server"))
+    {
+        return rcache_server(argc - 2, argv + 2);
+    }
 
     make_cfg.OTHER_D[0] = 0;
-    if ((argc == 2) && (argv[1][0] == '-') && (argv[1][1] == 'D'))
+    for (i = 1; i < argc; i++)
     {
-        strncpy(make_cfg.OTHER_D, argv[1], sizeof(make_cfg.OTHER_D));
+        if ((argv[i][0] == '-') && (argv[i][1] == 'D'))
+        {
+            strncpy(make_cfg.OTHER_D, argv[i], sizeof(make_cfg.OTHER_D));
+        }
+        else if (!strcmp(argv[i], "-bench"))
+        {
+            mode = MODE_BENCH;
+        }
+        else if (!strcmp(argv[i], "-trace") && (i + 1 < argc))
+        {
+            mode = MODE_TRACE;
+            pdump = argv[++i];
+        }
+        else if (!strcmp(argv[i], "-build"))
+        {
+            mode = MODE_BUILD;
+            if ((i + 1 < argc) && isdigit((int)argv[i + 1][0]))
+            {
+                jobs = atoi(argv[++i]);
+            }
+        }
+        else if (!strcmp(argv[i], "-hdrcost"))
+        {
+            mode = MODE_HDRCOST;
+            the_hdrcost = TRUE;
+        }
+        else if (!strcmp(argv[i], "-incpath"))
+        {
+            mode = MODE_INCPATH;
+            the_incpath = TRUE;
+        }
+        else if (!strcmp(argv[i], "-configs"))
+        {
+            configs = TRUE;
+        }
+        else if (!strcmp(argv[i], "-matrix"))
+        {
+            configs = TRUE;
+            the_matrix = TRUE;
+        }
+        else if (!strcmp(argv[i], "-rsp"))
+        {
+            the_rsp = TRUE;
+        }
+        else if (!strcmp(argv[i], "-confh"))
+        {
+            the_confh = TRUE;
+        }
+        else if (!strcmp(argv[i], "-lto"))
+        {
+            the_lto = TRUE;
+            the_lto_part = os_cpus();
+            if ((i + 1 < argc) && isdigit((int)argv[i + 1][0]))
+            {
+                the_lto_part = atoi(argv[++i]);
+            }
+            the_lto_part = MAX(1, the_lto_part);
+        }
+        else if (!strcmp(argv[i], "-hotplace") && (i + 1 < argc))
+        {
+            mode = MODE_HOTPLACE;
+            budget = strtoul(argv[++i], &pend, 0);
+            if ((*pend == 'k') || (*pend == 'K'))
+            {
+                budget *= 1024;
+            }
+            if ((i + 1 < argc) && (argv[i + 1][0] != '-'))
+            {
+                pprof = argv[++i];
+            }
+        }
+        else if (!strcmp(argv[i], "-ar"))
+        {
+            the_ar = 1;
+            if ((i + 1 < argc) && !strcmp(argv[i + 1], "full"))
+            {
+                the_ar = 2;
+                i++;
+            }
+        }
+        else if (!strcmp(argv[i], "-deadsrc"))
+        {
+            mode = MODE_DEADSRC;
+        }
+        else if (!strcmp(argv[i], "-dist") && (i + 1 < argc))
+        {
+            the_dist = argv[++i];
+        }
+        else if ((!strcmp(argv[i], "-cache") || !strcmp(argv[i], "-cache-rw")) && (i + 1 < argc))
+        {
+            the_cache_rw = !strcmp(argv[i], "-cache-rw") ? E_TRUE : E_FALSE;
+            the_cache = argv[++i];
+        }
+        else if (!strcmp(argv[i], "-explain"))
+        {
+            mode = MODE_EXPLAIN;
+        }
+        else if (!strcmp(argv[i], "-report"))
+        {
+            mode = MODE_REPORT;
+            if ((i + 1 < argc) && isdigit((int)argv[i + 1][0]))
+            {
+                last = atoi(argv[++i]);
+            }
+        }
+        else
+        {
+            printf("δ֪: %s\n", argv[i]);
+        }
     }
 
 	printf("!!!SP4 Auto Make v%s by LiuNing!!!\n", VERSION);
 
+    if (mode == MODE_BENCH)
+    {
+        if ((OK != make_cfg_init(&make_cfg)) || (OK != bench_run(&make_cfg)))
+        {
+            printf("׼ʧܣ\n");
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    if (mode == MODE_TRACE)
+    {
+        if (OK != make_cfg_init(&make_cfg))
+        {
+            return EXIT_FAILURE;
+        }
+        trace_cfg_get(&make_cfg, &trace_cfg);
+        if (OK != trace_decode(&trace_cfg, pdump))
+        {
+            printf("ʧܣ\n");
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    if (mode == MODE_REPORT)
+    {
+        if ((OK != make_cfg_init(&make_cfg)) || (OK != builddb_report(&make_cfg, last)))
+        {
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
     //ûʾȷ
     printf("ǰñݹ밴\n");
 //    getch();
@@ -1104,20 +2965,106 @@ int main(int argc,
     //1. svnش
 
     //2. ȡ
+    ms = os_ms();
     if (OK != make_cfg_init(&make_cfg))
     {
         printf("ȡʧܣ\n");
         goto __exit;
     }
+    builddb_phase("cfg", os_ms() - ms);
 
-    //3. makefile
-    if (OK != auto_make_bulid(&make_cfg, make_cfg.SRC_DIR, make_cfg.BUILD_DIR))
+    //2.1 -deadsrcmapиĿļĶͳ, Ա(-ar, Ԥ)-ltoʱmapû
+    if ((mode == MODE_DEADSRC) && (the_ar || the_lto || make_cfg.PREBUILT_DIRS[0]))
     {
-        printf("makefileʧܣ\n");
+        printf("-deadsrc-ar, -ltoPREBUILT_DIRSͬʱʹã\n");
+        goto __exit;
+    }
+
+    //2.2 ѡȵ㺯, hot.ld(ԤΪ0ʱɾ)
+    if ((mode == MODE_HOTPLACE) && (OK != hotplace_run(&make_cfg, budget, pprof)))
+    {
+        printf("ȵ㺯ʧܣ\n");
+        goto __exit;
+    }
+
+    //3. makefile, makefileĿ¼м¼ָ
+    ms = os_ms();
+    memcpy(&top_cfg, &make_cfg, sizeof(top_cfg));
+    if (configs)
+    {
+        strncat(top_cfg.BUILD_DIR, CONFIGS_SUFFIX,
+                sizeof(top_cfg.BUILD_DIR) - strlen(top_cfg.BUILD_DIR) - 1);
+    }
+    snprintf(args, sizeof(args), "%s/%s", make_cfg.BUILD_DIR, HOTPLACE_LD);
+    the_hot = _stat(args, &buf) ? FALSE : TRUE;
+    snprintf(args, sizeof(args), "%s|%s|%d|%d|%d|%d|%d|%d", build_id(), make_cfg.OTHER_D, configs + the_matrix,
+            the_rsp, the_confh, the_lto ? the_lto_part : 0, the_hot, the_ar);
+    key = stamp_key(args, the_inputs);
+
+    //3.1 (ini, .cproject, -D, 汾, Ŀ¼޸ʱ)ϴͬʱ
+    if (((mode == MODE_MAKE) || (mode == MODE_BUILD) || (mode == MODE_HOTPLACE))
+            && (OK == stamp_check(top_cfg.BUILD_DIR, key, &the_obj_cnt)))
+    {
+        printf("ûб仯, makefile\n");
+    }
+    else
+    {
+        stamp_begin(top_cfg.BUILD_DIR);
+        the_obj_cnt = 0;
+        if (OK != makefile_generate(configs))
+        {
+            goto __exit;
+        }
+        stamp_save(top_cfg.BUILD_DIR, key, the_obj_cnt);
+    }
+    builddb_phase("generate", os_ms() - ms);
+
+    //4. ִmake, ¼Ŀʱ
+    if (mode == MODE_BUILD)
+    {
+        //-distʱټϸĲ
+        if (!jobs)
+        {
+            jobs = os_cpus() + (the_dist ? dist_slots(the_dist) : 0);
+        }
+        //ʱҲҪ֪Ŀ¼, Աܱ¼
+        if (configs && !the_config_num && (OK != configs_get(&make_cfg)))
+        {
+            goto __exit;
+        }
+        if (OK != make_run(&top_cfg, jobs, the_obj_cnt))
+        {
+            printf("ʧܣ\n");
+            goto __exit;
+        }
+    }
+
+    //4.1 ´makeʱЩĿļҪ±뼰ԭ
+    if ((mode == MODE_EXPLAIN) && (OK != explain_run(&make_cfg)))
+    {
+        goto __exit;
+    }
+
+    //4.2 ͷļԤ
+    if ((mode == MODE_HDRCOST) && (OK != hdrcost_run(&make_cfg)))
+    {
+        printf("ͷļʧܣ\n");
         goto __exit;
     }
 
-    //4. ִmake
+    //4.3 ͷļ·
+    if ((mode == MODE_INCPATH) && (OK != incpath_run(&make_cfg)))
+    {
+        printf("ͷļ·ʧܣ\n");
+        goto __exit;
+    }
+
+    //4.4 Թ̼ûй׵Դļ
+    if ((mode == MODE_DEADSRC) && (OK != deadsrc_run(&make_cfg)))
+    {
+        printf("Դļʧܣ\n");
+        goto __exit;
+    }
 
     //5. ļ
 
@@ -0,0 +1,318 @@
+/**
+ ******************************************************************************
+ * @file      bench.c
+ * @brief     ָй̼, ͳƸָ
+ * @details   This file including all API functions's implement of bench.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "maths.h"
+#include "param.h"
+#include "symtab.h"
+#include "bench.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+#define BENCH_LOG           "bench.log"     /**< ָ־ */
+#define BENCH_REPORT        "bench.txt"     /**< Խ, CIȶ */
+#define BENCH_TOP           (20)            /**< δָʱ */
+
+/** лС */
+#define CMD_BUF_SIZE        (2048u)
+
+/** ·С */
+#define PATH_BUF_SIZE       (512u)
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   滻е{ELF} {LOG}
+ * @param[in]  *ptmpl : ģ
+ * @param[in]  *pelf  : elfļ
+ * @param[in]  *plog  : ־ļ
+ * @param[out] *pout  : 
+ * @param[in]  len    : 泤
+ *
+ * @return  None
+ ******************************************************************************
+ */
+static void
+bench_cmd_make(const char *ptmpl,
+        const char *pelf,
+        const char *plog,
+        char *pout,
+        int len)
+{
+    int n = 0;
+
+    while (*ptmpl && (n < len - 1))
+    {
+        if (!strncmp(ptmpl, "{ELF}", 5))
+        {
+            n += snprintf(pout + n, len - n, "%s", pelf);
+            ptmpl += 5;
+        }
+        else if (!strncmp(ptmpl, "{LOG}", 5))
+        {
+            n += snprintf(pout + n, len - n, "%s", plog);
+            ptmpl += 5;
+        }
+        else
+        {
+            pout[n++] = *ptmpl++;
+        }
+    }
+    pout[MIN(n, len - 1)] = 0;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ־, ۼָ
+ * @param[in]  *ptab    : ű
+ * @param[in]  *plog    : ־ļ
+ * @param[out] *pcount  : ָ(űһһӦ)
+ * @param[out] *ptotal  : ָ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note    qemu -d exec,nochainÿTBֻһָʱ, ÿжӦһָ:
+ *          Trace 0: 0x7f0c3c000100 [00000000/000004e8/...] func
+ ******************************************************************************
+ */
+static status_t
+bench_log_parse(const symtab_t *ptab,
+        const char *plog,
+        uint64 *pcount,
+        uint64 *ptotal)
+{
+    FILE *pfd;
+    char line[256];
+    char *p;
+    uint32 pc;
+    const sym_t *psym = NULL;
+
+    pfd = fopen(plog, "r");
+    if (!pfd)
+    {
+        printf("Ҳ־: %s\n", plog);
+        return ERROR;
+    }
+
+    *ptotal = 0;
+    while (fgets(line, sizeof(line), pfd))
+    {
+        if (strncmp(line, "Trace", 5))
+        {
+            continue;
+        }
+        p = strchr(line, '[');
+        p = p ? strchr(p, '/') : NULL;
+        if (!p)
+        {
+            continue;
+        }
+        pc = (uint32)strtoul(p + 1, NULL, 16);
+        (*ptotal)++;
+
+        //ָͬһ, ȱȽһεĽ
+        if (!psym || (pc < psym->addr) || (pc >= psym->addr + psym->size))
+        {
+            psym = symtab_find(ptab, pc);
+        }
+        if (psym)
+        {
+            pcount[psym - ptab->psym]++;
+        }
+    }
+    fclose(pfd);
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   һĲԽ
+ ******************************************************************************
+ */
+static void
+bench_print(FILE *pfd,
+        const char *pname,
+        uint64 count,
+        double cpi)
+{
+    printf("%-40s %12llu %14.0f\n", pname, (unsigned long long)count, count * cpi);
+    if (pfd)
+    {
+        fprintf(pfd, "%s\t%llu\t%.0f\n", pname, (unsigned long long)count, count * cpi);
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   л׼
+ * @param[in]  *pcfg : 
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note    ̼ɺͨsemihosting˳.
+ *          qemuھȷ, BENCH_CPIָ.
+ ******************************************************************************
+ */
+status_t
+bench_run(const make_cfg_t *pcfg)
+{
+    int i;
+    int j;
+    int top;
+    int status;
+    char *p;
+    char *delim = ";| ";
+    char elf[PATH_BUF_SIZE];
+    char log[PATH_BUF_SIZE];
+    char tmp[CMD_BUF_SIZE];
+    uint64 total = 0;
+    uint64 *pcount = NULL;
+    FILE *preport = NULL;
+    symtab_t tab;
+    const sym_t *psym;
+    status_t ret = ERROR;
+
+    snprintf(elf, sizeof(elf), "%s/%s.elf", pcfg->BUILD_DIR, pcfg->APP);
+    snprintf(log, sizeof(log), "%s/%s", pcfg->BUILD_DIR, BENCH_LOG);
+
+    if (OK != symtab_load(&tab, pcfg->CROSS_COMPILE, elf))
+    {
+        return ERROR;
+    }
+
+    do
+    {
+        //1. з
+        remove(log);
+        bench_cmd_make(pcfg->BENCH_SIM, elf, log, tmp, sizeof(tmp));
+        printf("з: %s\n", tmp);
+        status = system(tmp);
+        if (status)
+        {
+            printf("ʧ(%d)!\n", status);
+            break;
+        }
+
+        //2. ͳ
+        pcount = calloc(tab.num, sizeof(uint64));
+        if (!pcount)
+        {
+            break;
+        }
+        if (OK != bench_log_parse(&tab, log, pcount, &total))
+        {
+            break;
+        }
+        printf("ִ%lluָ\n\n", (unsigned long long)total);
+
+        //2.1 ִйĺ, -hotplaceʹ
+        snprintf(tmp, sizeof(tmp), "%s/%s", pcfg->BUILD_DIR, BENCH_PROFILE);
+        preport = fopen(tmp, "w");
+        if (preport)
+        {
+            fprintf(preport, "#function\tinstructions\n");
+            for (i = 0; i < tab.num; i++)
+            {
+                if (pcount[i])
+                {
+                    fprintf(preport, "%s\t%llu\n", tab.psym[i].pname, (unsigned long long)pcount[i]);
+                }
+            }
+            fclose(preport);
+        }
+
+        //3. 
+        snprintf(tmp, sizeof(tmp), "%s/%s", pcfg->BUILD_DIR, BENCH_REPORT);
+        preport = fopen(tmp, "w");
+        if (preport)
+        {
+            fprintf(preport, "#function\tinstructions\tcycles\n");
+        }
+        printf("%-40s %12s %14s\n", "function", "instructions", "cycles");
+
+        if (pcfg->BENCH_FUNCS[0])
+        {
+            strncpy(tmp, pcfg->BENCH_FUNCS, sizeof(tmp));
+            for (p = strtok(tmp, delim); p; p = strtok(NULL, delim))
+            {
+                psym = symtab_find_name(&tab, p);
+                if (!psym)
+                {
+                    printf("%-40s Ҳú\n", p);
+                    continue;
+                }
+                bench_print(preport, p, pcount[psym - tab.psym], pcfg->BENCH_CPI);
+            }
+        }
+        else
+        {
+            //ȵBENCH_TOP
+            for (top = 0; top < BENCH_TOP; top++)
+            {
+                for (i = 0, j = -1; i < tab.num; i++)
+                {
+                    if (pcount[i] && ((j < 0) || (pcount[i] > pcount[j])))
+                    {
+                        j = i;
+                    }
+                }
+                if (j < 0)
+                {
+                    break;
+                }
+                bench_print(preport, tab.psym[j].pname, pcount[j], pcfg->BENCH_CPI);
+                pcount[j] = 0;
+            }
+        }
+        ret = OK;
+    } while (0);
+
+    if (preport)
+    {
+        fclose(preport);
+    }
+    free(pcount);
+    symtab_free(&tab);
+
+    return ret;
+}
+
+/*---------------------------------bench.c-----------------------------------*/
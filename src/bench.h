@@ -0,0 +1,47 @@
+/**
+ ******************************************************************************
+ * @file       bench.h
+ * @brief      API include file of bench.h.
+ * @details    This file including all API functions's declare of bench.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include "types.h"
+#include "param.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#define BENCH_PROFILE       "bench_prof.txt"    /**< кָ(Ŀ¼) */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern status_t
+bench_run(const make_cfg_t *pcfg);
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* BENCH_H_ */
+/*------------------------------End of bench.h-------------------------------*/
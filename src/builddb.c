@@ -0,0 +1,674 @@
+/**
+ ******************************************************************************
+ * @file      builddb.c
+ * @brief     ʱʷ¼Ʊ
+ * @details   This file including all API functions's implement of builddb.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "types.h"
+#include "param.h"
+#include "os.h"
+#include "explain.h"
+#include "dist.h"
+#include "builddb.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** һαļ¼ */
+typedef struct
+{
+    long time;                  /**< ʼʱ */
+    int jobs;                   /**<  */
+    uint32 gen_ms;              /**< makefileʱ */
+    uint32 build_ms;            /**< makeʱ */
+    uint32 link_ms;             /**< Ӻʱ */
+    int total;                  /**< Ŀļ */
+    int built;                  /**< ʵʱ */
+    int hits;                   /**< е */
+    int status;                 /**< makeֵ */
+    int lto;                    /**< ǷΪ-lto */
+    uint32 flash;               /**< ̼ռflash(text + data), 0ʾδ֪ */
+    uint32 ram;                 /**< ̼ռram(data + bss) */
+} build_rec_t;
+
+/** һĿļıʱ */
+typedef struct
+{
+    char *pname;
+    int build;                  /**< ¼ */
+    uint32 ms;
+} obj_rec_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+#define BUILD_TIMES         ".build_times"      /**< иĿĺʱ */
+#define BUILD_DB            "build_history.db"  /**< ʷݿ */
+#define BUILD_SIZE          ".build_size"       /**< size */
+#define MAX_PHASES          (16)                /**< ¼ɽ׶ */
+#define TOP_FILES           (10)                /**< ʱļ */
+
+/** ļС */
+#define READ_BUF_SIZE       (1024u)
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static const char *the_phase_name[MAX_PHASES];  /**< ɽ׶ */
+static uint32 the_phase_ms[MAX_PHASES];         /**< ɽ׶κʱ */
+static int the_phase_cnt;
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   ¼һɽ׶εĺʱ
+ * @param[in]  *pname : ׶(ܺհ)
+ * @param[in]  ms     : ʱ
+ *
+ * @return  None
+ ******************************************************************************
+ */
+void
+builddb_phase(const char *pname,
+        uint32 ms)
+{
+    if (the_phase_cnt < MAX_PHASES)
+    {
+        the_phase_name[the_phase_cnt] = pname;
+        the_phase_ms[the_phase_cnt] = ms;
+        the_phase_cnt++;
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   װ: ִ¼ʱ
+ * @param[in]  *ptarget : Ŀļ($@)
+ * @param[in]  *argv    : 
+ *
+ * @return  ķֵ
+ *
+ * @note    makefileе$(CC_WRAP), ǰĿ¼ΪĿ¼.
+ *          AUTOMAKE_CACHEʱȲԶ̻, AUTOMAKE_DISTʱ
+ *          ڹϱ
+ ******************************************************************************
+ */
+int
+builddb_cc(const char *ptarget,
+        char *const argv[])
+{
+    int ret;
+    uint32 start;
+    const char *psta = "built";
+    char line[READ_BUF_SIZE];
+
+    start = os_ms();
+    if (E_TRUE != dist_cc(argv, &ret, &psta))
+    {
+        ret = os_run(argv, NULL, NULL);
+    }
+    if (!ret)
+    {
+        explain_record(ptarget, argv); //-explainʹ
+    }
+    snprintf(line, sizeof(line), "%s\t%u\t%s\n", ptarget,
+            os_ms() - start, ret ? "fail" : psta);
+    os_append(BUILD_TIMES, line);
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȡ̼С(size --format=berkeley)
+ * @param[in]  *pcfg   : 
+ * @param[out] *pflash : text + data
+ * @param[out] *pram   : data + bss
+ *
+ * @return  None(ʧʱ0)
+ ******************************************************************************
+ */
+static void
+builddb_size(const make_cfg_t *pcfg,
+        uint32 *pflash,
+        uint32 *pram)
+{
+    unsigned int text;
+    unsigned int data;
+    unsigned int bss;
+    char size[READ_BUF_SIZE];
+    char elf[READ_BUF_SIZE];
+    char out[READ_BUF_SIZE];
+    char line[READ_BUF_SIZE];
+    char *argv[4];
+    FILE *pfd;
+
+    *pflash = 0;
+    *pram = 0;
+    snprintf(size, sizeof(size), "%ssize", pcfg->CROSS_COMPILE);
+    snprintf(elf, sizeof(elf), "%s/%s.elf", pcfg->BUILD_DIR, pcfg->APP);
+    snprintf(out, sizeof(out), "%s/%s", pcfg->BUILD_DIR, BUILD_SIZE);
+    argv[0] = size;
+    argv[1] = "--format=berkeley";
+    argv[2] = elf;
+    argv[3] = NULL;
+    if (os_run(argv, out, NULL))
+    {
+        return;
+    }
+    pfd = fopen(out, "r");
+    while (pfd && fgets(line, sizeof(line), pfd))
+    {
+        if (sscanf(line, "%u %u %u", &text, &data, &bss) == 3)
+        {
+            *pflash = text + data;
+            *pram = data + bss;
+            break;
+        }
+    }
+    if (pfd)
+    {
+        fclose(pfd);
+    }
+    remove(out);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ǷΪĿļ(.o), ӵװĲ費
+ ******************************************************************************
+ */
+static bool_e
+builddb_is_obj(const char *pname)
+{
+    int len = strlen(pname);
+
+    return ((len > 2) && !strcmp(pname + len - 2, ".o")) ? E_TRUE : E_FALSE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   α׷ӵʷݿ
+ * @param[in]  *pcfg     : (ݿڵıĿ¼)
+ * @param[in]  *pbuilds  : ʵʱĸĿ¼(-configsʱΪ, ͬpcfg)
+ * @param[in]  build_num : Ŀ¼
+ * @param[in]  jobs      : 
+ * @param[in]  build_ms  : makeʱ
+ * @param[in]  obj_total : Ŀļ
+ * @param[in]  status    : makeֵ
+ * @param[in]  lto       : ǷΪ-lto
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note    1. ݿΪıļ, ÿαһB¼, G(ɽ׶)O(Ŀļ)¼
+ *          2. Ŀ¼ʱΪһ¼, Ŀļǰ, ̼СΪδ֪
+ *          3. O¼ֻ.o, ӼӺʱ, 費, Ա-ar/-lto
+ *             ļ¼ԱȽ
+ ******************************************************************************
+ */
+status_t
+builddb_record(const make_cfg_t *pcfg,
+        const make_cfg_t *pbuilds,
+        int build_num,
+        int jobs,
+        uint32 build_ms,
+        int obj_total,
+        int status,
+        bool_e lto)
+{
+    int i;
+    int k;
+    int built = 0;
+    int hits = 0;
+    unsigned int ms;
+    uint32 link_ms = 0;
+    uint32 flash = 0;
+    uint32 ram = 0;
+    char line[READ_BUF_SIZE];
+    char name[READ_BUF_SIZE];
+    char sta[16];
+    char times[READ_BUF_SIZE];
+    FILE *pin;
+    FILE *pdb;
+
+    snprintf(line, sizeof(line), "%s/%s", pcfg->BUILD_DIR, BUILD_DB);
+    pdb = fopen(line, "a");
+    if (!pdb)
+    {
+        return ERROR;
+    }
+
+    //1. ͳƱα
+    for (k = 0; k < build_num; k++)
+    {
+        snprintf(times, sizeof(times), "%s/%s", pbuilds[k].BUILD_DIR, BUILD_TIMES);
+        pin = fopen(times, "r");
+        while (pin && fgets(line, sizeof(line), pin))
+        {
+            if (sscanf(line, "%1023[^\t]\t%u\t%15s", name, &ms, sta) != 3)
+            {
+                continue;
+            }
+            if (strstr(name, ".elf"))
+            {
+                link_ms += ms;
+            }
+            else if (E_TRUE != builddb_is_obj(name))
+            {
+                continue;
+            }
+            else if (!strcmp(sta, "hit"))
+            {
+                hits++;
+            }
+            else
+            {
+                built++;
+            }
+        }
+        if (pin)
+        {
+            fclose(pin);
+        }
+    }
+
+    if (!status && (build_num == 1))
+    {
+        builddb_size(&pbuilds[0], &flash, &ram);
+    }
+
+    //2. дݿ(lto̼Сں, ǰļ¼)
+    fprintf(pdb, "B\t%ld\t%d\t%u\t%u\t%d\t%d\t%d\t%d\t%d\t%u\t%u\n", (long)time(NULL), jobs,
+            build_ms, link_ms, obj_total, built, hits, status, lto ? 1 : 0, flash, ram);
+    for (i = 0; i < the_phase_cnt; i++)
+    {
+        fprintf(pdb, "G\t%s\t%u\n", the_phase_name[i], the_phase_ms[i]);
+    }
+    for (k = 0; k < build_num; k++)
+    {
+        snprintf(times, sizeof(times), "%s/%s", pbuilds[k].BUILD_DIR, BUILD_TIMES);
+        pin = fopen(times, "r");
+        while (pin && fgets(line, sizeof(line), pin))
+        {
+            if ((sscanf(line, "%1023[^\t]\t%u\t%15s", name, &ms, sta) != 3)
+                    || (E_TRUE != builddb_is_obj(name)) || !strcmp(sta, "hit"))
+            {
+                continue;
+            }
+            if (build_num > 1)
+            {
+                fprintf(pdb, "O\t%s/%s\t%u\n", pbuilds[k].NAME, name, ms);
+            }
+            else
+            {
+                fprintf(pdb, "O\t%s\t%u\n", name, ms);
+            }
+        }
+        if (pin)
+        {
+            fclose(pin);
+        }
+        remove(times);
+    }
+    fclose(pdb);
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȽϺ(qsortʹ)
+ ******************************************************************************
+ */
+static int
+u32_cmp(const void *pa,
+        const void *pb)
+{
+    uint32 l = *(const uint32 *)pa;
+    uint32 r = *(const uint32 *)pb;
+
+    return (l < r) ? -1 : ((l > r) ? 1 : 0);
+}
+
+static int
+obj_cmp(const void *pa,
+        const void *pb)
+{
+    const obj_rec_t *pl = pa;
+    const obj_rec_t *pr = pb;
+    int ret = strcmp(pl->pname, pr->pname);
+
+    return ret ? ret : (pl->build - pr->build);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȡٷλ(nearest-rank)
+ * @param[in]  *pval : е
+ * @param[in]  num   : 
+ * @param[in]  pct   : ٷλ
+ *
+ * @return  ٷλ
+ ******************************************************************************
+ */
+static uint32
+percentile(const uint32 *pval,
+        int num,
+        int pct)
+{
+    int i;
+
+    if (num <= 0)
+    {
+        return 0;
+    }
+    i = (num * pct + 99) / 100 - 1;
+    return pval[(i < 0) ? 0 : i];
+}
+
+/**
+ ******************************************************************************
+ * @brief   ǰƽʱ仯
+ * @param[in]  *pname : 
+ * @param[in]  *pval  : ʱȺеĺʱ
+ * @param[in]  num    : 
+ *
+ * @return  None
+ ******************************************************************************
+ */
+static void
+trend_print(const char *pname,
+        const uint32 *pval,
+        int num)
+{
+    int i;
+    double old = 0;
+    double new = 0;
+
+    if (num < 2)
+    {
+        printf("  %s: ¼\n", pname);
+        return;
+    }
+    for (i = 0; i < num / 2; i++)
+    {
+        old += pval[i];
+    }
+    for (; i < num; i++)
+    {
+        new += pval[i];
+    }
+    old /= num / 2;
+    new /= num - num / 2;
+    printf("  %s: %.2fs -> %.2fs (%+.1f%%)\n", pname, old / 1000, new / 1000,
+            old ? (new - old) * 100 / old : 0.0);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ԱLTOLTO: ȡһγɹӹı
+ * @param[in]  *pb : ¼
+ * @param[in]  num : 
+ *
+ * @return  None
+ ******************************************************************************
+ */
+static void
+lto_print(const build_rec_t *pb,
+        int num)
+{
+    int i;
+    const build_rec_t *plast[2] = {NULL, NULL};
+    const build_rec_t *pl;
+    const build_rec_t *pn;
+
+    for (i = 0; i < num; i++)
+    {
+        if (!pb[i].status && pb[i].link_ms && pb[i].flash)
+        {
+            plast[pb[i].lto ? 1 : 0] = &pb[i];
+        }
+    }
+    pn = plast[0];
+    pl = plast[1];
+    if (!pl)
+    {
+        return;
+    }
+    printf("\nLTOԱ(ȡһӵı):\n");
+    if (!pn)
+    {
+        printf("  ûзLTOı¼, 벻-ltoٱһ\n");
+        return;
+    }
+    printf("  %-6s %10s %10s %8s\n", "", "flash", "ram", "link(s)");
+    printf("  %-6s %10u %10u %8.2f\n", "no-lto", pn->flash, pn->ram, pn->link_ms / 1000.0);
+    printf("  %-6s %10u %10u %8.2f\n", "lto", pl->flash, pl->ram, pl->link_ms / 1000.0);
+    printf("  %-6s %+9.1f%% %+9.1f%% %+7.1f%%\n", "",
+            ((double)pl->flash - pn->flash) * 100 / pn->flash,
+            pn->ram ? ((double)pl->ram - pn->ram) * 100 / pn->ram : 0.0,
+            ((double)pl->link_ms - pn->link_ms) * 100 / pn->link_ms);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ɴαƱ
+ * @param[in]  *pcfg : 
+ * @param[in]  last  : ͳٴα
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+status_t
+builddb_report(const make_cfg_t *pcfg,
+        int last)
+{
+    int i;
+    int j;
+    int k;
+    int first;
+    int nbuild = 0;
+    int nobj = 0;
+    int ninc = 0;
+    int nfull = 0;
+    int cur = -1;
+    unsigned int ms;
+    char line[READ_BUF_SIZE];
+    char name[READ_BUF_SIZE];
+    char date[32];
+    long t;
+    build_rec_t *pb = NULL;
+    obj_rec_t *po = NULL;
+    uint32 *pinc = NULL;
+    uint32 *pfull = NULL;
+    uint32 *psort = NULL;
+    obj_rec_t top[TOP_FILES];
+    int32 delta[TOP_FILES];
+    int32 d;
+    FILE *pfd;
+    status_t ret = ERROR;
+
+    snprintf(line, sizeof(line), "%s/%s", pcfg->BUILD_DIR, BUILD_DB);
+    pfd = fopen(line, "r");
+    if (!pfd)
+    {
+        printf("ûб¼: %s\n", line);
+        return ERROR;
+    }
+
+    do
+    {
+        //1. һ: ͳƼ¼, ȷ
+        while (fgets(line, sizeof(line), pfd))
+        {
+            if (line[0] == 'B')
+            {
+                nbuild++;
+            }
+            else if (line[0] == 'O')
+            {
+                nobj++;
+            }
+        }
+        first = (nbuild > last) ? (nbuild - last) : 0;
+        pb = calloc(nbuild + 1, sizeof(build_rec_t));
+        po = calloc(nobj + 1, sizeof(obj_rec_t));
+        pinc = calloc(nbuild + 1, sizeof(uint32));
+        pfull = calloc(nbuild + 1, sizeof(uint32));
+        psort = calloc(nbuild + 1, sizeof(uint32));
+        if (!pb || !po || !pinc || !pfull || !psort)
+        {
+            break;
+        }
+
+        //2. ڶ: 봰ڵļ¼
+        fseek(pfd, 0, SEEK_SET);
+        nbuild = 0;
+        nobj = 0;
+        while (fgets(line, sizeof(line), pfd))
+        {
+            if ((line[0] == 'B') && (++cur >= first))
+            {
+                build_rec_t *p = &pb[nbuild++];
+                sscanf(line + 2, "%ld %d %u %u %d %d %d %d %d %u %u", &t, &p->jobs,
+                        &p->build_ms, &p->link_ms, &p->total, &p->built,
+                        &p->hits, &p->status, &p->lto, &p->flash, &p->ram);
+                p->time = t;
+            }
+            else if ((line[0] == 'G') && (cur >= first) && nbuild
+                    && (sscanf(line + 2, "%*s %u", &ms) == 1))
+            {
+                pb[nbuild - 1].gen_ms += ms;
+            }
+            else if ((line[0] == 'O') && (cur >= first) && nbuild
+                    && (sscanf(line + 2, "%1023[^\t]\t%u", name, &ms) == 2))
+            {
+                po[nobj].pname = strdup(name);
+                po[nobj].build = nbuild - 1;
+                po[nobj].ms = ms;
+                nobj++;
+            }
+        }
+
+        //3. ÿα
+        printf("%dα:\n", nbuild);
+        printf("  %-12s %4s %8s %9s %8s %12s %6s\n",
+                "date", "jobs", "gen(ms)", "build(s)", "link(s)", "built/total", "hits");
+        for (i = 0; i < nbuild; i++)
+        {
+            time_t tt = pb[i].time;
+            strftime(date, sizeof(date), "%m-%d %H:%M", localtime(&tt));
+            printf("  %-12s %4d %8u %9.2f %8.2f %5d/%-6d %6d%s%s\n", date, pb[i].jobs,
+                    pb[i].gen_ms, pb[i].build_ms / 1000.0, pb[i].link_ms / 1000.0,
+                    pb[i].built, pb[i].total, pb[i].hits, pb[i].lto ? " lto" : "",
+                    pb[i].status ? " ʧ" : "");
+            if (pb[i].status)
+            {
+                continue;
+            }
+            if (pb[i].built < pb[i].total)
+            {
+                pinc[ninc++] = pb[i].build_ms;
+            }
+            else
+            {
+                pfull[nfull++] = pb[i].build_ms;
+            }
+        }
+
+        //4. ٷλ
+        memcpy(psort, pinc, ninc * sizeof(uint32));
+        qsort(psort, ninc, sizeof(uint32), u32_cmp);
+        printf("\n%d: p50 = %.2fs, p95 = %.2fs\n", ninc,
+                percentile(psort, ninc, 50) / 1000.0, percentile(psort, ninc, 95) / 1000.0);
+        printf("(ǰƽ -> ƽ):\n");
+        trend_print("", pinc, ninc);
+        trend_print("ȫ", pfull, nfull);
+        lto_print(pb, nbuild);
+
+        //5. ʱļ: һ֮ǰλ֮
+        memset(delta, 0x00, sizeof(delta));
+        memset(top, 0x00, sizeof(top));
+        qsort(po, nobj, sizeof(obj_rec_t), obj_cmp);
+        for (i = 0; i < nobj; i = j)
+        {
+            for (j = i + 1; (j < nobj) && !strcmp(po[i].pname, po[j].pname); j++)
+            {
+            }
+            if (j - i < 2)
+            {
+                continue;
+            }
+            for (k = i; k < j - 1; k++)
+            {
+                psort[k - i] = po[k].ms;
+            }
+            qsort(psort, j - 1 - i, sizeof(uint32), u32_cmp);
+            d = (int32)po[j - 1].ms - (int32)psort[(j - 1 - i) / 2];
+            for (k = TOP_FILES; (k > 0) && (d > delta[k - 1]); k--)
+            {
+                if (k < TOP_FILES)
+                {
+                    delta[k] = delta[k - 1];
+                    top[k] = top[k - 1];
+                }
+            }
+            if (k < TOP_FILES)
+            {
+                delta[k] = d;
+                top[k] = po[j - 1];
+                top[k].ms = psort[(j - 1 - i) / 2];
+            }
+        }
+        printf("\nʱļ(һ֮ǰλȽ):\n");
+        for (i = 0; (i < TOP_FILES) && (delta[i] > 0); i++)
+        {
+            printf("  %-50s %6ums -> %6ums (%+dms)\n", top[i].pname,
+                    top[i].ms, top[i].ms + delta[i], delta[i]);
+        }
+        if (i == 0)
+        {
+            printf("  \n");
+        }
+        ret = OK;
+    } while (0);
+
+    fclose(pfd);
+    for (i = 0; po && (i < nobj); i++)
+    {
+        free(po[i].pname);
+    }
+    free(po);
+    free(pb);
+    free(pinc);
+    free(pfull);
+    free(psort);
+
+    return ret;
+}
+
+/*---------------------------------builddb.c---------------------------------*/
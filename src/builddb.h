@@ -0,0 +1,66 @@
+/**
+ ******************************************************************************
+ * @file       builddb.h
+ * @brief      API include file of builddb.h.
+ * @details    This file including all API functions's declare of builddb.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef BUILDDB_H_
+#define BUILDDB_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include "types.h"
+#include "param.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern void
+builddb_phase(const char *pname,
+        uint32 ms);
+
+extern int
+builddb_cc(const char *ptarget,
+        char *const argv[]);
+
+extern status_t
+builddb_record(const make_cfg_t *pcfg,
+        const make_cfg_t *pbuilds,
+        int build_num,
+        int jobs,
+        uint32 build_ms,
+        int obj_total,
+        int status,
+        bool_e lto);
+
+extern status_t
+builddb_report(const make_cfg_t *pcfg,
+        int last);
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* BUILDDB_H_ */
+/*-----------------------------End of builddb.h------------------------------*/
@@ -0,0 +1,216 @@
+/**
+ ******************************************************************************
+ * @file      cfgcache.c
+ * @brief     , ûб仯ʱini.cproject
+ * @details   This file including all API functions's implement of cfgcache.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "os.h"
+#include "cfgcache.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ * ļͷ, ṹԭʼ, ٸnumַ(Ϊ
+ * uint32(β0) + ). ṹеָڶַ滻
+ */
+typedef struct
+{
+    char magic[4];              /**< CFGCACHE_MAGIC */
+    uint32 version;             /**< ʽ汾 */
+    uint32 len;                 /**< ṹ峤, ṹıʱʧЧ */
+    uint32 num;                 /**< ַ */
+    uint64 key;                 /**< ָ */
+} cfgcache_head_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+#define CFGCACHE_MAGIC      "AMCC"
+#define CFGCACHE_VERSION    (2u)
+#define CFGCACHE_MAX_STR    (8)     /**< ໺ַ */
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   ȡ
+ * @param[in]  *pfile : ļ
+ * @param[in]  key    : εָ
+ * @param[out] *pdata : ز
+ * @param[in]  len    : 
+ * @param[out] pstr   : ַ(malloc)
+ * @param[in]  num    : ַ
+ *
+ * @retval  OK    : Ч, Ѷ
+ * @retval  ERROR : 治ڻʧЧ, pdatapstr
+ ******************************************************************************
+ */
+status_t
+cfgcache_load(const char *pfile,
+        uint64 key,
+        void *pdata,
+        uint32 len,
+        char *pstr[],
+        int num)
+{
+    int i;
+    uint32 size;
+    uint32 slen;
+    uint32 pos;
+    const char *paddr;
+    char *ptmp[CFGCACHE_MAX_STR];
+    cfgcache_head_t head;
+    status_t ret = ERROR;
+
+    if (num > CFGCACHE_MAX_STR)
+    {
+        return ERROR;
+    }
+    paddr = os_fmap(pfile, &size);
+    if (!paddr)
+    {
+        return ERROR;
+    }
+
+    memset(ptmp, 0x00, sizeof(ptmp));
+    do
+    {
+        if (size < sizeof(head) + len)
+        {
+            break;
+        }
+        memcpy(&head, paddr, sizeof(head)); //ӳַ֤
+        if (memcmp(head.magic, CFGCACHE_MAGIC, sizeof(head.magic))
+                || (head.version != CFGCACHE_VERSION)
+                || (head.len != len)
+                || (head.num != (uint32)num)
+                || (head.key != key))
+        {
+            break;
+        }
+        for (pos = sizeof(head) + len, i = 0; i < num; i++)
+        {
+            if (size - pos < sizeof(slen))
+            {
+                break;
+            }
+            memcpy(&slen, paddr + pos, sizeof(slen));
+            pos += sizeof(slen);
+            if ((slen == 0) || (slen > size - pos) || paddr[pos + slen - 1])
+            {
+                break;
+            }
+            ptmp[i] = malloc(slen);
+            if (!ptmp[i])
+            {
+                break;
+            }
+            memcpy(ptmp[i], paddr + pos, slen);
+            pos += slen;
+        }
+        if ((i < num) || (pos != size))
+        {
+            break;
+        }
+        memcpy(pdata, paddr + sizeof(head), len);
+        memcpy(pstr, ptmp, num * sizeof(*pstr));
+        ret = OK;
+    } while (0);
+    os_funmap(paddr);
+
+    if (OK != ret)
+    {
+        for (i = 0; i < num; i++)
+        {
+            free(ptmp[i]);
+        }
+    }
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ɹ󱣴
+ * @param[in]  *pfile : ļ
+ * @param[in]  key    : ָ
+ * @param[in]  *pdata : 
+ * @param[in]  len    : 
+ * @param[in]  pstr   : ַָָ
+ * @param[in]  num    : ַ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+status_t
+cfgcache_save(const char *pfile,
+        uint64 key,
+        const void *pdata,
+        uint32 len,
+        const char *const pstr[],
+        int num)
+{
+    int i;
+    FILE *pfd;
+    bool_e ok;
+    uint32 slen;
+    cfgcache_head_t head;
+
+    memset(&head, 0x00, sizeof(head));
+    memcpy(head.magic, CFGCACHE_MAGIC, sizeof(head.magic));
+    head.version = CFGCACHE_VERSION;
+    head.len = len;
+    head.num = num;
+    head.key = key;
+
+    pfd = fopen(pfile, "wb");
+    if (!pfd)
+    {
+        return ERROR;
+    }
+    ok = (fwrite(&head, sizeof(head), 1, pfd) == 1)
+            && (fwrite(pdata, len, 1, pfd) == 1);
+    for (i = 0; ok && (i < num); i++)
+    {
+        slen = strlen(pstr[i]) + 1;
+        ok = (fwrite(&slen, sizeof(slen), 1, pfd) == 1)
+                && (fwrite(pstr[i], slen, 1, pfd) == 1);
+    }
+    if (fclose(pfd) || !ok)
+    {
+        remove(pfile); //дһĻ泤Ȳ, Ҳᱻ
+        return ERROR;
+    }
+
+    return OK;
+}
+
+/*--------------------------------cfgcache.c---------------------------------*/
@@ -0,0 +1,59 @@
+/**
+ ******************************************************************************
+ * @file       cfgcache.h
+ * @brief      API include file of cfgcache.h.
+ * @details    This file including all API functions's declare of cfgcache.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef CFGCACHE_H_
+#define CFGCACHE_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include "types.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern status_t
+cfgcache_load(const char *pfile,
+        uint64 key,
+        void *pdata,
+        uint32 len,
+        char *pstr[],
+        int num);
+
+extern status_t
+cfgcache_save(const char *pfile,
+        uint64 key,
+        const void *pdata,
+        uint32 len,
+        const char *const pstr[],
+        int num);
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* CFGCACHE_H_ */
+/*-----------------------------End of cfgcache.h-----------------------------*/
@@ -0,0 +1,652 @@
+/**
+ ******************************************************************************
+ * @file      confh.c
+ * @brief     -Dдͷļ, Դļʵõĺд(Kconfigfixdep)
+ * @details   This file including all API functions's implement of confh.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <io.h>
+#include "types.h"
+#include "maths.h"
+#include "param.h"
+#include "os.h"
+#include "hash.h"
+#include "confh.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/**  */
+typedef struct
+{
+    char name[64];              /**<  */
+    char *pdef;                 /**< "() ֵ", NULLʾδ(ǰ) */
+    bool_e used;                /**< fixdep: Դļͷļ */
+} confh_sym_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+#define CONFH_SYM_FILE      CONFH_DIR "/auto.sym"   /**< ֹк */
+#define CONFH_MAX_SYMS      (1024)                  /**< ĺ */
+#define CONFH_HASH_SIZE     (2048)                  /**< ϣС(2) */
+
+/** ·С */
+#define PATH_BUF_SIZE       (512u)
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static confh_sym_t the_sym[CONFH_MAX_SYMS];
+static int the_sym_num;
+static int the_hash[CONFH_HASH_SIZE];   /**< the_sym±, -1Ϊ */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   պ
+ ******************************************************************************
+ */
+static void
+confh_reset(void)
+{
+    int i;
+
+    for (i = 0; i < the_sym_num; i++)
+    {
+        free(the_sym[i].pdef);
+    }
+    the_sym_num = 0;
+    memset(the_hash, 0xff, sizeof(the_hash));
+}
+
+/**
+ ******************************************************************************
+ * @brief   ǷΪʶַ
+ ******************************************************************************
+ */
+static bool_e
+confh_is_ident(char c)
+{
+    return (((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z'))
+            || isdigit(c) || (c == '_')) ? E_TRUE : E_FALSE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   Һ
+ * @param[in]  *pname : (0β)
+ * @param[in]  len    : 
+ * @param[in]  create : ʱǷ½
+ *
+ * @retval  >=0 : ±
+ * @retval   -1 : ڻ
+ ******************************************************************************
+ */
+static int
+confh_find(const char *pname,
+        int len,
+        bool_e create)
+{
+    int j;
+
+    if ((len <= 0) || (len >= (int)sizeof(the_sym[0].name)))
+    {
+        return -1;
+    }
+    for (j = (uint32)hash_fnv(pname, len, HASH_INIT) & (CONFH_HASH_SIZE - 1);
+            the_hash[j] >= 0; j = (j + 1) & (CONFH_HASH_SIZE - 1))
+    {
+        if (!strncmp(the_sym[the_hash[j]].name, pname, len)
+                && !the_sym[the_hash[j]].name[len])
+        {
+            return the_hash[j];
+        }
+    }
+    if (!create || (the_sym_num >= CONFH_MAX_SYMS))
+    {
+        return -1;
+    }
+    memcpy(the_sym[the_sym_num].name, pname, len);
+    the_sym[the_sym_num].name[len] = 0;
+    the_sym[the_sym_num].pdef = NULL;
+    the_sym[the_sym_num].used = E_FALSE;
+    the_hash[j] = the_sym_num;
+
+    return the_sym_num++;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȡֹĺ(ÿһ)
+ * @param[in]  *pfile : auto.sym
+ *
+ * @return  None
+ ******************************************************************************
+ */
+static void
+confh_sym_load(const char *pfile)
+{
+    uint32 size;
+    const char *s;
+    const char *p;
+    const char *pend;
+    const char *paddr;
+
+    paddr = os_fmap(pfile, &size);
+    if (!paddr)
+    {
+        return;
+    }
+    for (p = paddr, pend = paddr + size; p < pend; )
+    {
+        s = p;
+        while ((p < pend) && confh_is_ident(*p))
+        {
+            p++;
+        }
+        (void)confh_find(s, p - s, E_TRUE);
+        while ((p < pend) && (*p != '\n'))
+        {
+            p++;
+        }
+        p++;
+    }
+    os_funmap(paddr);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ¼һ-D
+ * @param[in]  *ptoken : -D֮, "A", "A=2", "S=\"v1\""
+ * @param[in]  len     : 
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : , ڴ治(е-Dȥ, ܺ)
+ *
+ * @note    ȥshell, \"ԭΪ", ͬԺֵΪ׼(ͬgcc)
+ ******************************************************************************
+ */
+static status_t
+confh_define(const char *ptoken,
+        int len)
+{
+    int i;
+    int n;
+    int idx;
+    char *p;
+    char *pdef;
+
+    //"A=2"Ϊ"A 2", "A"Ϊ"A 1"
+    pdef = malloc(len + 3);
+    if (!pdef)
+    {
+        printf("-D%.*s: ڴ治\n", len, ptoken);
+        return ERROR;
+    }
+    for (i = 0, n = 0; i < len; i++)
+    {
+        if ((ptoken[i] == '\\') && (i + 1 < len) && (ptoken[i + 1] == '"'))
+        {
+            pdef[n++] = ptoken[++i];
+        }
+        else if (ptoken[i] != '"')
+        {
+            pdef[n++] = ptoken[i];
+        }
+    }
+    pdef[n] = 0;
+    p = strchr(pdef, '=');
+    if (p)
+    {
+        *p = ' ';
+    }
+    else
+    {
+        strcat(pdef, " 1");
+    }
+
+    for (n = 0; confh_is_ident(pdef[n]); n++)
+    {
+    }
+    idx = confh_find(pdef, n, E_TRUE);
+    if (idx < 0)
+    {
+        printf("-D%.*s: %dַ, %d, ʹ-confh\n", len, ptoken,
+                (int)sizeof(the_sym[0].name), CONFH_MAX_SYMS);
+        free(pdef);
+        return ERROR;
+    }
+    free(the_sym[idx].pdef);
+    the_sym[idx].pdef = pdef;
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   еĸ(ڵĿո񲻷ָ)
+ * @param[in]  *pflags : 
+ * @param[out] **pend  : رβ
+ *
+ * @retval  !NULL : ʼ
+ * @retval   NULL : û
+ ******************************************************************************
+ */
+static const char *
+confh_token(const char *pflags,
+        const char **pend)
+{
+    const char *p = pflags;
+    const char *s;
+    bool_e quote = E_FALSE;
+
+    while ((*p == ' ') || (*p == '\t'))
+    {
+        p++;
+    }
+    if (!*p)
+    {
+        return NULL;
+    }
+    for (s = p; *p && (quote || ((*p != ' ') && (*p != '\t'))); p++)
+    {
+        if ((*p == '"') && ((p == s) || (p[-1] != '\\')))
+        {
+            quote = !quote;
+        }
+    }
+    *pend = p;
+
+    return s;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȥе-D
+ * @param[in]  *pflags : 
+ * @param[out] *pout   : ر
+ * @param[in]  len     : 泤
+ *
+ * @return  None
+ ******************************************************************************
+ */
+void
+confh_strip(const char *pflags,
+        char *pout,
+        int len)
+{
+    int n = 0;
+    const char *s;
+    const char *e;
+
+    pout[0] = 0;
+    for (s = confh_token(pflags, &e); s; s = confh_token(e, &e))
+    {
+        if ((s[0] == '-') && (s[1] == 'D'))
+        {
+            continue;
+        }
+        if (n + (e - s) + 2 > len)
+        {
+            break;
+        }
+        if (n)
+        {
+            pout[n++] = ' ';
+        }
+        memcpy(pout + n, s, e - s);
+        n += e - s;
+        pout[n] = 0;
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ͷļ
+ * @param[in]  *pcfg  : 
+ * @param[in]  *proot : ʱ·
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note    1. config/autoconf.h-D, ʱ-include, ٳ
+ *          2. ÿconfig/<>.h, ݲʱд. Դļ
+ *             fixdepΪõĺӦļ, һֻرԴļ
+ *          3. ȥĺдΪ#undef, ùԴļҲر
+ *          4. µĺʱauto.symı, Դļر(֮ǰ޷֪˭)
+ ******************************************************************************
+ */
+status_t
+confh_create(const make_cfg_t *pcfg,
+        const char *proot)
+{
+    int i;
+    int n;
+    int len;
+    int max;
+    char *pbuf;
+    const char *s;
+    const char *e;
+    char tmp[PATH_BUF_SIZE];
+    char line[PATH_BUF_SIZE];
+    status_t ret = OK;
+
+    //1. ǰֹĺǰ, auto.sym˳򲻱
+    confh_reset();
+    snprintf(tmp, sizeof(tmp), "%s/%s", proot, CONFH_DIR);
+    (void)mkdir(tmp);
+    snprintf(tmp, sizeof(tmp), "%s/%s", proot, CONFH_SYM_FILE);
+    confh_sym_load(tmp);
+
+    //2. ε-D
+    for (s = confh_token(pcfg->CCFLAGS, &e); s; s = confh_token(e, &e))
+    {
+        if ((s[0] == '-') && (s[1] == 'D') && (e - s > 2)
+                && (OK != confh_define(s + 2, e - s - 2)))
+        {
+            confh_reset();
+            return ERROR;
+        }
+    }
+    for (s = confh_token(pcfg->OTHER_D, &e); s; s = confh_token(e, &e))
+    {
+        if ((s[0] == '-') && (s[1] == 'D') && (e - s > 2)
+                && (OK != confh_define(s + 2, e - s - 2)))
+        {
+            confh_reset();
+            return ERROR;
+        }
+    }
+
+    //3. ÿһļ
+    for (max = 64, i = 0; i < the_sym_num; i++)
+    {
+        snprintf(tmp, sizeof(tmp), "%s/%s/%s.h", proot, CONFH_DIR, the_sym[i].name);
+        if (the_sym[i].pdef)
+        {
+            n = snprintf(line, sizeof(line), "#define %s\n", the_sym[i].pdef);
+            max += strlen(the_sym[i].pdef) + 10;
+        }
+        else
+        {
+            n = snprintf(line, sizeof(line), "#undef %s\n", the_sym[i].name);
+        }
+        max += sizeof(the_sym[i].name) + 1;
+        if ((n >= (int)sizeof(line)) || (OK != os_fupdate(tmp, line, n)))
+        {
+            printf("%sʧ\n", tmp);
+            ret = ERROR;
+        }
+    }
+
+    //4. autoconf.hauto.sym
+    pbuf = malloc(max);
+    if (!pbuf)
+    {
+        confh_reset();
+        return ERROR;
+    }
+    len = snprintf(pbuf, max, "/* AutoMake, ޸ */\n");
+    for (i = 0; i < the_sym_num; i++)
+    {
+        if (the_sym[i].pdef)
+        {
+            len += snprintf(pbuf + len, max - len, "#define %s\n", the_sym[i].pdef);
+        }
+    }
+    snprintf(tmp, sizeof(tmp), "%s/%s", proot, CONFH_FILE);
+    if (OK != os_fupdate(tmp, pbuf, len))
+    {
+        ret = ERROR;
+    }
+    for (len = 0, i = 0; i < the_sym_num; i++)
+    {
+        len += snprintf(pbuf + len, max - len, "%s\n", the_sym[i].name);
+    }
+    snprintf(tmp, sizeof(tmp), "%s/%s", proot, CONFH_SYM_FILE);
+    if (OK != os_fupdate(tmp, pbuf, len))
+    {
+        ret = ERROR;
+    }
+    free(pbuf);
+    confh_reset();
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ļõĺ
+ * @param[in]  *pfile : Դļͷļ
+ *
+ * @return  None
+ *
+ * @note    fixdepͬ, עͼַ, ֻ
+ ******************************************************************************
+ */
+static void
+confh_scan(const char *pfile)
+{
+    int idx;
+    uint32 size;
+    const char *s;
+    const char *p;
+    const char *pend;
+    const char *paddr;
+
+    paddr = os_fmap(pfile, &size);
+    if (!paddr)
+    {
+        return;
+    }
+    for (p = paddr, pend = paddr + size; p < pend; )
+    {
+        if (!confh_is_ident(*p))
+        {
+            p++;
+            continue;
+        }
+        for (s = p; (p < pend) && confh_is_ident(*p); p++)
+        {
+        }
+        if (!isdigit(*s)) //0x1F֮
+        {
+            idx = confh_find(s, p - s, E_FALSE);
+            if (idx >= 0)
+            {
+                the_sym[idx].used = E_TRUE;
+            }
+        }
+    }
+    os_funmap(paddr);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ǷΪconfigĿ¼µļ
+ ******************************************************************************
+ */
+static bool_e
+confh_is_conf(const char *ptoken,
+        int len)
+{
+    int n = strlen(CONFH_DIR "/");
+
+    if ((len > 2) && !strncmp(ptoken, "./", 2))
+    {
+        ptoken += 2;
+        len -= 2;
+    }
+    return ((len > n) && !strncmp(ptoken, CONFH_DIR "/", n)) ? E_TRUE : E_FALSE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   дgcc -MMDɵļ: ȥconfig/autoconf.h, õ
+ *          Ӧconfig/<>.hconfig/auto.sym
+ * @param[in]  *pdep : ļ(xx.d)
+ *
+ * @retval  0 : ɹ(ļʱֲ)
+ * @retval  1 : ʧ
+ *
+ * @note    makefileڱ(AutoMake -fixdep xx.d), ǰĿ¼ΪĿ¼
+ ******************************************************************************
+ */
+int
+confh_fixdep(const char *pdep)
+{
+    int i;
+    int n;
+    uint32 size;
+    const char *p;
+    const char *s;
+    const char *pend;
+    const char *pline;
+    const char *paddr;
+    char tmp[PATH_BUF_SIZE];
+    char path[PATH_BUF_SIZE];
+    FILE *pfd;
+    bool_e ok;
+
+    confh_reset();
+    confh_sym_load(CONFH_SYM_FILE);
+    paddr = os_fmap(pdep, &size);
+    if (!paddr)
+    {
+        return 0;
+    }
+    pend = paddr + size;
+
+    //1. Ŀ(ðźհ, ̷еðŲ)
+    for (p = paddr; (p < pend) && !((*p == ':') && ((p + 1 == pend) || isspace(p[1]))); p++)
+    {
+    }
+    snprintf(tmp, sizeof(tmp), "%s.tmp", pdep);
+    pfd = fopen(tmp, "wb");
+    if ((p == pend) || !pfd)
+    {
+        if (pfd)
+        {
+            fclose(pfd);
+            remove(tmp);
+        }
+        os_funmap(paddr);
+        return 1;
+    }
+    fprintf(pfd, "%.*s:", (int)(p - paddr), paddr);
+
+    //2. , зĻΪֹ
+    for (p++, n = 0; p < pend; )
+    {
+        if ((*p == ' ') || (*p == '\t') || (*p == '\r'))
+        {
+            p++;
+            continue;
+        }
+        if ((*p == '\\') && (p + 1 < pend) && ((p[1] == '\n') || (p[1] == '\r')))
+        {
+            for (p++; (p < pend) && (*p != '\n'); p++)
+            {
+            }
+            p++;
+            continue;
+        }
+        if (*p == '\n')
+        {
+            p++;
+            break;
+        }
+        for (s = p, i = 0; (p < pend) && !isspace(*p); p++)
+        {
+            if ((*p == '\\') && (p + 1 < pend) && (p[1] == ' '))
+            {
+                p++; //"\ "ΪļеĿո
+            }
+            else if ((*p == '\\') && (p + 1 < pend) && isspace(p[1]))
+            {
+                break;
+            }
+            if (i < (int)sizeof(path) - 1)
+            {
+                path[i++] = *p;
+            }
+        }
+        path[i] = 0;
+        if (confh_is_conf(s, p - s))
+        {
+            continue;
+        }
+        fprintf(pfd, "%s%.*s", n++ ? " \\\n " : " ", (int)(p - s), s);
+        confh_scan(path);
+    }
+
+    //3. õĺ
+    fprintf(pfd, " \\\n %s", CONFH_SYM_FILE);
+    for (i = 0; i < the_sym_num; i++)
+    {
+        if (the_sym[i].used)
+        {
+            fprintf(pfd, " \\\n %s/%s.h", CONFH_DIR, the_sym[i].name);
+        }
+    }
+    fprintf(pfd, "\n");
+
+    //4. (-MPɵĿչ)ԭ, ȥconfig/autoconf.h
+    for (pline = p; pline < pend; pline = p)
+    {
+        for (p = pline; (p < pend) && (*p != '\n'); p++)
+        {
+        }
+        if (p < pend)
+        {
+            p++;
+        }
+        for (s = pline; (s < p) && !((*s == ':') && ((s + 1 == p) || isspace(s[1]))); s++)
+        {
+        }
+        if ((s < p) && (s > pline) && confh_is_conf(pline, s - pline))
+        {
+            continue;
+        }
+        fwrite(pline, 1, p - pline, pfd);
+    }
+    ok = ferror(pfd) ? E_FALSE : E_TRUE;
+    os_funmap(paddr);
+    confh_reset();
+
+    if (fclose(pfd) || !ok)
+    {
+        remove(tmp);
+        return 1;
+    }
+    remove(pdep); //windowsrenameļ
+    if (rename(tmp, pdep))
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/*----------------------------------confh.c----------------------------------*/
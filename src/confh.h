@@ -0,0 +1,57 @@
+/**
+ ******************************************************************************
+ * @file       confh.h
+ * @brief      API include file of confh.h.
+ * @details    This file including all API functions's declare of confh.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef CONFH_H_
+#define CONFH_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include "types.h"
+#include "param.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#define CONFH_DIR           "config"                /**< Ŀ¼µͷļĿ¼ */
+#define CONFH_FILE          CONFH_DIR "/autoconf.h" /**< -D, ʱ-include */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern status_t
+confh_create(const make_cfg_t *pcfg,
+        const char *proot);
+
+extern void
+confh_strip(const char *pflags,
+        char *pout,
+        int len);
+
+extern int
+confh_fixdep(const char *pdep);
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* CONFH_H_ */
+/*------------------------------End of confh.h-------------------------------*/
@@ -15,11 +15,40 @@
 #include "types.h"
 #include "maths.h"
 #include "param.h"
+#include "os.h"
 
 /*-----------------------------------------------------------------------------
  Section: Type Definitions
  ----------------------------------------------------------------------------*/
-/* NONE */
+/** xml״̬ */
+typedef struct
+{
+    const char *p;              /**< ǰλ */
+    const char *end;            /**< ļβ */
+} xml_t;
+
+/** xmlǩ */
+typedef struct
+{
+    const char *pname;          /**< ǩ */
+    int name_len;
+    const char *pattr;          /**<  */
+    int attr_len;
+    bool_e close;               /**< </tag> */
+    bool_e empty;               /**< <tag/> */
+} xml_tag_t;
+
+/** Ҫȡoption */
+typedef enum
+{
+    OPT_NONE = 0,
+    OPT_I,
+    OPT_L,
+    OPT_l,
+    OPT_T,
+    OPT_D,
+    OPT_NUM,
+} cproject_opt_e;
 
 /*-----------------------------------------------------------------------------
  Section: Constant Definitions
@@ -45,7 +74,10 @@
 #define DEFAULT_LDFLAGS     " --specs=nano.specs"
 #define DEFAULT_EXCLUDE     "bsp/test|sys/test"
 
-/** ļС */
+/** ȡ */
+#define CPROJECT_MAX_CFGS   (8)
+
+/** ֵС */
 #define READ_BUF_SIZE       (1024u)
 
 /*-----------------------------------------------------------------------------
@@ -56,7 +88,16 @@
 /*-----------------------------------------------------------------------------
  Section: Local Variables
  ----------------------------------------------------------------------------*/
-static char the_buf[READ_BUF_SIZE];
+/** optionname */
+static const char *const the_opt_name[OPT_NUM] =
+{
+    "",
+    "Include paths (-I)",
+    "Library search path (-L)",
+    "Libraries (-l)",
+    "Script files (-T)",
+    "Defined symbols (-D)",
+};
 
 /*-----------------------------------------------------------------------------
  Section: Local Function Prototypes
@@ -103,484 +144,672 @@ cproject_get_default(pcfg_t *pcfg)
 
 /**
  ******************************************************************************
- * @brief   ļÿһ, ҳƥַ
- * @param[in]  *pfd  : ļ
- * @param[in]  *pstr : 鵽ַ
+ * @brief   ȡһǩ
+ * @param[in]  *pxml : ״̬
+ * @param[out] *ptag : ǩ
  *
  * @retval  OK    : ɹ
- * @retval  ERROR : ʧ
+ * @retval  ERROR : ѵļβ
+ *
+ * @note    ı, ע, <?...?><!...>, ֻʶǩ
  ******************************************************************************
  */
 static status_t
-file_find_str(FILE *pfd,
-        const char *pstr)
+xml_next(xml_t *pxml,
+        xml_tag_t *ptag)
 {
-    char flag = 0;
-    status_t ret = ERROR;
+    const char *p = pxml->p;
+    const char *end = pxml->end;
+    const char *q;
+    char quote;
 
-    do
+    while (p < end)
     {
-        //1. ƶͷ
-        fseek(pfd, 0, SEEK_SET);
+        p = memchr(p, '<', end - p);
+        if (!p || (p + 1 >= end))
+        {
+            break;
+        }
+        p++;
 
-        //2. ҵdebugַ
-        memset(the_buf, 0x00, sizeof(the_buf));
-        while (fgets(the_buf, READ_BUF_SIZE, pfd))
+        //1. ע
+        if ((end - p >= 3) && !memcmp(p, "!--", 3))
         {
-            if (strstr(the_buf, "moduleId=\"org.eclipse.cdt.core.settings\" name=\"Debug\">"))
+            for (p += 3; (p + 2 < end) && memcmp(p, "-->", 3); p++)
             {
-                flag = 1;
-                break;
             }
-            memset(the_buf, 0x00, sizeof(the_buf));
+            p += 3;
+            continue;
         }
-        if (flag == 0)
+        //2. <?xml ...?> <!DOCTYPE ...>
+        if ((*p == '?') || (*p == '!'))
         {
-            break;
+            q = memchr(p, '>', end - p);
+            p = q ? q + 1 : end;
+            continue;
+        }
+
+        //3. ǩ
+        memset(ptag, 0x00, sizeof(*ptag));
+        if (*p == '/')
+        {
+            ptag->close = E_TRUE;
+            p++;
+        }
+        ptag->pname = p;
+        while ((p < end) && (*p != '>') && (*p != '/') && !isspace((int)*p))
+        {
+            p++;
         }
-        flag = 0;
+        ptag->name_len = p - ptag->pname;
 
-        //3. ҵַ
-        memset(the_buf, 0x00, sizeof(the_buf));
-        while (fgets(the_buf, READ_BUF_SIZE, pfd))
+        //4. , ֵп'>'
+        ptag->pattr = p;
+        for (quote = 0; (p < end) && (quote || (*p != '>')); p++)
         {
-            if (strstr(the_buf, pstr))
+            if (quote)
+            {
+                quote = (*p == quote) ? 0 : quote;
+            }
+            else if ((*p == '"') || (*p == '\''))
             {
-                flag = 1;
-                break;
+                quote = *p;
             }
-            memset(the_buf, 0x00, sizeof(the_buf));
         }
-        if (flag == 0)
+        ptag->attr_len = p - ptag->pattr;
+        if ((ptag->attr_len > 0) && (ptag->pattr[ptag->attr_len - 1] == '/'))
         {
-            break;
+            ptag->empty = E_TRUE;
+            ptag->attr_len--;
         }
+        pxml->p = (p < end) ? p + 1 : end;
 
-        //4. ҵ
-        ret = OK;
-    } while (0);
+        return OK;
+    }
+    pxml->p = end;
 
-    return ret;
+    return ERROR;
 }
 
 /**
  ******************************************************************************
- * @brief   ȡ-I
- * @param[in]  *pfd  : ļ
- * @param[out] *pcfg : ؽṹϢ
- *
- * @retval  OK    : ɹ
- * @retval  ERROR : ʧ
- *
- * <option id=... name="Include paths (-I)" ...
- *   <listOptionValue builtIn="false" value="&quot;${workspace_loc:/${ProjName}/app/inc}&quot;"/>
- *   <listOptionValue builtIn="false" value="&quot;${workspace_loc:/${ProjName}/bsp/inc}&quot;"/>
- *   <listOptionValue builtIn="false" value="&quot;${workspace_loc:/${ProjName}/sys/inc}&quot;"/>
- *   <listOptionValue builtIn="false" value="&quot;${workspace_loc:/${ProjName}/sys/inc/net}&quot;"/>
- * </option>
+ * @brief   жϱǩ
  ******************************************************************************
  */
-static status_t
-cproject_get_I(FILE *pfd,
-        pcfg_t *pcfg)
+static bool_e
+xml_is(const xml_tag_t *ptag,
+        const char *pname)
 {
-    char *pstr;
-    status_t ret = OK;//ERROR;
+    int len = strlen(pname);
+
+    return ((ptag->name_len == len) && !memcmp(ptag->pname, pname, len))
+            ? E_TRUE : E_FALSE;
+}
 
-    do
+/**
+ ******************************************************************************
+ * @brief   ȡǩ(ת&quot;ʵ)
+ * @param[in]  *ptag  : ǩ
+ * @param[in]  *pname : 
+ * @param[out] *pval  : ֵ
+ * @param[in]  len    : 泤
+ *
+ * @retval  E_TRUE  : ҵ
+ * @retval  E_FALSE : ûи
+ ******************************************************************************
+ */
+static bool_e
+xml_attr(const xml_tag_t *ptag,
+        const char *pname,
+        char *pval,
+        int len)
+{
+    int n;
+    int name_len = strlen(pname);
+    const char *p = ptag->pattr;
+    const char *end = ptag->pattr + ptag->attr_len;
+    const char *pkey;
+    char quote;
+
+    while (p < end)
     {
-        if (OK != file_find_str(pfd, "name=\"Include paths (-I)\""))
+        //1. 
+        while ((p < end) && isspace((int)*p))
+        {
+            p++;
+        }
+        pkey = p;
+        while ((p < end) && (*p != '=') && !isspace((int)*p))
+        {
+            p++;
+        }
+        n = p - pkey;
+        while ((p < end) && (isspace((int)*p) || (*p == '=')))
+        {
+            p++;
+        }
+        if ((p >= end) || ((*p != '"') && (*p != '\'')))
         {
             break;
         }
 
-        memset(pcfg->I, 0x00, sizeof(pcfg->I));
-        memset(the_buf, 0x00, sizeof(the_buf));
-        while (fgets(the_buf, sizeof(the_buf), pfd))
+        //2. ֵ
+        quote = *p++;
+        if ((n != name_len) || memcmp(pkey, pname, n))
         {
-            if (strstr(the_buf, "</option>"))
+            while ((p < end) && (*p != quote))
             {
-                break;
+                p++;
             }
-            pstr = strstr(the_buf, ";${workspace_loc:/${ProjName}/");
-            if (!pstr)
+            p++;
+            continue;
+        }
+        for (n = 0; (p < end) && (*p != quote) && (n < len - 1); n++)
+        {
+            if (*p != '&')
             {
-                continue; //Ҳ
+                pval[n] = *p++;
             }
-
-            pstr += STR_LEN(";${workspace_loc:/${ProjName}/");
-            if (strstr(pstr, "}&quot;"))
+            else if ((end - p >= 6) && !memcmp(p, "&quot;", 6))
+            {
+                pval[n] = '"';
+                p += 6;
+            }
+            else if ((end - p >= 6) && !memcmp(p, "&apos;", 6))
             {
-                strstr(pstr, "}&quot;")[0] = 0;
-                //ŵpcfg -I 
-                printf("ҵ-I: %s\n", pstr);
-                strcat(pcfg->I, pstr); //
-                strcat(pcfg->I, "|");
+                pval[n] = '\'';
+                p += 6;
+            }
+            else if ((end - p >= 5) && !memcmp(p, "&amp;", 5))
+            {
+                pval[n] = '&';
+                p += 5;
+            }
+            else if ((end - p >= 4) && !memcmp(p, "&lt;", 4))
+            {
+                pval[n] = '<';
+                p += 4;
+            }
+            else if ((end - p >= 4) && !memcmp(p, "&gt;", 4))
+            {
+                pval[n] = '>';
+                p += 4;
+            }
+            else
+            {
+                pval[n] = *p++;
             }
-            memset(the_buf, 0x00, sizeof(the_buf));
         }
-        ret = OK;
-    } while (0);
+        pval[n] = 0;
+        return E_TRUE;
+    }
+    if (len > 0)
+    {
+        pval[0] = 0;
+    }
 
-    return ret;
+    return E_FALSE;
 }
 
 /**
  ******************************************************************************
- * @brief   ȡ-L
- * @param[in]  *pfd  : ļ
- * @param[out] *pcfg : ؽṹϢ
- *
- * @retval  OK    : ɹ
- * @retval  ERROR : ʧ
- *
- * <option id=... name="Library search path (-L)" ...
- *   <listOptionValue builtIn="false" value="&quot;${workspace_loc:/${ProjName}/sys/lib}&quot;"/>
- *   <listOptionValue builtIn="false" value="&quot;${workspace_loc:/${ProjName}/app/meter}&quot;"/>
- * </option>
+ * @brief   ׷ַ()
  ******************************************************************************
  */
-static status_t
-cproject_get_L(FILE *pfd,
-        pcfg_t *pcfg)
+static void
+cproject_cat(char *pdst,
+        int size,
+        const char *pfmt,
+        const char *pstr)
 {
-    char *pstr;
-    status_t ret = OK;//ERROR;
+    int n = strlen(pdst);
 
-    do
+    if (n < size - 1)
     {
-        if (OK != file_find_str(pfd, "name=\"Library search path (-L)\""))
-        {
-            break;
-        }
+        snprintf(pdst + n, size - n, pfmt, pstr);
+    }
+}
 
-        memset(pcfg->L, 0x00, sizeof(pcfg->L));
-        memset(the_buf, 0x00, sizeof(the_buf));
-        while (fgets(the_buf, READ_BUF_SIZE, pfd))
-        {
-            if (strstr(the_buf, "</option>") || strstr(the_buf, "<option id"))
-            {
-                break;
-            }
-            pstr = strstr(the_buf, ";${workspace_loc:/${ProjName}/");
-            if (!pstr)
-            {
-                continue; //Ҳ
-            }
+/**
+ ******************************************************************************
+ * @brief   ȡ·
+ * @param[in]  *pval : "${workspace_loc:/${ProjName}/app/inc}"
+ *
+ * @retval  NULL  : ǹ·
+ * @retval !NULL  : app/inc
+ ******************************************************************************
+ */
+static char *
+cproject_path(char *pval)
+{
+    char *pstr = strstr(pval, "${workspace_loc:/${ProjName}/");
 
-            pstr += STR_LEN(";${workspace_loc:/${ProjName}/");
-            if (strstr(pstr, "}&quot;"))
-            {
-                strstr(pstr, "}&quot;")[0] = 0;
-                //ŵpcfg -L 
-                printf("ҵ-L: %s\n", pstr);
-                strcat(pcfg->L, pstr); //
-                strcat(pcfg->L, "|");
-            }
-            memset(the_buf, 0x00, sizeof(the_buf));
-        }
-        ret = OK;
-    } while (0);
+    if (!pstr)
+    {
+        return NULL;
+    }
+    pstr += STR_LEN("${workspace_loc:/${ProjName}/");
+    if (!strstr(pstr, "}\""))
+    {
+        return NULL;
+    }
+    strstr(pstr, "}\"")[0] = 0;
 
-    return ret;
+    return pstr;
 }
 
 /**
  ******************************************************************************
- * @brief   ȡ-l
- * @param[in]  *pfd  : ļ
- * @param[out] *pcfg : ؽṹϢ
+ * @brief   .cprojectиѡʱ, Ϊ׼, Ĭֵ
+ ******************************************************************************
+ */
+static void
+cproject_clear(cproject_opt_e opt,
+        pcfg_t *pcfg)
+{
+    switch (opt)
+    {
+    case OPT_I:
+        memset(pcfg->I, 0x00, sizeof(pcfg->I));
+        break;
+    case OPT_L:
+        memset(pcfg->L, 0x00, sizeof(pcfg->L));
+        break;
+    case OPT_l:
+        memset(pcfg->LIBS, 0x00, sizeof(pcfg->LIBS));
+        break;
+    case OPT_T:
+        strncpy(pcfg->LD, "app.ld", sizeof(pcfg->LD));
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   DebugеһlistOptionValue
+ * @param[in]  opt    : option
+ * @param[in]  *pval  : value
+ * @param[in]  builtin: builtInǷΪtrue
+ * @param[out] *pcfg  : ؽṹϢ
  *
- * @retval  OK    : ɹ
- * @retval  ERROR : ʧ
+ * @return  None
  *
+ * <option id=... name="Include paths (-I)" ...
+ *   <listOptionValue builtIn="false" value="&quot;${workspace_loc:/${ProjName}/app/inc}&quot;"/>
+ * </option>
+ * <option id=... name="Library search path (-L)" ...
+ *   <listOptionValue builtIn="false" value="&quot;${workspace_loc:/${ProjName}/sys/lib}&quot;"/>
+ * </option>
  * <option id=... name="Libraries (-l)" ...
  *   <listOptionValue builtIn="false" value="sxos"/>
- *   <listOptionValue builtIn="false" value="meter_sp5"/>
- *   <listOptionValue builtIn="false" value="m"/>
+ * </option>
+ * <option id=... name="Script files (-T)" ...
+ *   <listOptionValue builtIn="false" value="&quot;${workspace_loc:/${ProjName}/app.ld}&quot;"/>
+ * </option>
+ * <option id=... name="Defined symbols (-D)" ...
+ *   <listOptionValue builtIn="false" value="__CORE_SELECTION_=2"/>
  * </option>
  ******************************************************************************
  */
-static status_t
-cproject_get_l(FILE *pfd,
+static void
+cproject_value(cproject_opt_e opt,
+        char *pval,
+        bool_e builtin,
         pcfg_t *pcfg)
 {
     char *pstr;
-    status_t ret = OK;//ERROR;
+    int n;
 
-    do
+    switch (opt)
     {
-        if (OK != file_find_str(pfd, "name=\"Libraries (-l)\""))
+    case OPT_I:
+        if ((pstr = cproject_path(pval)) != NULL)
         {
-            break;
+            printf("ҵ-I: %s\n", pstr);
+            cproject_cat(pcfg->I, sizeof(pcfg->I), "%s|", pstr);
         }
+        break;
 
-        memset(pcfg->LIBS, 0x00, sizeof(pcfg->LIBS));
-        memset(the_buf, 0x00, sizeof(the_buf));
-        while (fgets(the_buf, READ_BUF_SIZE, pfd))
+    case OPT_L:
+        if ((pstr = cproject_path(pval)) != NULL)
         {
-            if (strstr(the_buf, "</option>") || strstr(the_buf, "<option id"))
-            {
-                break;
-            }
-            pstr = strstr(the_buf, "builtIn=\"false\" value=\"");
-            if (!pstr)
-            {
-                continue; //Ҳ
-            }
+            printf("ҵ-L: %s\n", pstr);
+            cproject_cat(pcfg->L, sizeof(pcfg->L), "%s|", pstr);
+        }
+        break;
+
+    case OPT_l:
+        if (!builtin)
+        {
+            printf("ҵ-l: %s\n", pval);
+            cproject_cat(pcfg->LIBS, sizeof(pcfg->LIBS), "-l%s ", pval);
+        }
+        break;
 
-            pstr += STR_LEN("builtIn=\"false\" value=\"");
-            if (strstr(pstr, "\"/>"))
+    case OPT_T:
+        if ((pstr = cproject_path(pval)) != NULL)
+        {
+            printf("ҵ-T: %s\n", pstr);
+            strncpy(pcfg->LD, pstr, sizeof(pcfg->LD));
+        }
+        break;
+
+    case OPT_D:
+        if (!builtin)
+        {
+            printf("ҵ-D: %s\n", pval);
+            n = strlen(pcfg->CCFLAGS);
+            if (n && (pcfg->CCFLAGS[n - 1] != ' '))
             {
-                strstr(pstr, "\"/>")[0] = 0;
-                //ŵpcfg -l 
-                printf("ҵ-l: %s\n", pstr);
-                strcat(pcfg->LIBS, "-l");
-                strcat(pcfg->LIBS, pstr); //
-                strcat(pcfg->LIBS, " ");
+                cproject_cat(pcfg->CCFLAGS, sizeof(pcfg->CCFLAGS), "%s", " ");
             }
-            memset(the_buf, 0x00, sizeof(the_buf));
+            cproject_cat(pcfg->CCFLAGS, sizeof(pcfg->CCFLAGS), "-D%s ", pval);
         }
-        ret = OK;
-    } while (0);
+        break;
 
-    return ret;
+    default:
+        break;
+    }
 }
+
 /**
  ******************************************************************************
- * @brief   ȡldflags/ld
- * @param[in]  *pfd  : ļ
- * @param[out] *pcfg : ؽṹϢ
+ * @brief   滻ccflagsеһ(-O*, -g*)
+ * @param[out] *pcfg    : ؽṹϢ
+ * @param[in]  *pprefix : ǰ׺
+ * @param[in]  *pflag   : ²(""ʾֻɾ)
  *
- * @retval  OK    : ɹ
- * @retval  ERROR : ʧ
- * --specs=nano.specs
+ * @return  None
  ******************************************************************************
  */
-static status_t
-cproject_get_ldflags(FILE *pfd,
-        pcfg_t *pcfg)
+static void
+cproject_flag_set(pcfg_t *pcfg,
+        const char *pprefix,
+        const char *pflag)
 {
-    status_t ret = OK;
+    char *p;
+    char *delim = " ";
+    char tmp[sizeof(pcfg->CCFLAGS)];
 
-    do
+    strncpy(tmp, pcfg->CCFLAGS, sizeof(tmp));
+    memset(pcfg->CCFLAGS, 0x00, sizeof(pcfg->CCFLAGS));
+    for (p = strtok(tmp, delim); p; p = strtok(NULL, delim))
     {
-        if (OK == file_find_str(pfd, "--specs=nano.specs"))
+        if (strncmp(p, pprefix, strlen(pprefix)))
         {
-            break;
+            cproject_cat(pcfg->CCFLAGS, sizeof(pcfg->CCFLAGS), "%s ", p);
         }
-        printf("--specs=nano.specs\n");
-        memset(pcfg->LDFLAGS, 0x00, sizeof(pcfg->LDFLAGS));
-    } while (0);
-
-    return ret;
+    }
+    if (pflag[0])
+    {
+        cproject_cat(pcfg->CCFLAGS, sizeof(pcfg->CCFLAGS), "%s ", pflag);
+    }
 }
 
 /**
  ******************************************************************************
- * @brief   ȡld
- * @param[in]  *pfd  : ļ
- * @param[out] *pcfg : ؽṹϢ
+ * @brief   ȡŻ/Եȼ
+ * @param[in]  *psuper : optionsuperClass
+ * @param[in]  *pval   : optionvalue
+ * @param[out] *pcfg   : ؽṹϢ
  *
- * @retval  OK    : ɹ
- * @retval  ERROR : ʧ
+ * @return  None
  *
- * <option id=... name="Script files (-T)" ...
- *   <listOptionValue builtIn="false" value="&quot;${workspace_loc:/${ProjName}/app.ld}&quot;"/>
- * </option>
+ * <option superClass="...option.optimization.level" value="...optimization.level.size" .../>
+ * <option superClass="...option.debugging.level" value="...debugging.level.max" .../>
  ******************************************************************************
  */
-static status_t
-cproject_get_ld(FILE *pfd,
+static void
+cproject_level(const char *psuper,
+        const char *pval,
         pcfg_t *pcfg)
 {
-    char *pstr;
-    status_t ret = OK;//ERROR;
-
-    do
+    int i;
+    const char *plevel = strrchr(pval, '.');
+    static const char *const opt_level[][2] =
     {
-        if (OK != file_find_str(pfd, "name=\"Script files (-T)\""))
-        {
-            break;
-        }
+        {"none", "-O0"}, {"optimize", "-O1"}, {"more", "-O2"},
+        {"most", "-O3"}, {"size", "-Os"}, {"debug", "-Og"},
+    };
+    static const char *const g_level[][2] =
+    {
+        {"none", ""}, {"minimal", "-g1"}, {"default", "-g"}, {"max", "-g3"},
+    };
 
-        strncpy(pcfg->LD, "app.ld", sizeof(pcfg->LD));
-        memset(the_buf, 0x00, sizeof(the_buf));
-        while (fgets(the_buf, READ_BUF_SIZE, pfd))
+    if (!plevel)
+    {
+        return;
+    }
+    plevel++;
+    if (strstr(psuper, "optimization.level"))
+    {
+        for (i = 0; i < (int)ARRAY_SIZE(opt_level); i++)
         {
-            pstr = strstr(the_buf, ";${workspace_loc:/${ProjName}/");
-            if (!pstr)
+            if (!strcmp(plevel, opt_level[i][0]))
             {
-                break; //Ҳ
+                printf("ҵŻȼ: %s\n", opt_level[i][1]);
+                cproject_flag_set(pcfg, "-O", opt_level[i][1]);
             }
-
-            pstr += STR_LEN(";${workspace_loc:/${ProjName}/");
-            if (strstr(pstr, "}&quot;"))
+        }
+    }
+    else if (strstr(psuper, "debugging.level"))
+    {
+        for (i = 0; i < (int)ARRAY_SIZE(g_level); i++)
+        {
+            if (!strcmp(plevel, g_level[i][0]))
             {
-                strstr(pstr, "}&quot;")[0] = 0;
-                //ŵpcfg -T 
-                printf("ҵ-T: %s\n", pstr);
-                strncpy(pcfg->LD, pstr, sizeof(pcfg->LD));
+                printf("ҵĵԵȼ: %s\n", g_level[i][1]);
+                cproject_flag_set(pcfg, "-g", g_level[i][1]);
             }
-            memset(the_buf, 0x00, sizeof(the_buf));
         }
-        ret = OK;
-    } while (0);
-
-    return ret;
+    }
 }
-//warnings.toerrors" useByScannerDiscovery="true" value="true" valueType="boolean"/>
 
 /**
  ******************************************************************************
- * @brief   ȡccflags
- * @param[in]  *pfd  : ļ
- * @param[out] *pcfg : ؽṹϢ
- *
- * @retval  OK    : ɹ
- * @retval  ERROR : ʧ
- *
- * warnings.toerrors" useByScannerDiscovery="true" value="true" valueType="boolean"/>
+ * @brief   һý, ûҵѡ
  ******************************************************************************
  */
-static status_t
-cproject_get_ccflags(FILE *pfd,
-        pcfg_t *pcfg)
+static void
+cproject_finish(pcfg_t *pcfg,
+        bool_e nano,
+        bool_e werror)
 {
-    status_t ret = OK;
-
-    do
+    if (!nano)
+    {
+        printf("--specs=nano.specs\n");
+        memset(pcfg->LDFLAGS, 0x00, sizeof(pcfg->LDFLAGS));
+    }
+    if (!werror)
     {
-        if (OK == file_find_str(pfd, "warnings.toerrors\" useByScannerDiscovery=\"true\" value=\"true\" valueType=\"boolean\"/>"))
-        {
-            break;
-        }
         printf("-Werror\n");
-        if (strstr(pcfg->CCFLAGS, "-Werror"))
-        {
-            strstr(pcfg->CCFLAGS, "-Werror")[0] = 0;
-        }
-    } while (0);
-
-    return ret;
+        cproject_flag_set(pcfg, "-Werror", ""); //ܻ-O/-g/-D
+    }
 }
 
 /**
  ******************************************************************************
- * @brief   ȡ-D
- * @param[in]  *pfd  : ļ
- * @param[out] *pcfg : ؽṹϢ
+ * @brief   һα.cproject, ȡȫ(Debug/Release...)Ĳ
+ * @param[in]  *pbuf  : ļ
+ * @param[in]  len    : ļ
+ * @param[out] *pcfgs : ظ
+ * @param[in]  max    : ȡ
  *
- * @retval  OK    : ɹ
- * @retval  ERROR : ʧ
+ * @return  
  *
- * <option id=... name="Defined symbols (-D)" ...
- *   <listOptionValue builtIn="false" value="__CORE_SELECTION_=2"/>
- * </option>
+ * @note    ÿcconfigurationmoduleId="org.eclipse.cdt.core.settings"
+ *          storageModulenameΪ, optionֻȡһγֵ;
+ *          -WerrorsuperClasswarnings.toerrorsβvalue="true"option,
+ *          EXCLUDEȡ<sourceEntries>е<entry excluding="sys/test|bsp/test" ...
  ******************************************************************************
  */
-static status_t
-cproject_get_D(FILE *pfd,
-        pcfg_t *pcfg)
+static int
+cproject_parse(const char *pbuf,
+        uint32 len,
+        pcfg_t *pcfgs,
+        int max)
 {
-    char *pstr;
-    status_t ret = OK;//ERROR;
-
-    do
+    int i;
+    int num = 0;
+    xml_t xml;
+    xml_tag_t tag;
+    bool_e in_cfg = E_FALSE;
+    bool_e sources = E_FALSE;
+    bool_e nano = E_FALSE;
+    bool_e werror = E_FALSE;
+    bool_e seen[OPT_NUM];
+    cproject_opt_e opt = OPT_NONE;
+    pcfg_t *pcfg = NULL;
+    char val[READ_BUF_SIZE];
+    char super[READ_BUF_SIZE];
+    char builtin[8];
+
+    xml.p = pbuf;
+    xml.end = pbuf + len;
+    while (OK == xml_next(&xml, &tag))
     {
-        if (OK != file_find_str(pfd, "name=\"Defined symbols (-D)\""))
+        //1. ÿʼ/
+        if (xml_is(&tag, "cconfiguration"))
         {
-            break;
+            if (pcfg)
+            {
+                cproject_finish(pcfg, nano, werror);
+                pcfg = NULL;
+                num++;
+            }
+            in_cfg = tag.close ? E_FALSE : E_TRUE;
+            memset(seen, 0x00, sizeof(seen));
+            sources = E_FALSE;
+            nano = E_FALSE;
+            werror = E_FALSE;
+            opt = OPT_NONE;
+            continue;
+        }
+        if (!pcfg)
+        {
+            if (in_cfg && (num < max) && !tag.close && xml_is(&tag, "storageModule")
+                    && xml_attr(&tag, "moduleId", val, sizeof(val))
+                    && !strcmp(val, "org.eclipse.cdt.core.settings")
+                    && xml_attr(&tag, "name", val, sizeof(val)))
+            {
+                pcfg = &pcfgs[num];
+                cproject_get_default(pcfg);
+                strncpy(pcfg->NAME, val, sizeof(pcfg->NAME) - 1);
+                printf(": %s\n", pcfg->NAME);
+            }
+            continue;
         }
 
-        memset(the_buf, 0x00, sizeof(the_buf));
-        while (fgets(the_buf, sizeof(the_buf), pfd))
+        //2. option
+        if (xml_is(&tag, "option"))
         {
-            if (strstr(the_buf, "</option>") || strstr(the_buf, "<option id"))
+            opt = OPT_NONE;
+            if (tag.close)
+            {
+                continue;
+            }
+            if (xml_attr(&tag, "value", val, sizeof(val)) && strstr(val, "--specs=nano.specs"))
             {
-                break;
+                nano = E_TRUE;
             }
-            pstr = strstr(the_buf, "listOptionValue builtIn=\"false\" value=\"");
-            if (!pstr)
+            if (xml_attr(&tag, "superClass", super, sizeof(super)))
             {
-                continue; //Ҳ
+                if ((strlen(super) >= STR_LEN("warnings.toerrors"))
+                        && !strcmp(super + strlen(super) - STR_LEN("warnings.toerrors"), "warnings.toerrors")
+                        && !strcmp(val, "true"))
+                {
+                    werror = E_TRUE;
+                }
+                cproject_level(super, val, pcfg);
             }
+            if (!tag.empty && xml_attr(&tag, "name", val, sizeof(val)))
+            {
+                for (i = OPT_NONE + 1; i < OPT_NUM; i++)
+                {
+                    if (!seen[i] && !strcmp(val, the_opt_name[i]))
+                    {
+                        seen[i] = E_TRUE;
+                        opt = (cproject_opt_e)i;
+                        cproject_clear(opt, pcfg);
+                        break;
+                    }
+                }
+            }
+            continue;
+        }
+        if (!tag.close && (opt != OPT_NONE) && xml_is(&tag, "listOptionValue"))
+        {
+            if (xml_attr(&tag, "value", val, sizeof(val)))
+            {
+                xml_attr(&tag, "builtIn", builtin, sizeof(builtin));
+                cproject_value(opt, val, strcmp(builtin, "true") ? E_FALSE : E_TRUE, pcfg);
+            }
+            continue;
+        }
 
-            pstr += STR_LEN("listOptionValue builtIn=\"false\" value=\"");
-            if (strstr(pstr, "\"/>"))
+        //3. ·
+        if (xml_is(&tag, "sourceEntries"))
+        {
+            sources = tag.close ? E_FALSE : E_TRUE;
+            if (sources && !seen[OPT_NONE])
             {
-                strstr(pstr, "\"/>")[0] = 0;
-                //ŵpcfg -D 
-                printf("ҵ-D: %s\n", pstr);
-                strcat(pcfg->CCFLAGS, "-D"); //
-                strcat(pcfg->CCFLAGS, pstr); //
-                strcat(pcfg->CCFLAGS, " ");
+                seen[OPT_NONE] = E_TRUE; //OPT_NONEҵ<sourceEntries>
+                memset(pcfg->EXCLUDE, 0x00, sizeof(pcfg->EXCLUDE));
             }
-            memset(the_buf, 0x00, sizeof(the_buf));
+            continue;
+        }
+        if (sources && !tag.close && xml_is(&tag, "entry")
+                && xml_attr(&tag, "excluding", val, sizeof(val)))
+        {
+            printf("ҵexcludeing: %s\n", val);
+            strncpy(pcfg->EXCLUDE, val, sizeof(pcfg->EXCLUDE));
         }
-        ret = OK;
-    } while (0);
+    }
+    if (pcfg)
+    {
+        cproject_finish(pcfg, nano, werror);
+        num++;
+    }
 
-    return ret;
+    return num;
 }
 
 /**
  ******************************************************************************
- * @brief   ȡexlude
- * @param[in]  *pfd  : ļ
- * @param[out] *pcfg : ؽṹϢ
+ * @brief   ȡ.cprojectеȫ
+ * @param[out] *pcfgs : ظ, NAMEΪ
+ * @param[in]  max    : ȡ
  *
- * @retval  OK    : ɹ
- * @retval  ERROR : ʧ
+ * @retval  -1 : û.cproject
+ * @retval >=0 : 
  *
- * <sourceEntries>
- *   <entry excluding="sys/test|bsp/test|app/dstor/test" .....
- * </sourceEntries>
+ * @note    ļӳ䵽ڴֻһ
  ******************************************************************************
  */
-static status_t
-cproject_get_exlude(FILE *pfd,
-        pcfg_t *pcfg)
+int
+cproject_cfg_get_all(pcfg_t *pcfgs,
+        int max)
 {
-    char *pstr;
-    status_t ret = OK;//ERROR;
+    int num;
+    uint32 len;
+    const char *pbuf;
 
-    do
+    pbuf = os_fmap(FILENAME, &len);
+    if (!pbuf)
     {
-        if (OK != file_find_str(pfd, "<sourceEntries>"))
-        {
-            break;
-        }
-
-        memset(pcfg->EXCLUDE, 0x00, sizeof(pcfg->EXCLUDE));
-        memset(the_buf, 0x00, sizeof(the_buf));
-        while (fgets(the_buf, READ_BUF_SIZE, pfd))
-        {
-            pstr = strstr(the_buf, "<entry excluding=\"");
-            if (!pstr)
-            {
-                break; //Ҳ
-            }
-
-            pstr += STR_LEN("<entry excluding=\"");
-            if (strstr(pstr, "\""))
-            {
-                strstr(pstr, "\"")[0] = 0;
-                //ŵpcfg -exclude 
-                printf("ҵexcludeing: %s\n", pstr);
-                strncpy(pcfg->EXCLUDE, pstr, sizeof(pcfg->EXCLUDE));
-            }
-            memset(the_buf, 0x00, sizeof(the_buf));
-        }
-        ret = OK;
-    } while (0);
+        return -1;
+    }
+    num = cproject_parse(pbuf, len, pcfgs, max);
+    os_funmap(pbuf);
 
-    return ret;
+    return num;
 }
 
 /**
  ******************************************************************************
- * @brief   Իȡ.cprojectpcfg_tṹ
+ * @brief   Իȡ.cprojectpcfg_tṹ(Debug)
  * @param[out] *pcfg : ؽṹϢ
  *
  * @retval  OK    : ɹ
@@ -590,61 +819,29 @@ cproject_get_exlude(FILE *pfd,
 status_t
 cproject_cfg_get(pcfg_t *pcfg)
 {
-    status_t ret = ERROR;
-    FILE *pfd = NULL;
+    int i;
+    int num;
+    static pcfg_t cfgs[CPROJECT_MAX_CFGS];
 
-    do
+    num = cproject_cfg_get_all(cfgs, ARRAY_SIZE(cfgs));
+    if (num < 0)
     {
-        pfd = fopen(FILENAME, "r");
-        if (!pfd)
-        {
-            break;
-        }
-        if (OK != cproject_get_default(pcfg))
-        {
-            break;
-        }
-        if (OK != cproject_get_I(pfd, pcfg))
-        {
-            break;
-        }
-        if (OK != cproject_get_L(pfd, pcfg))
-        {
-            break;
-        }
-        if (OK != cproject_get_l(pfd, pcfg))
-        {
-            break;
-        }
-        if (OK != cproject_get_ldflags(pfd, pcfg))
-        {
-            break;
-        }
-        if (OK != cproject_get_ld(pfd, pcfg))
-        {
-            break;
-        }
-        if (OK != cproject_get_exlude(pfd, pcfg))
-        {
-            break;
-        }
-        if (OK != cproject_get_ccflags(pfd, pcfg))
-        {
-            break;
-        }
-        if (OK != cproject_get_D(pfd, pcfg))
-        {
-            break;
-        }
-        ret = OK;
-    } while (0);
-
-    if (pfd)
+        return ERROR;
+    }
+    for (i = 0; (i < num) && strcmp(cfgs[i].NAME, "Debug"); i++)
     {
-        fclose(pfd);
+    }
+    if (i < num)
+    {
+        memcpy(pcfg, &cfgs[i], sizeof(*pcfg));
+    }
+    else
+    {
+        cproject_get_default(pcfg);
+        cproject_finish(pcfg, E_FALSE, E_FALSE);
     }
 
-    return ret;
+    return OK;
 }
 
 
@@ -0,0 +1,486 @@
+/**
+ ******************************************************************************
+ * @file      deadsrc.c
+ * @brief     --gc-sectionsĽҳԹ̼ûй׵Դļ
+ * @details   This file including all API functions's implement of deadsrc.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "types.h"
+#include "maths.h"
+#include "param.h"
+#include "os.h"
+#include "hash.h"
+#include "deadsrc.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** ӵĿļ */
+typedef struct
+{
+    char *pname;                /**< ԱĿ¼, ./app/foo.o */
+    char *psrc;                 /**< Դļ(ԴĿ¼), NULLΪԴ */
+    uint32 kept;                /**< Ӻֽ */
+    int removed;                /**< --gc-sectionsĶ */
+} obj_t;
+
+/** : ƾidx, pobj֮һһӦ */
+typedef struct
+{
+    obj_t *pobj;
+    int num;
+    int max;
+    hash_idx_t idx;
+} obj_tab_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+#define DEADSRC_REPORT      "deadsrc.txt"   /**< EXCLUDE */
+
+/** ·С */
+#define PATH_BUF_SIZE       (512u)
+
+/** ļС */
+#define READ_BUF_SIZE       (1024u)
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static obj_tab_t the_objs;
+
+/** ռ̼ռĶ(Ϣ, ǰ׺Ƚ) */
+static const char *const the_noalloc[] =
+{
+    ".comment", ".debug", ".ARM.attributes", ".note", ".stab", ".gnu.attributes", ".line",
+};
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   Ŀļ
+ * @param[in]  *pname : ļ
+ * @param[in]  create : ʱǷ½
+ *
+ * @retval  NULL : 
+ * @retval  NULL   : ڻڴ治
+ ******************************************************************************
+ */
+static obj_t *
+obj_find(const char *pname,
+        bool_e create)
+{
+    int i;
+    obj_t *pobj;
+    obj_tab_t *pt = &the_objs;
+
+    //1. ȱ֤pobjпλ, һžͱжӦ
+    if ((E_TRUE == create) && (pt->num == pt->max))
+    {
+        i = pt->max ? pt->max * 2 : 256;
+        pobj = realloc(pt->pobj, i * sizeof(obj_t));
+        if (!pobj)
+        {
+            return NULL;
+        }
+        pt->pobj = pobj;
+        pt->max = i;
+    }
+
+    //2. , ʼ
+    i = hash_idx_find(&pt->idx, pname, create);
+    if (i < 0)
+    {
+        return NULL;
+    }
+    pobj = &pt->pobj[i];
+    if (i == pt->num)
+    {
+        memset(pobj, 0x00, sizeof(*pobj));
+        pobj->pname = pt->idx.pstr[i];
+        pt->num++;
+    }
+
+    return pobj;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ͷĿļ
+ ******************************************************************************
+ */
+static void
+obj_free(void)
+{
+    int i;
+
+    for (i = 0; i < the_objs.num; i++)
+    {
+        free(the_objs.pobj[i].psrc);
+    }
+    hash_idx_free(&the_objs.idx);
+    free(the_objs.pobj);
+    memset(&the_objs, 0x00, sizeof(the_objs));
+}
+
+/**
+ ******************************************************************************
+ * @brief   mapļ: LOADеõӵĿļ, ۼƱֽ
+ * @param[in]  *pmap : mapļ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note    Ϊ" .text.foo  0x08000100  0x34 ./app/foo.o", ʱ
+ *          ַһ. ֻͳƱĿ¼еĿļ(./../ͷ)
+ *          ռ̼ռĶ
+ ******************************************************************************
+ */
+static status_t
+deadsrc_map_load(const char *pmap)
+{
+    int n;
+    bool_e body = E_FALSE;
+    unsigned long addr;
+    unsigned long size;
+    uint32 i;
+    char line[READ_BUF_SIZE];
+    char file[READ_BUF_SIZE];
+    char name[128];
+    char sec[sizeof(name)] = "";
+    obj_t *pobj;
+    FILE *pfd;
+
+    pfd = fopen(pmap, "r");
+    if (!pfd)
+    {
+        return ERROR;
+    }
+    while (fgets(line, sizeof(line), pfd))
+    {
+        //ڴӳ֮ǰ, ʽͬ, ܼ
+        if (!body)
+        {
+            body = !strncmp(line, "Linker script and memory map", 28) ? E_TRUE : E_FALSE;
+            continue;
+        }
+        if (!strncmp(line, "LOAD ", 5))
+        {
+            if ((sscanf(line + 5, "%1023s", file) == 1) && (file[0] == '.')
+                    && (NULL == obj_find(file, E_TRUE)))
+            {
+                fclose(pfd);
+                return ERROR;
+            }
+            continue;
+        }
+
+        //ͬһ, Ҳһ
+        n = sscanf(line, " %127s 0x%lx 0x%lx %1023s", name, &addr, &size, file);
+        if (((n == 1) || (n == 4)) && (name[0] == '.'))
+        {
+            strcpy(sec, name);
+        }
+        else
+        {
+            n = sscanf(line, " 0x%lx 0x%lx %1023s", &addr, &size, file) + 1;
+        }
+        if ((n != 4) || (file[0] != '.'))
+        {
+            continue;
+        }
+
+        for (i = 0; (i < ARRAY_SIZE(the_noalloc))
+                && strncmp(sec, the_noalloc[i], strlen(the_noalloc[i])); i++)
+        {
+        }
+        if (i == ARRAY_SIZE(the_noalloc))
+        {
+            pobj = obj_find(file, E_FALSE);
+            if (pobj)
+            {
+                pobj->kept += size;
+            }
+        }
+    }
+    fclose(pfd);
+
+    return the_objs.num ? OK : ERROR;
+}
+
+/**
+ ******************************************************************************
+ * @brief   --print-gc-sections, ۼƸĿļĶ
+ * @param[in]  *pgc : 
+ *
+ * @return  None
+ *
+ * @note    ld: removing unused section '.text.foo' in file './app/foo.o'
+ ******************************************************************************
+ */
+static void
+deadsrc_gc_load(const char *pgc)
+{
+    char *p;
+    char *q;
+    char line[READ_BUF_SIZE];
+    obj_t *pobj;
+    FILE *pfd;
+
+    pfd = fopen(pgc, "r");
+    if (!pfd)
+    {
+        return;
+    }
+    while (fgets(line, sizeof(line), pfd))
+    {
+        p = strstr(line, "removing unused section");
+        p = p ? strstr(p, " in file '") : NULL;
+        q = p ? strchr(p + 10, '\'') : NULL;
+        if (!q)
+        {
+            continue;
+        }
+        *q = 0;
+        pobj = obj_find(p + 10, E_FALSE);
+        if (pobj)
+        {
+            pobj->removed++;
+        }
+    }
+    fclose(pfd);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ĿļҵԴļ(ԴĿ¼)
+ * @param[in]  *pcfg : 
+ * @param[in]  *pobj : Ŀļ, ./app/foo.oõ../_BUILD_Debug/app/foo.o
+ * @param[out] *psrc : Դļ
+ * @param[in]  len   : 泤
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : Դеļ(Զɵĸٴ)
+ ******************************************************************************
+ */
+static status_t
+deadsrc_src_get(const make_cfg_t *pcfg,
+        const char *pobj,
+        char *psrc,
+        int len)
+{
+    int n;
+    char tmp[PATH_BUF_SIZE];
+    struct _stat buf;
+    const char *pext[] = {"c", "S"};
+    uint32 i;
+
+    if (!strncmp(pobj, "./", 2))
+    {
+        pobj += 2;
+    }
+    else if (!strncmp(pobj, "../", 3) && strchr(pobj + 3, '/'))
+    {
+        pobj = strchr(pobj + 3, '/') + 1;
+    }
+    n = strlen(pobj);
+    if ((n < 3) || strcmp(pobj + n - 2, ".o"))
+    {
+        return ERROR;
+    }
+
+    for (i = 0; i < ARRAY_SIZE(pext); i++)
+    {
+        snprintf(psrc, len, "%.*s.%s", n - 2, pobj, pext[i]);
+        snprintf(tmp, sizeof(tmp), "%s/../%s", pcfg->BUILD_DIR, psrc);
+        if (!_stat(tmp, &buf))
+        {
+            return OK;
+        }
+    }
+    return ERROR;
+}
+
+/**
+ ******************************************************************************
+ * @brief   Ŀ¼(Ŀ¼)вӵԴļǷȫ
+ * @param[in]  *pdir : Ŀ¼(ԴĿ¼, 0β)
+ * @param[in]  len   : Ŀ¼(β'/')
+ ******************************************************************************
+ */
+static bool_e
+deadsrc_dir_dead(const char *pdir,
+        int len)
+{
+    int i;
+    const obj_t *pobj;
+
+    for (i = 0; i < the_objs.num; i++)
+    {
+        pobj = &the_objs.pobj[i];
+        if (pobj->psrc && pobj->kept && !strncmp(pobj->psrc, pdir, len)
+                && (pobj->psrc[len] == '/'))
+        {
+            return E_FALSE;
+        }
+    }
+    return E_TRUE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ҳжζ--gc-sectionsԴļ
+ * @param[in]  *pcfg : 
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note    1. make gc-sections.txtʽһ(gc.elf),
+ *             ͬʱ--print-gc-sectionsgc.map
+ *          2. Ŀļgc.mapбֽΪ0Ϊ. Դļÿ
+ *             붼Ҫʱ, EXCLUDE
+ *          3. ֻԵǰЧ, û-DõЩļ
+ *          4. Ա(-ar, PREBUILT_DIRS)-ltoʱmapûаĿļĶ, ܷ
+ *          5. Ŀ¼(Ŀ¼)еԴļʱųĿ¼, 鳬EXCLUDE
+ *             ĳʱʾ
+ ******************************************************************************
+ */
+status_t
+deadsrc_run(const make_cfg_t *pcfg)
+{
+    int i;
+    int cnt = 0;
+    int j;
+    int k;
+    int n;
+    int total = 0;
+    char *argv[5];
+    char tmp[PATH_BUF_SIZE];
+    char src[PATH_BUF_SIZE];
+    const char *psep;
+    const char *p;
+    obj_t *pobj;
+    hash_idx_t done = {NULL, 0, 0, NULL, 0};
+    FILE *preport;
+    status_t ret = ERROR;
+
+    //1. ӲгĶ
+    snprintf(tmp, sizeof(tmp), "%s/%s", pcfg->BUILD_DIR, DEADSRC_GC);
+    remove(tmp);
+    argv[0] = (char *)pcfg->MAKE;
+    argv[1] = "-C";
+    argv[2] = (char *)pcfg->BUILD_DIR;
+    argv[3] = DEADSRC_GC;
+    argv[4] = NULL;
+    if (os_run(argv, NULL, NULL))
+    {
+        printf("ʧ: %s\n", tmp);
+        return ERROR;
+    }
+
+    do
+    {
+        //2. ͳƸĿļĶ
+        snprintf(tmp, sizeof(tmp), "%s/%s", pcfg->BUILD_DIR, DEADSRC_MAP);
+        if (OK != deadsrc_map_load(tmp))
+        {
+            printf("޷: %s\n", tmp);
+            break;
+        }
+        snprintf(tmp, sizeof(tmp), "%s/%s", pcfg->BUILD_DIR, DEADSRC_GC);
+        deadsrc_gc_load(tmp);
+
+        //3. õԴļEXCLUDE
+        snprintf(tmp, sizeof(tmp), "%s/%s", pcfg->BUILD_DIR, DEADSRC_REPORT);
+        preport = fopen(tmp, "w");
+        if (!preport)
+        {
+            break;
+        }
+        fprintf(preport, "#source\tremoved_sections\n");
+        printf("%-60s %8s\n", "Թ̼ûй׵Դļ", "");
+        for (i = 0; i < the_objs.num; i++)
+        {
+            pobj = &the_objs.pobj[i];
+            if (OK != deadsrc_src_get(pcfg, pobj->pname, src, sizeof(src)))
+            {
+                continue;
+            }
+            pobj->psrc = strdup(src);
+            total++;
+            if (pobj->kept)
+            {
+                continue;
+            }
+            printf("%-60s %8d\n", src, pobj->removed);
+            fprintf(preport, "%s\t%d\n", src, pobj->removed);
+            cnt++;
+        }
+
+        fprintf(preport, "\n#EXCLUDE\nEXCLUDE            = %s", pcfg->EXCLUDE);
+        psep = pcfg->EXCLUDE[0] ? "|" : "";
+        n = strlen(pcfg->EXCLUDE);
+        for (i = 0; i < the_objs.num; i++)
+        {
+            pobj = &the_objs.pobj[i];
+            if (pobj->kept || !pobj->psrc)
+            {
+                continue;
+            }
+            //ϲĿ¼, ûΪļ
+            for (p = strchr(pobj->psrc, '/'); p && (E_TRUE != deadsrc_dir_dead(pobj->psrc, p - pobj->psrc));
+                    p = strchr(p + 1, '/'))
+            {
+            }
+            snprintf(src, sizeof(src), "%.*s", p ? (int)(p - pobj->psrc) : (int)strlen(pobj->psrc), pobj->psrc);
+            k = done.num;
+            j = hash_idx_find(&done, src, E_TRUE);
+            if ((j >= 0) && (j < k))
+            {
+                continue; //ͬһĿ¼д
+            }
+            n += fprintf(preport, "%s%s", psep, src);
+            psep = "|";
+        }
+        fprintf(preport, "\n");
+        if (n >= (int)sizeof(pcfg->EXCLUDE))
+        {
+            fprintf(preport, "#EXCLUDEĳ(%dַ), ΪųϼĿ¼\n",
+                    (int)sizeof(pcfg->EXCLUDE) - 1);
+            printf("EXCLUDE%dַ, (%dַ), ΪųϼĿ¼!\n",
+                    n, (int)sizeof(pcfg->EXCLUDE) - 1);
+        }
+        fclose(preport);
+        hash_idx_free(&done);
+
+        printf("\n%d/%dԴļĶȫ, EXCLUDE: %s\n", cnt, total, tmp);
+        ret = OK;
+    } while (0);
+    obj_free();
+
+    return ret;
+}
+
+/*---------------------------------deadsrc.c---------------------------------*/
@@ -0,0 +1,49 @@
+/**
+ ******************************************************************************
+ * @file       deadsrc.h
+ * @brief      API include file of deadsrc.h.
+ * @details    This file including all API functions's declare of deadsrc.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef DEADSRC_H_
+#define DEADSRC_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include "types.h"
+#include "param.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#define DEADSRC_GC          "gc-sections.txt"   /**< --print-gc-sections(makeĿ) */
+#define DEADSRC_MAP         "gc.map"
+#define DEADSRC_ELF         "gc.elf"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern status_t
+deadsrc_run(const make_cfg_t *pcfg);
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* DEADSRC_H_ */
+/*-----------------------------End of deadsrc.h------------------------------*/
@@ -0,0 +1,631 @@
+/**
+ ******************************************************************************
+ * @file      delta.c
+ * @brief     ɲο̼¹̼ɲ, ϻԭ֤
+ * @details   This file including all API functions's implement of delta.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "maths.h"
+#include "os.h"
+#include "hash.h"
+#include "delta.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** ְͷ(С) */
+typedef struct
+{
+    char magic[4];              /**< DELTA_MAGIC */
+    uint8 old_len[4];           /**< ο̼ */
+    uint8 new_len[4];           /**< ¹̼ */
+    uint8 old_hash[8];          /**< ο̼ϣ, ԭǰ˶ */
+    uint8 new_hash[8];          /**< ¹̼ϣ, ԭ˶ */
+} delta_head_t;
+
+/**  */
+typedef struct
+{
+    uint8 *pbuf;
+    uint32 len;
+    uint32 max;
+} out_buf_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+#define DELTA_MAGIC         "AMD1"
+
+/** ̵ĸƳ, ̵İԭ */
+#define MIN_MATCH           (8u)
+
+/** ϣȽϵĺѡλ */
+#define MAX_CHAIN           (64)
+
+#define HASH_BITS           (18u)
+#define HASH_SIZE           (1u << HASH_BITS)
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   MIN_MATCHֽڵĹϣ
+ ******************************************************************************
+ */
+static uint32
+delta_hash(const uint8 *p)
+{
+    uint64 v;
+
+    memcpy(&v, p, sizeof(v));
+    return (uint32)((v * 0x9E3779B97F4A7C15ull) >> (64 - HASH_BITS));
+}
+
+/**
+ ******************************************************************************
+ * @brief   С˶д
+ ******************************************************************************
+ */
+static void
+put_le(uint8 *p,
+        uint64 v,
+        int n)
+{
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        p[i] = (uint8)(v >> (i * 8));
+    }
+}
+
+static uint64
+get_le(const uint8 *p,
+        int n)
+{
+    int i;
+    uint64 v = 0;
+
+    for (i = n - 1; i >= 0; i--)
+    {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ׷ӵ
+ * @param[in]  *pout : 
+ * @param[in]  *pdata : 
+ * @param[in]  len   : 
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ڴ治
+ ******************************************************************************
+ */
+static status_t
+out_put(out_buf_t *pout,
+        const void *pdata,
+        uint32 len)
+{
+    uint8 *pnew;
+    uint32 max;
+
+    if (pout->len + len > pout->max)
+    {
+        max = MAX(pout->max * 2, pout->len + len + 4096);
+        pnew = realloc(pout->pbuf, max);
+        if (!pnew)
+        {
+            return ERROR;
+        }
+        pout->pbuf = pnew;
+        pout->max = max;
+    }
+    memcpy(pout->pbuf + pout->len, pdata, len);
+    pout->len += len;
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   䳤(ÿֽ7λ, λΪ1ʾкֽ)
+ ******************************************************************************
+ */
+static status_t
+out_varint(out_buf_t *pout,
+        uint64 v)
+{
+    uint8 buf[10];
+    uint32 n = 0;
+
+    do
+    {
+        buf[n] = (uint8)(v & 0x7f);
+        v >>= 7;
+        if (v)
+        {
+            buf[n] |= 0x80;
+        }
+        n++;
+    } while (v);
+
+    return out_put(pout, buf, n);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȡ䳤
+ * @param[in]  **pp  : ȡλ, 
+ * @param[in]  *pend : λ
+ * @param[out] *pv   : ֵ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ְ
+ ******************************************************************************
+ */
+static status_t
+get_varint(const uint8 **pp,
+        const uint8 *pend,
+        uint64 *pv)
+{
+    int shift;
+    const uint8 *p = *pp;
+
+    *pv = 0;
+    for (shift = 0; (p < pend) && (shift < 64); shift += 7)
+    {
+        *pv |= (uint64)(*p & 0x7f) << shift;
+        if (!(*p++ & 0x80))
+        {
+            *pp = p;
+            return OK;
+        }
+    }
+    return ERROR;
+}
+
+/**
+ ******************************************************************************
+ * @brief   һָ: ԭݻӲο̼
+ * @param[in]  *pout : 
+ * @param[in]  *plit : ԭ, NULLʱΪ
+ * @param[in]  len   : 
+ * @param[in]  off   : ʱڲο̼еλ
+ * @param[in]  *plast : һθƽλ, ƫ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ڴ治
+ *
+ * @note    ָΪvarint(len << 1 | ), ƺvarint(zigzag(off - last)).
+ *          ɾ, ĸƴһ, ƫֻռ1ֽ
+ ******************************************************************************
+ */
+static status_t
+out_op(out_buf_t *pout,
+        const uint8 *plit,
+        uint32 len,
+        uint32 off,
+        uint32 *plast)
+{
+    int64 d;
+
+    if (!len)
+    {
+        return OK;
+    }
+    if (OK != out_varint(pout, ((uint64)len << 1) | (plit ? 0 : 1)))
+    {
+        return ERROR;
+    }
+    if (plit)
+    {
+        return out_put(pout, plit, len);
+    }
+    d = (int64)off - (int64)*plast;
+    *plast = off + len;
+
+    return out_varint(pout, ((uint64)d << 1) ^ (uint64)(d >> 63));
+}
+
+/**
+ ******************************************************************************
+ * @brief   ɲ
+ * @param[in]  *pold  : ο̼
+ * @param[in]  olen   : ο̼
+ * @param[in]  *pnew  : ¹̼
+ * @param[in]  nlen   : ¹̼
+ * @param[out] *pout  : ְ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ڴ治
+ *
+ * @note    ο̼ÿλðMIN_MATCHֽڽϣ, ¹̼ͷ̰ƥ:
+ *          ԽһθƵλ, عϣ(ͬȡһν),
+ *          ǰԵƥԭ. 1MB̼Լʮms
+ ******************************************************************************
+ */
+static status_t
+delta_diff(const uint8 *pold,
+        uint32 olen,
+        const uint8 *pnew,
+        uint32 nlen,
+        out_buf_t *pout)
+{
+    int chain;
+    int32 cand;
+    int32 *phead;
+    int32 *pprev = NULL;
+    uint32 i;
+    uint32 n;
+    uint32 k;
+    uint32 lit = 0;
+    uint32 last = 0;
+    uint32 best;
+    uint32 best_off = 0;
+    uint32 dist;
+    uint32 best_dist;
+    status_t ret = ERROR;
+
+    phead = malloc(HASH_SIZE * sizeof(int32));
+    if (olen >= MIN_MATCH)
+    {
+        pprev = malloc(olen * sizeof(int32));
+    }
+    do
+    {
+        if (!phead || ((olen >= MIN_MATCH) && !pprev))
+        {
+            break;
+        }
+
+        //1. ο̼ϣ(ͬһϣӺǰ)
+        memset(phead, 0xff, HASH_SIZE * sizeof(int32));
+        for (i = 0; i + MIN_MATCH <= olen; i++)
+        {
+            k = delta_hash(pold + i);
+            pprev[i] = phead[k];
+            phead[k] = (int32)i;
+        }
+
+        //2. ¹̼̰ƥ
+        for (i = 0; i < nlen; )
+        {
+            best = 0;
+            best_dist = 0;
+            if (i + MIN_MATCH <= nlen)
+            {
+                //2.1 һθ
+                if (last < olen)
+                {
+                    for (n = 0; (last + n < olen) && (i + n < nlen) && (pold[last + n] == pnew[i + n]); n++)
+                    {
+                    }
+                    best = n;
+                    best_off = last;
+                }
+
+                //2.2 ϣ
+                cand = phead[delta_hash(pnew + i)];
+                for (chain = 0; (cand >= 0) && (chain < MAX_CHAIN); cand = pprev[cand], chain++)
+                {
+                    k = (uint32)cand;
+                    if ((k + best >= olen) || (i + best >= nlen) || (pold[k + best] != pnew[i + best]))
+                    {
+                        continue;
+                    }
+                    for (n = 0; (k + n < olen) && (i + n < nlen) && (pold[k + n] == pnew[i + n]); n++)
+                    {
+                    }
+                    dist = (k > last) ? (k - last) : (last - k);
+                    if ((n > best) || ((n == best) && (dist < best_dist)))
+                    {
+                        best = n;
+                        best_off = k;
+                        best_dist = dist;
+                    }
+                }
+            }
+            if (best < MIN_MATCH)
+            {
+                i++;
+                continue;
+            }
+
+            //2.3 ǰչ, ԭ
+            while ((i > lit) && best_off && (pold[best_off - 1] == pnew[i - 1]))
+            {
+                i--;
+                best_off--;
+                best++;
+            }
+
+            if ((OK != out_op(pout, pnew + lit, i - lit, 0, &last))
+                    || (OK != out_op(pout, NULL, best, best_off, &last)))
+            {
+                break;
+            }
+            i += best;
+            lit = i;
+        }
+        if ((i < nlen) || (OK != out_op(pout, pnew + lit, nlen - lit, 0, &last)))
+        {
+            break;
+        }
+        ret = OK;
+    } while (0);
+
+    free(phead);
+    free(pprev);
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ɲο̼Ͳְԭ¹̼
+ * @param[in]  *pold   : ο̼
+ * @param[in]  olen    : ο̼
+ * @param[in]  *pdelta : ְ
+ * @param[in]  dlen    : ְ
+ * @param[out] **ppnew : ¹̼, freeͷ
+ * @param[out] *pnlen  : ¹̼
+ *
+ * @retval  NULL  : ɹ
+ * @retval !NULL  : ʧԭ
+ ******************************************************************************
+ */
+static const char *
+delta_patch(const uint8 *pold,
+        uint32 olen,
+        const uint8 *pdelta,
+        uint32 dlen,
+        uint8 **ppnew,
+        uint32 *pnlen)
+{
+    uint8 *pnew;
+    uint32 nlen;
+    uint32 pos = 0;
+    uint32 last = 0;
+    uint64 v;
+    uint64 len;
+    int64 off;
+    const uint8 *p = pdelta + sizeof(delta_head_t);
+    const uint8 *pend = pdelta + dlen;
+    const delta_head_t *phead = (const delta_head_t *)pdelta;
+
+    *ppnew = NULL;
+    if ((dlen < sizeof(delta_head_t)) || memcmp(phead->magic, DELTA_MAGIC, sizeof(phead->magic)))
+    {
+        return "ǲְ";
+    }
+    if ((get_le(phead->old_len, 4) != olen)
+            || (get_le(phead->old_hash, 8) != hash_fnv(pold, olen, HASH_INIT)))
+    {
+        return "ο̼";
+    }
+    nlen = (uint32)get_le(phead->new_len, 4);
+    pnew = malloc(nlen ? nlen : 1);
+    if (!pnew)
+    {
+        return "ڴ治";
+    }
+
+    while (p < pend)
+    {
+        if ((OK != get_varint(&p, pend, &v)) || ((len = v >> 1) > nlen - pos))
+        {
+            break;
+        }
+        if (!(v & 1))
+        {
+            if (len > (uint64)(pend - p))
+            {
+                break;
+            }
+            memcpy(pnew + pos, p, len);
+            p += len;
+        }
+        else
+        {
+            if (OK != get_varint(&p, pend, &v))
+            {
+                break;
+            }
+            off = (int64)last + (int64)((v >> 1) ^ (0 - (v & 1)));
+            if ((off < 0) || ((uint64)off + len > olen))
+            {
+                break;
+            }
+            memcpy(pnew + pos, pold + off, len);
+            last = (uint32)(off + len);
+        }
+        pos += (uint32)len;
+    }
+    if ((p != pend) || (pos != nlen))
+    {
+        free(pnew);
+        return "ְ";
+    }
+    if (get_le(phead->new_hash, 8) != hash_fnv(pnew, nlen, HASH_INIT))
+    {
+        free(pnew);
+        return "ԭУʧ";
+    }
+    *ppnew = pnew;
+    *pnlen = nlen;
+
+    return NULL;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ɲ, ԭһ֤(makefile)
+ * @param[in]  argc  : 
+ * @param[in]  **argv : <ο̼> <¹̼> <ְ>
+ *
+ * @retval  EXIT_SUCCESS : ɹ
+ * @retval  EXIT_FAILURE : ʧ
+ ******************************************************************************
+ */
+int
+delta_make(int argc,
+        char **argv)
+{
+    uint32 ms = os_ms();
+    uint32 olen = 0;
+    uint32 nlen = 0;
+    uint32 len;
+    uint8 *pcheck = NULL;
+    const char *perr = NULL;
+    const char *pold;
+    const char *pnew;
+    delta_head_t head;
+    out_buf_t out = {NULL, 0, 0};
+    int ret = EXIT_FAILURE;
+
+    if (argc < 3)
+    {
+        return EXIT_FAILURE;
+    }
+    //ļӳʧ, 0
+    pold = os_fmap(argv[0], &olen);
+    pnew = os_fmap(argv[1], &nlen);
+    if (!pold)
+    {
+        olen = 0;
+    }
+    if (!pnew)
+    {
+        nlen = 0;
+    }
+
+    do
+    {
+        memcpy(head.magic, DELTA_MAGIC, sizeof(head.magic));
+        put_le(head.old_len, olen, 4);
+        put_le(head.new_len, nlen, 4);
+        put_le(head.old_hash, hash_fnv(pold, olen, HASH_INIT), 8);
+        put_le(head.new_hash, hash_fnv(pnew, nlen, HASH_INIT), 8);
+        if ((OK != out_put(&out, &head, sizeof(head)))
+                || (OK != delta_diff((const uint8 *)pold, olen, (const uint8 *)pnew, nlen, &out)))
+        {
+            perr = "ڴ治";
+            break;
+        }
+
+        //ԭһ, ¹ֽ̼ڱȽ
+        perr = delta_patch((const uint8 *)pold, olen, out.pbuf, out.len, &pcheck, &len);
+        if (perr)
+        {
+            break;
+        }
+        if ((len != nlen) || memcmp(pcheck, pnew, nlen))
+        {
+            perr = "ԭһ";
+            break;
+        }
+        if (OK != os_fupdate(argv[2], (const char *)out.pbuf, (int)out.len))
+        {
+            perr = "дļʧ";
+            break;
+        }
+        printf(": %s -> %s, %u -> %uֽ(%.1f%%), ʱ%ums\n", argv[0], argv[1],
+                nlen, out.len, nlen ? out.len * 100.0 / nlen : 0.0, os_ms() - ms);
+        ret = EXIT_SUCCESS;
+    } while (0);
+
+    if (perr)
+    {
+        printf("ɲ%sʧ: %s\n", argv[2], perr);
+    }
+    free(pcheck);
+    free(out.pbuf);
+    os_funmap(pold);
+    os_funmap(pnew);
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ɲο̼Ͳְԭ¹̼
+ * @param[in]  argc  : 
+ * @param[in]  **argv : <ο̼> <ְ> <̼>
+ *
+ * @retval  EXIT_SUCCESS : ɹ
+ * @retval  EXIT_FAILURE : ʧ
+ ******************************************************************************
+ */
+int
+delta_apply(int argc,
+        char **argv)
+{
+    uint32 olen = 0;
+    uint32 dlen = 0;
+    uint32 nlen = 0;
+    uint8 *pnew = NULL;
+    const char *perr;
+    const char *pold;
+    const char *pdelta;
+
+    if (argc < 3)
+    {
+        return EXIT_FAILURE;
+    }
+    pold = os_fmap(argv[0], &olen);
+    pdelta = os_fmap(argv[1], &dlen);
+    if (!pold)
+    {
+        olen = 0;
+    }
+
+    perr = pdelta ? delta_patch((const uint8 *)pold, olen, (const uint8 *)pdelta, dlen, &pnew, &nlen)
+            : "޷ȡְ";
+    if (!perr && (OK != os_fupdate(argv[2], (const char *)pnew, (int)nlen)))
+    {
+        perr = "дļʧ";
+    }
+    if (perr)
+    {
+        printf("ԭ%sʧ: %s\n", argv[2], perr);
+    }
+    else
+    {
+        printf("ѻԭ%s(%uֽ), Уͨ\n", argv[2], nlen);
+    }
+    free(pnew);
+    os_funmap(pold);
+    os_funmap(pdelta);
+
+    return perr ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/*----------------------------------delta.c----------------------------------*/
@@ -0,0 +1,51 @@
+/**
+ ******************************************************************************
+ * @file       delta.h
+ * @brief      API include file of delta.h.
+ * @details    This file including all API functions's declare of delta.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef DELTA_H_
+#define DELTA_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include "types.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#define DELTA_SUFFIX        ".delta"    /**< ׺, .binͬ */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern int
+delta_make(int argc,
+        char **argv);
+
+extern int
+delta_apply(int argc,
+        char **argv);
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* DELTA_H_ */
+/*------------------------------End of delta.h-------------------------------*/
@@ -35,22 +35,40 @@
 /** Invalid key token */
 #define DICT_INVALID_KEY    ((char*)-1)
 
+/** Arena chunk size: most ini keys and values fit many times over */
+#define ARENASZ     4096
+
+/** Index slot states (other values are entry number + 1) */
+#define SLOT_EMPTY      0
+#define SLOT_DELETED    (-1)
+
+/*---------------------------------------------------------------------------
+   								Private types
+ ---------------------------------------------------------------------------*/
+
+/** Arena chunk holding copies of keys and values */
+typedef struct _dict_chunk_ {
+	struct _dict_chunk_ *	next ;	/** Next (older) chunk */
+	int						size ;	/** Bytes available in data */
+	int						used ;	/** Bytes handed out */
+	char					data[1] ;
+} dict_chunk ;
+
 /*---------------------------------------------------------------------------
   							Private functions
  ---------------------------------------------------------------------------*/
 
-/* Doubles the allocated size associated to a pointer */
+/* Doubles the allocated size associated to a pointer, zeroing the new half */
 /* 'size' is the current allocated size. */
 static void * mem_double(void * ptr, int size)
 {
-    void * newptr ;
- 
-    newptr = calloc(2*size, 1);
+    char * newptr ;
+
+    newptr = realloc(ptr, 2*size);
     if (newptr==NULL) {
         return NULL ;
     }
-    memcpy(newptr, ptr, size);
-    free(ptr);
+    memset(newptr+size, 0, size);
     return newptr ;
 }
 
@@ -76,6 +94,230 @@ static char * xstrdup(char * s)
     return t ;
 }
 
+/*-------------------------------------------------------------------------*/
+/**
+  @brief    Allocate an arena chunk
+  @param    size    Bytes of string storage in the chunk
+  @return   Pointer to a newly allocated chunk, or NULL
+ */
+/*--------------------------------------------------------------------------*/
+static dict_chunk * dict_chunk_new(int size)
+{
+    dict_chunk * c ;
+
+    c = (dict_chunk *)malloc(sizeof(dict_chunk) + size);
+    if (c) {
+        c->next = NULL ;
+        c->size = size ;
+        c->used = 0 ;
+    }
+    return c ;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief    Copy a string into dictionary storage
+  @param    d   dictionary object owning the copy.
+  @param    s   String to copy.
+  @return   Pointer to the copy, or NULL
+
+  Uses xstrdup() unless the dictionary has an arena. Strings larger than
+  a quarter chunk get a chunk of their own, linked behind the current
+  one so the space left in it is not wasted.
+ */
+/*--------------------------------------------------------------------------*/
+static char * dict_strdup(dictionary * d, char * s)
+{
+    dict_chunk  *   c ;
+    char        *   t ;
+    int             len ;
+
+    if (!s)
+        return NULL ;
+    if (d->arena==NULL)
+        return xstrdup(s);
+
+    len = (int)strlen(s)+1 ;
+    c = d->arena ;
+    if (c->size - c->used < len) {
+        if (len > ARENASZ/4) {
+            if ((c = dict_chunk_new(len)) == NULL)
+                return NULL ;
+            c->next = d->arena->next ;
+            d->arena->next = c ;
+        } else {
+            if ((c = dict_chunk_new(ARENASZ)) == NULL)
+                return NULL ;
+            c->next = d->arena ;
+            d->arena = c ;
+        }
+    }
+    t = c->data + c->used ;
+    memcpy(t, s, len);
+    c->used += len ;
+    return t ;
+}
+
+/* Releases a string from dictionary storage (arena strings live until
+   dictionary_del) */
+static void dict_strfree(dictionary * d, char * s)
+{
+    if (d->arena==NULL)
+        free(s);
+}
+
+/* Number of index slots for 'size' entries of storage: at least twice
+   as many, so the load factor (deleted slots included) never goes above
+   1/2 and probe sequences stay short. */
+static int dict_nslot(int size)
+{
+    int nslot ;
+
+    for (nslot=16 ; nslot<2*size ; nslot<<=1)
+        ;
+    return nslot ;
+}
+
+/* Fills a zeroed index of 'nslot' slots from the current entries and
+   installs it in place of the old one */
+static void dict_index(dictionary * d, int * slot, int nslot)
+{
+    int             i ;
+    unsigned        j ;
+
+    for (i=0 ; i<d->used ; i++) {
+        if (d->key[i]==NULL)
+            continue ;
+        for (j=d->hash[i]&(nslot-1) ; slot[j]!=SLOT_EMPTY ; j=(j+1)&(nslot-1))
+            ;
+        slot[j] = i+1 ;
+    }
+    free(d->slot);
+    d->slot  = slot ;
+    d->nslot = nslot ;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief    Rebuild the index for the current entries
+  @param    d   dictionary object to reindex.
+  @return   int 0 if Ok, -1 if out of memory (old index is kept)
+ */
+/*--------------------------------------------------------------------------*/
+static int dict_rehash(dictionary * d)
+{
+    int         *   slot ;
+    int             nslot ;
+
+    nslot = dict_nslot(d->size);
+    slot = (int *)calloc(nslot, sizeof(int));
+    if (slot==NULL) {
+        return -1 ;
+    }
+    dict_index(d, slot, nslot);
+    return 0 ;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief    Make room for one more entry
+  @param    d   dictionary object to modify.
+  @return   int 0 if Ok, -1 if out of memory
+
+  Called when all storage is used. Deleted entries are squeezed out
+  (keeping insertion order); the storage is doubled only if it would
+  still be more than 3/4 full. The index is rebuilt either way, which
+  also drops its deleted slots. Everything is allocated before any
+  entry moves, so running out of memory leaves the dictionary as it was.
+ */
+/*--------------------------------------------------------------------------*/
+static int dict_grow(dictionary * d)
+{
+    void    *   p ;
+    int     *   slot ;
+    int         size, nslot ;
+    int         i, j ;
+
+    size = (4*d->n > 3*d->size) ? 2*d->size : d->size ;
+    nslot = dict_nslot(size);
+    slot = (int *)calloc(nslot, sizeof(int));
+    if (slot==NULL)
+        return -1 ;
+    if (size > d->size) {
+        /* Reached maximum size: reallocate dictionary. A partial failure
+           only leaves some arrays larger than d->size */
+        if ((p = mem_double(d->val, d->size * sizeof(char*))) == NULL) {
+            free(slot);
+            return -1 ;
+        }
+        d->val = (char **)p ;
+        if ((p = mem_double(d->key, d->size * sizeof(char*))) == NULL) {
+            free(slot);
+            return -1 ;
+        }
+        d->key = (char **)p ;
+        if ((p = mem_double(d->hash, d->size * sizeof(unsigned))) == NULL) {
+            free(slot);
+            return -1 ;
+        }
+        d->hash = (unsigned *)p ;
+        /* Double size */
+        d->size = size ;
+    }
+    if (d->n < d->used) {
+        for (i=0, j=0 ; i<d->used ; i++) {
+            if (d->key[i]==NULL)
+                continue ;
+            d->key[j]  = d->key[i] ;
+            d->val[j]  = d->val[i] ;
+            d->hash[j] = d->hash[i] ;
+            j++ ;
+        }
+        for (i=j ; i<d->used ; i++) {
+            d->key[i]  = NULL ;
+            d->val[i]  = NULL ;
+            d->hash[i] = 0 ;
+        }
+        d->used = j ;
+    }
+    dict_index(d, slot, nslot);
+    return 0 ;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief    Find the index slot holding a key
+  @param    d       dictionary object to search.
+  @param    key     Key to look for.
+  @param    hash    Hash of key.
+  @param    pfree   If not NULL, returns the slot where key would be inserted.
+  @return   int     Slot holding key, or -1 if key is not in the dictionary.
+ */
+/*--------------------------------------------------------------------------*/
+static int dict_find(dictionary * d, char * key, unsigned hash, int * pfree)
+{
+    unsigned    mask = d->nslot-1 ;
+    unsigned    j ;
+    int         e ;
+    int         avail = -1 ;
+
+    for (j=hash&mask ; (e=d->slot[j])!=SLOT_EMPTY ; j=(j+1)&mask) {
+        if (e==SLOT_DELETED) {
+            if (avail<0)
+                avail = j ;
+            continue ;
+        }
+        /* Compare hash, then string to avoid hash collisions */
+        if (hash==d->hash[e-1] && !strcmp(key, d->key[e-1])) {
+            return j ;
+        }
+    }
+    if (pfree) {
+        *pfree = (avail<0) ? (int)j : avail ;
+    }
+    return -1 ;
+}
+
 /*---------------------------------------------------------------------------
   							Function codes
  ---------------------------------------------------------------------------*/
@@ -134,6 +376,34 @@ dictionary * dictionary_new(int size)
 	d->val  = (char **)calloc(size, sizeof(char*));
 	d->key  = (char **)calloc(size, sizeof(char*));
 	d->hash = (unsigned int *)calloc(size, sizeof(unsigned));
+	if (d->val==NULL || d->key==NULL || d->hash==NULL || dict_rehash(d)) {
+		dictionary_del(d);
+		return NULL ;
+	}
+	return d ;
+}
+
+/*-------------------------------------------------------------------------*/
+/**
+  @brief	Create a new dictionary object storing strings in an arena.
+  @param	size	Optional initial size of the dictionary.
+  @return	1 newly allocated dictionary objet.
+
+  Same as dictionary_new(), but keys and values are copied into large
+  chunks owned by the dictionary and freed together by dictionary_del().
+ */
+/*--------------------------------------------------------------------------*/
+dictionary * dictionary_new_arena(int size)
+{
+	dictionary	*	d ;
+
+	if (!(d = dictionary_new(size))) {
+		return NULL;
+	}
+	if (!(d->arena = dict_chunk_new(ARENASZ))) {
+		dictionary_del(d);
+		return NULL;
+	}
 	return d ;
 }
 
@@ -149,17 +419,27 @@ dictionary * dictionary_new(int size)
 void dictionary_del(dictionary * d)
 {
 	int		i ;
+	dict_chunk	*	c ;
 
 	if (d==NULL) return ;
-	for (i=0 ; i<d->size ; i++) {
-		if (d->key[i]!=NULL)
-			free(d->key[i]);
-		if (d->val[i]!=NULL)
-			free(d->val[i]);
+	if (d->arena!=NULL) {
+		/* All strings are in the chunks */
+		while ((c = d->arena) != NULL) {
+			d->arena = c->next ;
+			free(c);
+		}
+	} else {
+		for (i=0 ; i<d->used ; i++) {
+			if (d->key[i]!=NULL)
+				free(d->key[i]);
+			if (d->val[i]!=NULL)
+				free(d->val[i]);
+		}
 	}
 	free(d->val);
 	free(d->key);
 	free(d->hash);
+	free(d->slot);
 	free(d);
 	return ;
 }
@@ -184,18 +464,10 @@ char * dictionary_get(dictionary * d, char * key, char * def)
 	int			i ;
 
 	hash = dictionary_hash(key);
-	for (i=0 ; i<d->size ; i++) {
-        if (d->key[i]==NULL)
-            continue ;
-        /* Compare hash */
-		if (hash==d->hash[i]) {
-            /* Compare string, to avoid hash collisions */
-            if (!strcmp(key, d->key[i])) {
-				return d->val[i] ;
-			}
-		}
-	}
-	return def ;
+	i = dict_find(d, key, hash, NULL);
+	if (i<0)
+		return def ;
+	return d->val[d->slot[i]-1] ;
 }
 
 /*-------------------------------------------------------------------------*/
@@ -227,6 +499,7 @@ char * dictionary_get(dictionary * d, char * key, char * def)
 int dictionary_set(dictionary * d, char * key, char * val)
 {
 	int			i ;
+	int			j ;
 	unsigned	hash ;
 
 	if (d==NULL || key==NULL) return -1 ;
@@ -234,49 +507,34 @@ int dictionary_set(dictionary * d, char * key, char * val)
 	/* Compute hash for this key */
 	hash = dictionary_hash(key) ;
 	/* Find if value is already in dictionary */
-	if (d->n>0) {
-		for (i=0 ; i<d->size ; i++) {
-            if (d->key[i]==NULL)
-                continue ;
-			if (hash==d->hash[i]) { /* Same hash value */
-				if (!strcmp(key, d->key[i])) {	 /* Same key */
-					/* Found a value: modify and return */
-					if (d->val[i]!=NULL)
-						free(d->val[i]);
-                    d->val[i] = val ? xstrdup(val) : NULL ;
-                    /* Value has been modified: return */
-					return 0 ;
-				}
-			}
-		}
+	j = dict_find(d, key, hash, &i);
+	if (j>=0) {
+		/* Found a value: modify and return */
+		i = d->slot[j]-1 ;
+		if (d->val[i]!=NULL)
+			dict_strfree(d, d->val[i]);
+		d->val[i] = dict_strdup(d, val) ;
+		/* Value has been modified: return */
+		return 0 ;
 	}
 	/* Add a new value */
 	/* See if dictionary needs to grow */
-	if (d->n==d->size) {
-
-		/* Reached maximum size: reallocate dictionary */
-		d->val  = (char **)mem_double(d->val,  d->size * sizeof(char*)) ;
-		d->key  = (char **)mem_double(d->key,  d->size * sizeof(char*)) ;
-		d->hash = (unsigned int *)mem_double(d->hash, d->size * sizeof(unsigned)) ;
-        if ((d->val==NULL) || (d->key==NULL) || (d->hash==NULL)) {
-            /* Cannot grow dictionary */
-            return -1 ;
-        }
-		/* Double size */
-		d->size *= 2 ;
+	if (d->used==d->size) {
+		if (dict_grow(d)) {
+			/* Cannot grow dictionary */
+			return -1 ;
+		}
+		/* Index was rebuilt: find the insertion slot again */
+		dict_find(d, key, hash, &i);
 	}
 
-    /* Insert key in the first empty slot */
-    for (i=0 ; i<d->size ; i++) {
-        if (d->key[i]==NULL) {
-            /* Add key here */
-            break ;
-        }
-    }
-	/* Copy key */
-	d->key[i]  = xstrdup(key);
-    d->val[i]  = val ? xstrdup(val) : NULL ;
-	d->hash[i] = hash;
+	/* Append entry, keeping insertion order */
+	j = d->used ;
+	d->key[j]  = dict_strdup(d, key);
+	d->val[j]  = dict_strdup(d, val) ;
+	d->hash[j] = hash;
+	d->slot[i] = j+1 ;
+	d->used ++ ;
 	d->n ++ ;
 	return 0 ;
 }
@@ -296,32 +554,25 @@ void dictionary_unset(dictionary * d, char * key)
 {
 	unsigned	hash ;
 	int			i ;
+	int			j ;
 
 	if (key == NULL) {
 		return;
 	}
 
 	hash = dictionary_hash(key);
-	for (i=0 ; i<d->size ; i++) {
-        if (d->key[i]==NULL)
-            continue ;
-        /* Compare hash */
-		if (hash==d->hash[i]) {
-            /* Compare string, to avoid hash collisions */
-            if (!strcmp(key, d->key[i])) {
-                /* Found key */
-                break ;
-			}
-		}
-	}
-    if (i>=d->size)
+	j = dict_find(d, key, hash, NULL);
+    if (j<0)
         /* Key not found */
         return ;
 
-    free(d->key[i]);
+    /* Leave a hole in the entries and a tombstone in the index */
+    i = d->slot[j]-1 ;
+    d->slot[j] = SLOT_DELETED ;
+    dict_strfree(d, d->key[i]);
     d->key[i] = NULL ;
     if (d->val[i]!=NULL) {
-        free(d->val[i]);
+        dict_strfree(d, d->val[i]);
         d->val[i] = NULL ;
     }
     d->hash[i] = 0 ;
@@ -402,4 +653,138 @@ int main(int argc, char *argv[])
 	return 0 ;
 }
 #endif
+
+/* Benchmark: this dictionary (with and without arena) against the former
+   linear scan */
+#ifdef BENCHDIC
+#include <time.h>
+
+/* Former implementation: hashes compared slot by slot over all entries */
+typedef struct {
+	int			n ;
+	int			size ;
+	char	**	key ;
+	char	**	val ;
+	unsigned *	hash ;
+} linear_dict ;
+
+static char * linear_get(linear_dict * d, char * key, char * def)
+{
+	unsigned	hash = dictionary_hash(key) ;
+	int			i ;
+
+	for (i=0 ; i<d->size ; i++) {
+		if (d->key[i]!=NULL && hash==d->hash[i] && !strcmp(key, d->key[i]))
+			return d->val[i] ;
+	}
+	return def ;
+}
+
+static void linear_set(linear_dict * d, char * key, char * val)
+{
+	unsigned	hash = dictionary_hash(key) ;
+	int			i ;
+
+	for (i=0 ; i<d->size ; i++) {
+		if (d->key[i]!=NULL && hash==d->hash[i] && !strcmp(key, d->key[i])) {
+			free(d->val[i]);
+			d->val[i] = xstrdup(val) ;
+			return ;
+		}
+	}
+	if (d->n==d->size) {
+		d->val  = (char **)mem_double(d->val,  d->size * sizeof(char*)) ;
+		d->key  = (char **)mem_double(d->key,  d->size * sizeof(char*)) ;
+		d->hash = (unsigned *)mem_double(d->hash, d->size * sizeof(unsigned)) ;
+		d->size *= 2 ;
+	}
+	for (i=0 ; d->key[i]!=NULL ; i++)
+		;
+	d->key[i]  = xstrdup(key) ;
+	d->val[i]  = xstrdup(val) ;
+	d->hash[i] = hash ;
+	d->n ++ ;
+}
+
+static double bench_ms(clock_t t)
+{
+	return (clock() - t) * 1000.0 / CLOCKS_PER_SEC ;
+}
+
+/* Times n sets then n gets on d, prints one line and deletes d */
+static void bench_dict(dictionary * d, int n, char * name)
+{
+	char		key[64] ;
+	clock_t		t ;
+	double		set_ms, get_ms, del_ms ;
+	int			i, miss ;
+
+	/* Keys look like the per-path entries of generated ini files */
+	t = clock();
+	for (i=0 ; i<n ; i++) {
+		sprintf(key, "dir:app/module%d/src%d", i/16, i);
+		dictionary_set(d, key, "1");
+	}
+	set_ms = bench_ms(t);
+	t = clock();
+	for (i=0, miss=0 ; i<n ; i++) {
+		sprintf(key, "dir:app/module%d/src%d", i/16, i);
+		miss += (dictionary_get(d, key, NULL)==NULL);
+	}
+	get_ms = bench_ms(t);
+	t = clock();
+	dictionary_del(d);
+	del_ms = bench_ms(t);
+	printf("%8d %-8s %12.1f %12.1f %12.1f%s\n", n, name, set_ms, get_ms,
+			del_ms, miss ? "  MISSING KEYS" : "");
+}
+
+int main(int argc, char *argv[])
+{
+	static const int	nkeys[] = {10000, 100000} ;
+	linear_dict			l ;
+	char				key[64] ;
+	clock_t				t ;
+	double				set_ms, get_ms, del_ms ;
+	int					i, k, n, miss ;
+
+	printf("%8s %-8s %12s %12s %12s\n", "keys", "dict", "set(ms)", "get(ms)",
+			"del(ms)");
+	for (k=0 ; k<2 ; k++) {
+		n = nkeys[k] ;
+		bench_dict(dictionary_new(0), n, "hash");
+		bench_dict(dictionary_new_arena(0), n, "arena");
+
+		memset(&l, 0, sizeof(l));
+		l.size = DICTMINSZ ;
+		l.key  = (char **)calloc(l.size, sizeof(char*));
+		l.val  = (char **)calloc(l.size, sizeof(char*));
+		l.hash = (unsigned *)calloc(l.size, sizeof(unsigned));
+		t = clock();
+		for (i=0 ; i<n ; i++) {
+			sprintf(key, "dir:app/module%d/src%d", i/16, i);
+			linear_set(&l, key, "1");
+		}
+		set_ms = bench_ms(t);
+		t = clock();
+		for (i=0, miss=0 ; i<n ; i++) {
+			sprintf(key, "dir:app/module%d/src%d", i/16, i);
+			miss += (linear_get(&l, key, NULL)==NULL);
+		}
+		get_ms = bench_ms(t);
+		t = clock();
+		for (i=0 ; i<l.size ; i++) {
+			free(l.key[i]);
+			free(l.val[i]);
+		}
+		free(l.key);
+		free(l.val);
+		free(l.hash);
+		del_ms = bench_ms(t);
+		printf("%8d %-8s %12.1f %12.1f %12.1f%s\n", n, "linear", set_ms, get_ms,
+				del_ms, miss ? "  MISSING KEYS" : "");
+	}
+	return 0 ;
+}
+#endif
 /* vim: set ts=4 et sw=4 tw=75 */
@@ -42,17 +42,28 @@
   @brief	Dictionary object
 
   This object contains a list of string/string associations. Each
-  association is identified by a unique string key. Looking up values
-  in the dictionary is speeded up by the use of a (hopefully collision-free)
-  hash function.
+  association is identified by a unique string key. Entries are kept in
+  key/val/hash in insertion order (deleted entries leave a NULL key), and
+  are found through an open-addressing index of cached hashes, so lookups
+  take O(1) expected time.
+
+  A dictionary created by dictionary_new_arena() copies its keys and
+  values into a list of large chunks instead of one malloc() per string;
+  they are all released at once by dictionary_del().
  */
 /*-------------------------------------------------------------------------*/
+struct _dict_chunk_ ;
+
 typedef struct _dictionary_ {
 	int				n ;		/** Number of entries in dictionary */
 	int				size ;	/** Storage size */
 	char 		**	val ;	/** List of string values */
 	char 		**  key ;	/** List of string keys */
 	unsigned	 *	hash ;	/** List of hash values for keys */
+	int				used ;	/** Entries used in key/val/hash, deleted ones included */
+	int			 *	slot ;	/** Index: 0 empty, -1 deleted, else entry number + 1 */
+	int				nslot ;	/** Index size, a power of 2 at least twice size */
+	struct _dict_chunk_ * arena ; /** String chunks, NULL if strings are malloc'd */
 } dictionary ;
 
 
@@ -87,6 +98,20 @@ unsigned dictionary_hash(char * key);
 /*--------------------------------------------------------------------------*/
 dictionary * dictionary_new(int size);
 
+/*-------------------------------------------------------------------------*/
+/**
+  @brief    Create a new dictionary object storing strings in an arena.
+  @param    size    Optional initial size of the dictionary.
+  @return   1 newly allocated dictionary objet.
+
+  Same as dictionary_new(), but keys and values are copied into large
+  chunks owned by the dictionary. Replaced or deleted strings are not
+  reclaimed until dictionary_del(), which frees all chunks at once.
+  Best suited to dictionaries that are loaded once and then read.
+ */
+/*--------------------------------------------------------------------------*/
+dictionary * dictionary_new_arena(int size);
+
 /*-------------------------------------------------------------------------*/
 /**
   @brief    Delete a dictionary object
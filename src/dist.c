@@ -0,0 +1,1093 @@
+/**
+ ******************************************************************************
+ * @file      dist.c
+ * @brief     Զ̱: Ԥ, Զ̻, ͵, ʧʱر
+ * @details   This file including all API functions's implement of dist.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <winsock2.h>
+#include <windows.h>
+#include "types.h"
+#include "maths.h"
+#include "os.h"
+#include "net.h"
+#include "rcache.h"
+#include "dist.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/**  */
+typedef struct
+{
+    char host[64];
+    uint16 port;
+    uint32 running;             /**< ڱ */
+    uint32 slots;               /**< , 0Ϊ */
+} worker_t;
+
+/** б(NULL) */
+typedef struct
+{
+    char **pargv;
+    int num;
+    int max;
+} arg_list_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+#define DIST_MAGIC          (0x43434d41u)   /**< "AMCC" */
+#define DIST_LOAD           (1u)            /**< ѯ: ظrunning, slots */
+#define DIST_CC             (2u)            /**< : .i, ظֵ, , .o */
+
+#define MAX_WORKERS         (32)
+#define MAX_ARGS            (512)
+#define MAX_ARG_LEN         (4096u)
+#define MAX_BLOB            (64u << 20)
+
+#define LOAD_MS             (500)           /**< ѯسʱ */
+#define COMPILE_MS          (300000)        /**< ȴʱ */
+#define WORKER_FAIL         (255)           /**< ڲʱķֵ */
+#define WORKER_REFUSE       (254)           /**< ܾ()ʱķֵ */
+
+/** ļС */
+#define READ_BUF_SIZE       (1024u)
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+/** : бź, ڱ, ʱļ */
+static HANDLE the_slots;
+static int the_slot_num;
+static volatile long the_running;
+static volatile long the_seq;
+
+/** Ԥ(), ʱȥ */
+static const char *const the_cpp_opts[] =
+{
+    "-I", "-D", "-U", "-include", "-imacros", "-isystem", "-iquote", "-idirafter",
+    "-MF", "-MT", "-MQ", "-o",
+};
+
+/** Ԥǰ׺(д), ʱȥ */
+static const char *const the_cpp_prefix[] =
+{
+    "-I", "-D", "-U", "-M", "-Wp,", "-include", "-imacros", "-isystem", "-iquote", "-idirafter",
+};
+
+/** ֻܴɲ(ִдļ), ɱ */
+static const char *const the_allow_opts[] =
+{
+    "-w", "-ansi", "-pipe", "-pedantic", "-pedantic-errors", "-flto", "-fpic", "-fPIC", "-fpie", "-fPIE",
+    "-ffunction-sections", "-fdata-sections", "-fsigned-char", "-funsigned-char", "-fshort-enums",
+    "-fshort-wchar", "-fpack-struct", "-fomit-frame-pointer", "-fcommon", "-fwrapv",
+    "-fsingle-precision-constant", "-fexceptions", "-funwind-tables", "-fasynchronous-unwind-tables",
+    "-fstack-protector", "-fstack-protector-strong", "-fstack-protector-all", "-fdiagnostics-color",
+};
+
+/** ܵĲǰ׺(-Wܴ, -Wa,) */
+static const char *const the_allow_prefix[] =
+{
+    "-m", "-O", "-g", "-W", "-std=", "-fno-", "-fmessage-length=", "-fpack-struct=", "-fstrict-",
+    "-flto=", "-flto-partition=", "-finline-", "-fdiagnostics-color=", "--param=",
+};
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   б׷/ͷ
+ ******************************************************************************
+ */
+static status_t
+args_add(arg_list_t *pl,
+        const char *parg)
+{
+    char **pnew;
+
+    if (pl->num + 1 >= pl->max)
+    {
+        pl->max = pl->max ? pl->max * 2 : 64;
+        pnew = realloc(pl->pargv, pl->max * sizeof(char *));
+        if (!pnew)
+        {
+            return ERROR;
+        }
+        pl->pargv = pnew;
+    }
+    pl->pargv[pl->num] = strdup(parg);
+    if (!pl->pargv[pl->num])
+    {
+        return ERROR;
+    }
+    pl->pargv[++pl->num] = NULL;
+
+    return OK;
+}
+
+static void
+args_free(arg_list_t *pl)
+{
+    int i;
+
+    for (i = 0; i < pl->num; i++)
+    {
+        free(pl->pargv[i]);
+    }
+    free(pl->pargv);
+    memset(pl, 0x00, sizeof(*pl));
+}
+
+/**
+ ******************************************************************************
+ * @brief   չӦļ(@cc.rsp), żתgccͬ
+ * @param[out] *pl    : б
+ * @param[in]  *pfile : Ӧļ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+static status_t
+args_rsp_add(arg_list_t *pl,
+        const char *pfile)
+{
+    uint32 n;
+    uint32 size = 0;
+    char quote;
+    char tok[MAX_ARG_LEN];
+    const char *p;
+    const char *pend;
+    const char *paddr;
+    status_t ret = OK;
+
+    paddr = os_fmap(pfile, &size);
+    if (!paddr)
+    {
+        return ERROR;
+    }
+    for (p = paddr, pend = paddr + size; (OK == ret) && (p < pend); )
+    {
+        if (isspace(*p))
+        {
+            p++;
+            continue;
+        }
+        for (n = 0, quote = 0; (p < pend) && (quote || !isspace(*p)) && (n < sizeof(tok) - 1); )
+        {
+            if (quote && (*p == quote))
+            {
+                quote = 0;
+                p++;
+            }
+            else if (!quote && ((*p == '"') || (*p == '\'')))
+            {
+                quote = *p++;
+            }
+            else if ((*p == '\\') && (p + 1 < pend))
+            {
+                p++;
+                tok[n++] = *p++;
+            }
+            else
+            {
+                tok[n++] = *p++;
+            }
+        }
+        tok[n] = 0;
+        ret = args_add(pl, tok);
+    }
+    os_funmap(paddr);
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ǷΪĳ(ǰ׺)
+ ******************************************************************************
+ */
+static bool_e
+arg_in(const char *parg,
+        const char *const *ptab,
+        int num,
+        bool_e prefix)
+{
+    int i;
+
+    for (i = 0; i < num; i++)
+    {
+        if (prefix ? !strncmp(parg, ptab[i], strlen(ptab[i])) : !strcmp(parg, ptab[i]))
+        {
+            return E_TRUE;
+        }
+    }
+    return E_FALSE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ɱõԤı
+ * @param[in]  *argv     : 
+ * @param[out] *ppre     : Ԥ(-cΪ-E, Ϊxx.o.i, ļճ)
+ * @param[out] *premote  : (ȥԤ, Դļ)
+ * @param[out] *pobj     : Ŀļ
+ * @param[in]  obj_size  : pobjĴС
+ *
+ * @retval  OK    : Էַ
+ * @retval  ERROR : ǵ.cļı(, ), ִ
+ ******************************************************************************
+ */
+static status_t
+dist_args(char *const argv[],
+        arg_list_t *ppre,
+        arg_list_t *premote,
+        char *pobj,
+        int obj_size)
+{
+    int i;
+    int len;
+    bool_e compile = E_FALSE;
+    bool_e dep = E_FALSE;
+    bool_e dep_file = E_FALSE;
+    bool_e output = E_FALSE;
+    const char *psrc = NULL;
+    const char *parg;
+    char tmp[MAX_PATH + 8];
+    arg_list_t all = {NULL, 0, 0};
+    status_t ret = ERROR;
+
+    pobj[0] = 0;
+    do
+    {
+        //1. չӦļ
+        for (i = 0; argv[i]; i++)
+        {
+            if ((argv[i][0] == '@') && (OK == args_rsp_add(&all, argv[i] + 1)))
+            {
+                continue;
+            }
+            if (OK != args_add(&all, argv[i]))
+            {
+                break;
+            }
+        }
+        if (argv[i] || !all.num)
+        {
+            break;
+        }
+
+        //2. ַֻ.cļ-c
+        for (i = 1; i < all.num; i++)
+        {
+            parg = all.pargv[i];
+            if (!strncmp(parg, "-MF", 3))
+            {
+                dep_file = E_TRUE;
+            }
+            if (!strcmp(parg, "-c"))
+            {
+                compile = E_TRUE;
+            }
+            else if (!strcmp(parg, "-MD") || !strcmp(parg, "-MMD"))
+            {
+                dep = E_TRUE;
+            }
+            else if (!strcmp(parg, "-E") || !strcmp(parg, "-S") || !strcmp(parg, "-x")
+                    || !strcmp(parg, "-M") || !strcmp(parg, "-MM"))
+            {
+                break;
+            }
+            else if (E_TRUE == arg_in(parg, the_cpp_opts, ARRAY_SIZE(the_cpp_opts), E_FALSE))
+            {
+                if ((++i < all.num) && !strcmp(parg, "-o"))
+                {
+                    strncpy(pobj, all.pargv[i], obj_size - 1);
+                    pobj[obj_size - 1] = 0;
+                }
+            }
+            else if (parg[0] != '-')
+            {
+                len = strlen(parg);
+                if (psrc || (len < 3) || strcmp(parg + len - 2, ".c"))
+                {
+                    break;
+                }
+                psrc = parg;
+            }
+        }
+        if ((i < all.num) || !compile || !psrc || !pobj[0])
+        {
+            break;
+        }
+
+        //3. Ԥ(@Ӧļ, չܳг)ı,
+        //   -c-o
+        snprintf(tmp, sizeof(tmp), "%s.i", pobj);
+        compile = E_FALSE;
+        for (i = 0; argv[i]; i++)
+        {
+            parg = argv[i];
+            if (!strcmp(parg, "-c"))
+            {
+                compile = E_TRUE;
+            }
+            if (OK != args_add(ppre, !strcmp(parg, "-c") ? "-E" : parg))
+            {
+                break;
+            }
+            if (!strcmp(parg, "-o") && argv[i + 1])
+            {
+                i++;
+                output = E_TRUE;
+                if (OK != args_add(ppre, tmp))
+                {
+                    break;
+                }
+            }
+        }
+        if (argv[i] || !compile || !output)
+        {
+            break;
+        }
+        //δָ-MFʱgcc-o(xx.o.i)ļ, ﰴxx.oxx.d
+        if (dep && !dep_file)
+        {
+            strncpy(tmp, pobj, sizeof(tmp) - 3);
+            tmp[sizeof(tmp) - 3] = 0;
+            len = strlen(tmp);
+            if ((len > 2) && !strcmp(tmp + len - 2, ".o"))
+            {
+                len -= 2;
+            }
+            strcpy(tmp + len, ".d");
+            if ((OK != args_add(ppre, "-MF")) || (OK != args_add(ppre, tmp)))
+            {
+                break;
+            }
+        }
+        for (i = 0; i < all.num; i++)
+        {
+            parg = all.pargv[i];
+            if (E_TRUE == arg_in(parg, the_cpp_opts, ARRAY_SIZE(the_cpp_opts), E_FALSE))
+            {
+                i++;
+                continue;
+            }
+            if (i && (!strcmp(parg, "-c") || (parg == psrc)
+                    || (E_TRUE == arg_in(parg, the_cpp_prefix, ARRAY_SIZE(the_cpp_prefix), E_TRUE))))
+            {
+                continue;
+            }
+            if (OK != args_add(premote, parg))
+            {
+                break;
+            }
+        }
+        if (i < all.num)
+        {
+            break;
+        }
+        ret = OK;
+    } while (0);
+    args_free(&all);
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   б: host[:port],host[:port]...
+ * @param[in]  *plist : б
+ * @param[out] *pw    : 
+ * @param[in]  max    : 
+ *
+ * @return  
+ ******************************************************************************
+ */
+static int
+worker_parse(const char *plist,
+        worker_t *pw,
+        int max)
+{
+    int n = 0;
+    char *p;
+    char *pport;
+    char list[READ_BUF_SIZE];
+
+    strncpy(list, plist, sizeof(list) - 1);
+    list[sizeof(list) - 1] = 0;
+    for (p = strtok(list, ",; "); p && (n < max); p = strtok(NULL, ",; "))
+    {
+        memset(&pw[n], 0x00, sizeof(pw[n]));
+        pport = strrchr(p, ':');
+        if (pport)
+        {
+            *pport++ = 0;
+        }
+        strncpy(pw[n].host, p, sizeof(pw[n].host) - 1);
+        pw[n].port = (uint16)(pport ? atoi(pport) : DIST_PORT);
+        n++;
+    }
+    return n;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ѯ
+ * @param[in,out] *pw : , ʧʱslotsΪ0
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+static status_t
+worker_load(worker_t *pw)
+{
+    SOCKET s;
+    status_t ret = ERROR;
+
+    pw->running = 0;
+    pw->slots = 0;
+    s = net_connect(pw->host, pw->port);
+    if (s == INVALID_SOCKET)
+    {
+        return ERROR;
+    }
+    if ((OK == net_send_u32(s, DIST_MAGIC)) && (OK == net_send_u32(s, DIST_LOAD))
+            && (OK == net_recv_u32(s, &pw->running, LOAD_MS))
+            && (OK == net_recv_u32(s, &pw->slots, LOAD_MS)))
+    {
+        ret = OK;
+    }
+    else
+    {
+        pw->slots = 0;
+    }
+    closesocket(s);
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȽϺ(qsortʹ): (running / slots), õں
+ ******************************************************************************
+ */
+static int
+worker_cmp(const void *pa,
+        const void *pb)
+{
+    const worker_t *pl = pa;
+    const worker_t *pr = pb;
+    uint64 l = (uint64)pl->running * (pr->slots ? pr->slots : 1);
+    uint64 r = (uint64)pr->running * (pl->slots ? pl->slots : 1);
+
+    if (!pl->slots || !pr->slots)
+    {
+        return (int)!pl->slots - (int)!pr->slots;
+    }
+    return (l < r) ? -1 : ((l > r) ? 1 : 0);
+}
+
+/**
+ ******************************************************************************
+ * @brief   αǷܾ(бĸ̹DIST_REFUSED)
+ ******************************************************************************
+ */
+static bool_e
+worker_refused(const worker_t *pw)
+{
+    unsigned int p;
+    char host[64];
+    char line[READ_BUF_SIZE];
+    bool_e refused = E_FALSE;
+    FILE *pfd;
+
+    pfd = fopen(DIST_REFUSED, "r");
+    while (pfd && !refused && fgets(line, sizeof(line), pfd))
+    {
+        refused = ((sscanf(line, "%63s %u", host, &p) == 2)
+                && !strcmp(host, pw->host) && (p == pw->port)) ? E_TRUE : E_FALSE;
+    }
+    if (pfd)
+    {
+        fclose(pfd);
+    }
+    return refused;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ¼ܾ, һʱԭ
+ * @param[in]  *pw   : 
+ * @param[in]  *pmsg : صԭ
+ *
+ * @return  None
+ *
+ * @note    Դļͬ, α벻ʹøù
+ ******************************************************************************
+ */
+static void
+worker_refuse(const worker_t *pw,
+        const char *pmsg)
+{
+    char line[128];
+
+    if (E_TRUE == worker_refused(pw))
+    {
+        return;
+    }
+    snprintf(line, sizeof(line), "%s %u\n", pw->host, pw->port);
+    os_append(DIST_REFUSED, line);
+    fprintf(stderr, "%s:%uܾ, α벻ʹ: %s", pw->host, pw->port, pmsg);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ڹϱ
+ * @param[in]  *pw      : 
+ * @param[in]  *pl      : 
+ * @param[in]  *psrc    : ԤԴļ
+ * @param[in]  len      : 
+ * @param[in]  *pobj    : Ŀļ
+ *
+ * @retval  -1   : ӻʧ
+ * @retval  WORKER_REFUSE : ܾ(Ѽ¼ԭ)
+ * @retval   : ֵ(0ʱдĿļ)
+ ******************************************************************************
+ */
+static int
+worker_compile(const worker_t *pw,
+        const arg_list_t *pl,
+        const char *psrc,
+        uint32 len,
+        const char *pobj)
+{
+    int i;
+    int ret = -1;
+    uint32 status;
+    uint32 olen = 0;
+    char *perr = NULL;
+    char *pout = NULL;
+    FILE *pfd;
+    SOCKET s;
+
+    s = net_connect(pw->host, pw->port);
+    if (s == INVALID_SOCKET)
+    {
+        return -1;
+    }
+    do
+    {
+        if ((OK != net_send_u32(s, DIST_MAGIC)) || (OK != net_send_u32(s, DIST_CC))
+                || (OK != net_send_u32(s, pl->num)))
+        {
+            break;
+        }
+        for (i = 0; (i < pl->num) && (OK == net_send_blob(s, pl->pargv[i], strlen(pl->pargv[i]))); i++)
+        {
+        }
+        if ((i < pl->num) || (OK != net_send_blob(s, psrc, len))
+                || (OK != net_recv_u32(s, &status, COMPILE_MS)))
+        {
+            break;
+        }
+        perr = net_recv_blob(s, MAX_BLOB, NULL, COMPILE_MS);
+        pout = perr ? net_recv_blob(s, MAX_BLOB, &olen, COMPILE_MS) : NULL;
+        if (!pout)
+        {
+            break;
+        }
+        if (status == WORKER_REFUSE)
+        {
+            worker_refuse(pw, perr);
+        }
+        if (status)
+        {
+            ret = (int)status;
+            break;
+        }
+
+        //Ŀļд(make޸ʱж)
+        pfd = fopen(pobj, "wb");
+        if (!pfd)
+        {
+            ret = 1;
+            break;
+        }
+        i = (fwrite(pout, 1, olen, pfd) == olen);
+        if (fclose(pfd) || !i)
+        {
+            remove(pobj);
+            ret = 1;
+            break;
+        }
+        fputs(perr, stderr); //
+        ret = 0;
+    } while (0);
+    closesocket(s);
+    free(perr);
+    free(pout);
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   γԸ, ʧܻһ
+ * @param[in]  *plist   : б
+ * @param[in]  *pl      : 
+ * @param[in]  *psrc    : ԤԴļ
+ * @param[in]  len      : 
+ * @param[in]  *pobj    : Ŀļ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ȫû, 
+ ******************************************************************************
+ */
+static status_t
+worker_dispatch(const char *plist,
+        const arg_list_t *pl,
+        const char *psrc,
+        uint32 len,
+        const char *pobj)
+{
+    int i;
+    int n;
+    int ret;
+    worker_t workers[MAX_WORKERS];
+
+    //1. , صĹ
+    if (OK != net_init())
+    {
+        return ERROR;
+    }
+    n = worker_parse(plist, workers, MAX_WORKERS);
+    for (i = 0; i < n; i++)
+    {
+        if ((E_TRUE == net_is_down(workers[i].host, workers[i].port))
+                || (E_TRUE == worker_refused(&workers[i])))
+        {
+            workers[i].slots = 0;
+        }
+        else if (OK != worker_load(&workers[i]))
+        {
+            net_down(workers[i].host, workers[i].port);
+        }
+    }
+    qsort(workers, n, sizeof(worker_t), worker_cmp);
+
+    //2. γ, ʧܻܾʱһ
+    for (i = 0; (i < n) && workers[i].slots && (workers[i].running < workers[i].slots); i++)
+    {
+        ret = worker_compile(&workers[i], pl, psrc, len, pobj);
+        if (ret < 0)
+        {
+            net_down(workers[i].host, workers[i].port);
+            continue;
+        }
+        if (ret == WORKER_REFUSE)
+        {
+            continue;
+        }
+        return ret ? ERROR : OK;
+    }
+    return ERROR;
+}
+
+/**
+ ******************************************************************************
+ * @brief   Զ̱(builddb_cc): ԤȲԶ̻,
+ *          δʱ͵͵Ĺ(ûйʱ.i), ɹϴԶ̻
+ * @param[in]  *argv  : 
+ * @param[out] *pret  : ķֵ
+ * @param[out] **ppsta : : "hit", "dist", "built"ر
+ *
+ * @retval  E_TRUE  : 
+ * @retval  E_FALSE : δ(ûùԶ̻, .c),
+ *                    ɵ߱ر
+ *
+ * @note    ʱֱӷ, ±׼ȷϢ,
+ *          Ҳ⹤뱾ر汾ͬɵ
+ ******************************************************************************
+ */
+bool_e
+dist_cc(char *const argv[],
+        int *pret,
+        const char **ppsta)
+{
+    uint32 len = 0;
+    char obj[MAX_PATH];
+    char src[MAX_PATH + 8];
+    char log[MAX_PATH + 8];
+    char key[RCACHE_KEY_SIZE];
+    const char *plist = getenv(DIST_ENV);
+    const char *psrc = NULL;
+    const char *pmsg;
+    uint32 mlen;
+    arg_list_t pre = {NULL, 0, 0};
+    arg_list_t remote = {NULL, 0, 0};
+    rcache_mode_e mode = rcache_mode();
+    bool_e cache = E_FALSE;
+
+    if (plist && !plist[0])
+    {
+        plist = NULL;
+    }
+    if ((!plist && (mode == RCACHE_OFF))
+            || (OK != dist_args(argv, &pre, &remote, obj, sizeof(obj))))
+    {
+        args_free(&pre);
+        args_free(&remote);
+        return E_FALSE;
+    }
+    snprintf(src, sizeof(src), "%s.i", obj);
+    snprintf(log, sizeof(log), "%s.txt", obj);
+
+    do
+    {
+        //1. Ԥ(ͬʱļ), ʱ뱾رͬ; ޷ִʱԭ
+        *pret = os_run(pre.pargv, NULL, NULL);
+        *ppsta = "built";
+        if (*pret == -1)
+        {
+            *pret = os_run(argv, NULL, NULL);
+        }
+        if (*pret)
+        {
+            break;
+        }
+        psrc = os_fmap(src, &len);
+        if (!psrc)
+        {
+            len = 0;
+        }
+
+        //2. Զ̻, Ԥ, 汾
+        if ((mode != RCACHE_OFF)
+                && (OK == rcache_key(remote.pargv, psrc ? psrc : "", len, key)))
+        {
+            cache = E_TRUE;
+            if (OK == rcache_get(key, obj))
+            {
+                *ppsta = "hit";
+                break;
+            }
+        }
+
+        //3. ; ûйʱе.i(ͬ, Ԥ).
+        //   ûʱԭر
+        *pret = -1;
+        if (plist)
+        {
+            if (OK == worker_dispatch(plist, &remote, psrc ? psrc : "", len, obj))
+            {
+                *ppsta = "dist";
+                *pret = 0;
+            }
+        }
+        else if (psrc && (OK == args_add(&remote, "-c")) && (OK == args_add(&remote, src))
+                && (OK == args_add(&remote, "-o")) && (OK == args_add(&remote, obj)))
+        {
+            //ʱϢ水ԭ±, ɹʱֻ
+            *pret = os_run(remote.pargv, log, log);
+            pmsg = *pret ? NULL : os_fmap(log, &mlen);
+            if (pmsg)
+            {
+                fwrite(pmsg, 1, mlen, stderr);
+                os_funmap(pmsg);
+            }
+            remove(log);
+        }
+        if (*pret)
+        {
+            *pret = os_run(argv, NULL, NULL);
+        }
+
+        //4. ̨ϴ, ȴ
+        if (!*pret && cache && (mode == RCACHE_RW))
+        {
+            rcache_put(key, obj);
+        }
+    } while (0);
+
+    os_funmap(psrc);
+    remove(src);
+    args_free(&pre);
+    args_free(&remote);
+
+    return E_TRUE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ѯĲ, ȷmake -j
+ * @param[in]  *plist : б
+ *
+ * @return  ùĲ֮
+ ******************************************************************************
+ */
+int
+dist_slots(const char *plist)
+{
+    int i;
+    int n;
+    int sum = 0;
+    worker_t workers[MAX_WORKERS];
+
+    if (OK != net_init())
+    {
+        return 0;
+    }
+    n = worker_parse(plist, workers, MAX_WORKERS);
+    for (i = 0; i < n; i++)
+    {
+        if (OK == worker_load(&workers[i]))
+        {
+            printf("%s:%u: %u, ڱ%u\n", workers[i].host, workers[i].port,
+                    workers[i].slots, workers[i].running);
+            sum += workers[i].slots;
+        }
+        else
+        {
+            printf("%s:%u: \n", workers[i].host, workers[i].port);
+        }
+    }
+    return sum;
+}
+
+/**
+ ******************************************************************************
+ * @brief   : ղ.i, 󷵻ؽ
+ * @param[in]  s : 
+ *
+ * @return  None
+ ******************************************************************************
+ */
+static void
+worker_serve_cc(SOCKET s)
+{
+    int i;
+    int len;
+    int status = WORKER_FAIL;
+    uint32 n;
+    uint32 slen = 0;
+    uint32 olen = 0;
+    uint32 elen = 0;
+    uint32 ms;
+    long seq;
+    char dir[MAX_PATH];
+    char src[MAX_PATH + 32];
+    char obj[MAX_PATH + 32];
+    char err[MAX_PATH + 32];
+    char msg[MAX_ARG_LEN + 64];
+    char *psrc = NULL;
+    const char *pobj = NULL;
+    const char *pout = NULL;
+    const char *pmsg = NULL;
+    bool_e tmp = E_FALSE;
+    arg_list_t args = {NULL, 0, 0};
+    FILE *pfd;
+
+    do
+    {
+        //1. ղԴļ
+        if ((OK != net_recv_u32(s, &n, COMPILE_MS)) || !n || (n > MAX_ARGS))
+        {
+            break;
+        }
+        for (i = 0; i < (int)n; i++)
+        {
+            psrc = net_recv_blob(s, MAX_ARG_LEN, NULL, COMPILE_MS);
+            if (!psrc || (OK != args_add(&args, psrc)))
+            {
+                break;
+            }
+            free(psrc);
+            psrc = NULL;
+        }
+        if ((i < (int)n) || !(psrc = net_recv_blob(s, MAX_BLOB, &slen, COMPILE_MS)))
+        {
+            break;
+        }
+
+        //2. ִֻPATHеgcc, ֻܴɲ
+        len = strlen(args.pargv[0]);
+        if (strpbrk(args.pargv[0], "\\/:")
+                || (!((len >= 3) && !strcmp(args.pargv[0] + len - 3, "gcc"))
+                    && !((len >= 7) && !strcmp(args.pargv[0] + len - 7, "gcc.exe"))))
+        {
+            snprintf(msg, sizeof(msg), "ִֻPATHеgcc(%s)\n", args.pargv[0]);
+            pmsg = msg;
+            status = WORKER_REFUSE;
+        }
+        for (i = 1; !pmsg && (i < args.num); i++)
+        {
+            if ((E_TRUE != arg_in(args.pargv[i], the_allow_opts, ARRAY_SIZE(the_allow_opts), E_FALSE))
+                    && ((E_TRUE != arg_in(args.pargv[i], the_allow_prefix, ARRAY_SIZE(the_allow_prefix), E_TRUE))
+                        || (!strncmp(args.pargv[i], "-W", 2) && strchr(args.pargv[i], ','))))
+            {
+                snprintf(msg, sizeof(msg), "Ч(%s)\n", args.pargv[i]);
+                pmsg = msg;
+                status = WORKER_REFUSE;
+            }
+        }
+
+        //3. дʱļ
+        if (!pmsg)
+        {
+            if (!GetTempPath(sizeof(dir), dir))
+            {
+                strcpy(dir, "./");
+            }
+            seq = InterlockedIncrement(&the_seq);
+            snprintf(src, sizeof(src), "%sam_%lu_%ld.i", dir, (unsigned long)GetCurrentProcessId(), seq);
+            snprintf(obj, sizeof(obj), "%sam_%lu_%ld.o", dir, (unsigned long)GetCurrentProcessId(), seq);
+            snprintf(err, sizeof(err), "%sam_%lu_%ld.txt", dir, (unsigned long)GetCurrentProcessId(), seq);
+            tmp = E_TRUE;
+            pfd = fopen(src, "wb");
+            if (!pfd || (fwrite(psrc, 1, slen, pfd) != slen))
+            {
+                pmsg = "дʱļʧ\n";
+            }
+            if (pfd)
+            {
+                fclose(pfd);
+            }
+        }
+        if (!pmsg
+                && ((OK != args_add(&args, "-c")) || (OK != args_add(&args, src))
+                    || (OK != args_add(&args, "-o")) || (OK != args_add(&args, obj))))
+        {
+            pmsg = "ڴ治\n";
+        }
+
+        //4. , ź
+        if (!pmsg)
+        {
+            WaitForSingleObject(the_slots, INFINITE);
+            InterlockedIncrement(&the_running);
+            ms = os_ms();
+            status = os_run(args.pargv, err, err);
+            InterlockedDecrement(&the_running);
+            ReleaseSemaphore(the_slots, 1, NULL);
+            printf("#%ld: %s, %ums\n", seq, status ? "ʧ" : "", os_ms() - ms);
+
+            pout = os_fmap(err, &elen);
+            pobj = status ? NULL : os_fmap(obj, &olen);
+            if (!status && !pobj)
+            {
+                status = WORKER_FAIL;
+            }
+        }
+        if (!pout)
+        {
+            pout = pmsg ? pmsg : "";
+            elen = strlen(pout);
+        }
+
+        //5. ֵ, , Ŀļ
+        if ((OK == net_send_u32(s, (uint32)status)) && (OK == net_send_blob(s, pout, elen)))
+        {
+            net_send_blob(s, pobj ? pobj : "", pobj ? olen : 0);
+        }
+    } while (0);
+
+    if (pout && (pout != pmsg) && elen)
+    {
+        os_funmap(pout);
+    }
+    os_funmap(pobj);
+    if (tmp)
+    {
+        remove(src);
+        remove(obj);
+        remove(err);
+    }
+    free(psrc);
+    args_free(&args);
+}
+
+/**
+ ******************************************************************************
+ * @brief   : һ(net_serve߳е)
+ ******************************************************************************
+ */
+static void
+worker_conn(SOCKET s)
+{
+    uint32 magic;
+    uint32 cmd;
+
+    if ((OK == net_recv_u32(s, &magic, COMPILE_MS)) && (magic == DIST_MAGIC)
+            && (OK == net_recv_u32(s, &cmd, COMPILE_MS)))
+    {
+        if (cmd == DIST_LOAD)
+        {
+            if (OK == net_send_u32(s, (uint32)the_running))
+            {
+                net_send_u32(s, (uint32)the_slot_num);
+            }
+        }
+        else if (cmd == DIST_CC)
+        {
+            worker_serve_cc(s);
+        }
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ػ: AutoMake -worker [˿] []
+ * @param[in]  argc  : 
+ * @param[in]  **argv : [˿] []
+ *
+ * @retval  EXIT_FAILURE : ޷(ʱ)
+ *
+ * @note    ֻӦڿŵľ: ִпͻָgcc
+ ******************************************************************************
+ */
+int
+dist_worker(int argc,
+        char **argv)
+{
+    int port = (argc > 0) ? atoi(argv[0]) : DIST_PORT;
+
+    the_slot_num = (argc > 1) ? atoi(argv[1]) : os_cpus();
+    the_slot_num = MAX(1, the_slot_num);
+    the_slots = CreateSemaphore(NULL, the_slot_num, the_slot_num, NULL);
+    if (!the_slots)
+    {
+        return EXIT_FAILURE;
+    }
+    printf(": ˿%d, %d\n", port, the_slot_num);
+    if (OK != net_serve((uint16)port, worker_conn))
+    {
+        printf("޷˿%d\n", port);
+    }
+
+    return EXIT_FAILURE;
+}
+
+/*----------------------------------dist.c-----------------------------------*/
@@ -0,0 +1,57 @@
+/**
+ ******************************************************************************
+ * @file       dist.h
+ * @brief      API include file of dist.h.
+ * @details    This file including all API functions's declare of dist.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef DIST_H_
+#define DIST_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include "types.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#define DIST_ENV            "AUTOMAKE_DIST" /**< б: host[:port],... */
+#define DIST_PORT           (3633)          /**< Ĭ϶˿ */
+#define DIST_REFUSED        ".dist_refused" /**< ܾĹ(Ŀ¼, ÿαǰɾ) */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern bool_e
+dist_cc(char *const argv[],
+        int *pret,
+        const char **ppsta);
+
+extern int
+dist_slots(const char *plist);
+
+extern int
+dist_worker(int argc,
+        char **argv);
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* DIST_H_ */
+/*-------------------------------End of dist.h-------------------------------*/
@@ -0,0 +1,837 @@
+/**
+ ******************************************************************************
+ * @file      explain.c
+ * @brief     ¼Ŀļָ, ĿļΪʲôҪ±
+ * @details   This file including all API functions's implement of explain.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "types.h"
+#include "param.h"
+#include "os.h"
+#include "hash.h"
+#include "explain.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** Ҫ±ԭ */
+typedef enum
+{
+    WHY_UPTODATE = 0,           /**< Ҫ */
+    WHY_NO_OBJ,                 /**< Ŀļ */
+    WHY_NO_DEP,                 /**< û.dļ */
+    WHY_DEP_GONE,               /**< ļɾ */
+    WHY_CONTENT,                /**< ļݸı */
+    WHY_TOUCH,                  /**< ļֻʱ */
+    WHY_NO_FP,                  /**< ļĿ, ûָƼ¼ */
+    WHY_CMD,                    /**< ı(make±) */
+    WHY_NUM,
+} why_e;
+
+/** ļָ */
+typedef struct
+{
+    char *pname;
+    long mtime;
+    long size;
+    uint64 hash;
+} fp_t;
+
+/** ±ļ */
+typedef struct
+{
+    char *pname;
+    why_e why;
+    int objs;                   /**< ¶ٸĿļ± */
+} blame_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+#define FP_SUFFIX           ".fp"           /**< ָļ׺(.oͬĿ¼) */
+#define EXPLAIN_CMD         "explain.cmd"   /**< make -n -B */
+#define EXPLAIN_REPORT      "explain.txt"   /**<  */
+#define EXPLAIN_TOP         (10)            /**< Ӱļ */
+
+/** ·С */
+#define PATH_BUF_SIZE       (512u)
+
+/** ļС */
+#define READ_BUF_SIZE       (16384u)
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static const char *const the_why[WHY_NUM] =
+{
+    "Ҫ",
+    "Ŀļ",
+    "ûļ(.d)",
+    "ļɾ",
+    "ļݸı",
+    "ļֻʱ, δ",
+    "ļĿ(ûָƼ¼)",
+    "Ѹı, make±",
+};
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   Ĺϣ(ȥ, ϲհ, ʹmake -nʵʲһ)
+ * @param[in]  *pcmd : 
+ * @param[in]  *pdir : ĹĿ¼(@Ӧļ)
+ *
+ * @return  ϣֵ
+ *
+ * @note    @fileļ, ӦļеĲ仯Ҳܷ
+ ******************************************************************************
+ */
+static uint64
+explain_cmd_hash(const char *pcmd,
+        const char *pdir)
+{
+    int i;
+    uint64 h = HASH_INIT;
+    uint64 fh;
+    bool_e space = E_FALSE;
+    char tmp[PATH_BUF_SIZE];
+
+    while ((*pcmd == ' ') || (*pcmd == '\t'))
+    {
+        pcmd++;
+    }
+    for (; *pcmd && (*pcmd != '\r') && (*pcmd != '\n'); pcmd++)
+    {
+        if (*pcmd == '"')
+        {
+            continue;
+        }
+        if ((*pcmd == ' ') || (*pcmd == '\t'))
+        {
+            space = E_TRUE;
+            continue;
+        }
+        if (space)
+        {
+            h = hash_fnv(" ", 1, h);
+            space = E_FALSE;
+            if (*pcmd == '@')
+            {
+                i = snprintf(tmp, sizeof(tmp), "%s/", pdir);
+                while (pcmd[1] && (pcmd[1] != ' ') && (pcmd[1] != '\t') && (pcmd[1] != '"')
+                        && (pcmd[1] != '\r') && (pcmd[1] != '\n') && (i < (int)sizeof(tmp) - 1))
+                {
+                    tmp[i++] = *++pcmd;
+                }
+                tmp[i] = 0;
+                if (OK != hash_file(tmp, &fh))
+                {
+                    fh = hash_str(tmp);
+                }
+                h = hash_fnv(&fh, sizeof(fh), h);
+                continue;
+            }
+        }
+        h = hash_fnv(pcmd, 1, h);
+    }
+    return h;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȡ.dļĿ(һ)
+ * @param[in]  *pdfile : .dļ
+ * @param[out] *pnum   : 
+ *
+ * @retval  NULL  : ʧ
+ * @retval !NULL  : б(NULL), pdeps[0]ָĻ漰бfree
+ *
+ * @note    ʽ: app/a.o: ../app/a.c ../inc/a.h \
+ *                 ../inc/b.h
+ ******************************************************************************
+ */
+static char **
+explain_deps_read(const char *pdfile,
+        int *pnum)
+{
+    int num = 0;
+    int max = 64;
+    long len;
+    char *pbuf;
+    char *p;
+    char *q;
+    char **pdeps;
+    char **pnew;
+    FILE *pfd;
+
+    *pnum = 0;
+    pfd = fopen(pdfile, "rb");
+    if (!pfd)
+    {
+        return NULL;
+    }
+    fseek(pfd, 0, SEEK_END);
+    len = ftell(pfd);
+    fseek(pfd, 0, SEEK_SET);
+    pbuf = malloc(len + 1);
+    pdeps = malloc(max * sizeof(char *));
+    if (!pbuf || !pdeps || (fread(pbuf, 1, len, pfd) != (size_t)len))
+    {
+        fclose(pfd);
+        free(pbuf);
+        free(pdeps);
+        return NULL;
+    }
+    fclose(pfd);
+    pbuf[len] = 0;
+
+    //1. Ŀ(c:/ðź治ǿհ)
+    for (p = pbuf; *p && !((p[0] == ':') && ((p[1] == ' ') || (p[1] == '\t')
+            || (p[1] == '\r') || (p[1] == '\n') || !p[1])); p++)
+    {
+    }
+    if (*p)
+    {
+        p++;
+    }
+
+    //2. ȡ, "\ "ΪļеĿո, β"\"Ϊ
+    q = pbuf;
+    while (*p)
+    {
+        while ((*p == ' ') || (*p == '\t') || (*p == '\r')
+                || ((p[0] == '\\') && ((p[1] == '\n') || (p[1] == '\r'))))
+        {
+            p += (*p == '\\') ? 2 : 1;
+        }
+        if (!*p || (*p == '\n'))
+        {
+            break; //һ
+        }
+        if (num == max - 1)
+        {
+            max *= 2;
+            pnew = realloc(pdeps, max * sizeof(char *));
+            if (!pnew)
+            {
+                break;
+            }
+            pdeps = pnew;
+        }
+        pdeps[num++] = q;
+        while (*p && (*p != ' ') && (*p != '\t') && (*p != '\r') && (*p != '\n'))
+        {
+            if ((p[0] == '\\') && (p[1] == ' '))
+            {
+                p++;
+            }
+            *q++ = *p++;
+        }
+        *q++ = 0; //ԭѹ, qᳬp
+    }
+    pdeps[num] = NULL;
+    if (!num)
+    {
+        pdeps[0] = pbuf; //ͳһͷ
+    }
+    *pnum = num;
+
+    return pdeps;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ͷб
+ ******************************************************************************
+ */
+static void
+explain_deps_free(char **pdeps)
+{
+    if (pdeps)
+    {
+        free(pdeps[0]);
+        free(pdeps);
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   Ŀļõļ(a.o -> a.d / a.o.fp)
+ ******************************************************************************
+ */
+static void
+explain_name(char *pout,
+        int len,
+        const char *pdir,
+        const char *ptarget,
+        const char *psuffix,
+        bool_e replace)
+{
+    int n;
+
+    if (pdir && (ptarget[0] != '/') && (ptarget[1] != ':'))
+    {
+        n = snprintf(pout, len, "%s/%s", pdir, ptarget);
+    }
+    else
+    {
+        n = snprintf(pout, len, "%s", ptarget);
+    }
+    if (replace && (n > 2) && (n < len) && !strcmp(pout + n - 2, ".o"))
+    {
+        n -= 2;
+    }
+    if (psuffix && (n < len))
+    {
+        snprintf(pout + n, len - n, "%s", psuffix);
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȡļ޸ʱͳ
+ ******************************************************************************
+ */
+static status_t
+explain_stat(const char *pfile,
+        long *pmtime,
+        long *psize)
+{
+    struct _stat buf;
+
+    if (_stat(pfile, &buf))
+    {
+        return ERROR;
+    }
+    *pmtime = (long)buf.st_mtime;
+    *psize = (long)buf.st_size;
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   .dļдָļ
+ * @param[in]  *ptarget : Ŀļ(ԵǰĿ¼, Ŀ¼)
+ * @param[in]  cmd      : ϣ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+static status_t
+explain_fp_write(const char *ptarget,
+        uint64 cmd)
+{
+    int i;
+    int num;
+    long mtime;
+    long size;
+    uint64 h;
+    char **pdeps;
+    char tmp[PATH_BUF_SIZE];
+    FILE *pfd;
+
+    explain_name(tmp, sizeof(tmp), NULL, ptarget, ".d", E_TRUE);
+    pdeps = explain_deps_read(tmp, &num);
+
+    explain_name(tmp, sizeof(tmp), NULL, ptarget, FP_SUFFIX, E_FALSE);
+    pfd = fopen(tmp, "w");
+    if (!pfd)
+    {
+        explain_deps_free(pdeps);
+        return ERROR;
+    }
+    fprintf(pfd, "C\t%016llx\n", (unsigned long long)cmd);
+    for (i = 0; i < num; i++)
+    {
+        if ((OK == explain_stat(pdeps[i], &mtime, &size))
+                && (OK == hash_file(pdeps[i], &h)))
+        {
+            fprintf(pfd, "D\t%ld\t%ld\t%016llx\t%s\n", mtime, size,
+                    (unsigned long long)h, pdeps[i]);
+        }
+    }
+    fclose(pfd);
+    explain_deps_free(pdeps);
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ɹ¼Ŀļָ(ɱװ)
+ * @param[in]  *ptarget : Ŀļ(ԵǰĿ¼, Ŀ¼)
+ * @param[in]  *argv    : 
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note    ָļa.o.fp:
+ *              C <ϣ>
+ *              D <޸ʱ> <> <ݹϣ> <ļ>   (ÿһ)
+ ******************************************************************************
+ */
+status_t
+explain_record(const char *ptarget,
+        char *const argv[])
+{
+    int i;
+    int len = 0;
+    uint64 h;
+    char *pcmd;
+
+    if ((strlen(ptarget) < 2) || strcmp(ptarget + strlen(ptarget) - 2, ".o"))
+    {
+        return OK; //ֻ¼.o
+    }
+
+    //1. 
+    for (i = 0; argv[i]; i++)
+    {
+        len += strlen(argv[i]) + 1;
+    }
+    pcmd = malloc(len + 1);
+    if (!pcmd)
+    {
+        return ERROR;
+    }
+    for (i = 0, len = 0; argv[i]; i++)
+    {
+        len += sprintf(pcmd + len, i ? " %s" : "%s", argv[i]);
+    }
+    pcmd[len] = 0;
+    h = explain_cmd_hash(pcmd, "."); //ɱĿ¼еıװ
+    free(pcmd);
+
+    //2. 
+    return explain_fp_write(ptarget, h);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȡָļ
+ * @param[in]  *pfile : ָļ
+ * @param[out] *pcmd  : ϣ
+ * @param[out] *pnum  : 
+ *
+ * @retval  NULL  : ûָļ
+ * @retval !NULL  : ָ
+ ******************************************************************************
+ */
+static fp_t *
+explain_fp_read(const char *pfile,
+        uint64 *pcmd,
+        int *pnum)
+{
+    int max = 0;
+    long mtime;
+    long size;
+    unsigned long long h;
+    char line[READ_BUF_SIZE];
+    char name[PATH_BUF_SIZE];
+    fp_t *pfp = NULL;
+    fp_t *pnew;
+    FILE *pfd;
+
+    *pnum = 0;
+    pfd = fopen(pfile, "r");
+    if (!pfd)
+    {
+        return NULL;
+    }
+    while (fgets(line, sizeof(line), pfd))
+    {
+        if ((line[0] == 'C') && (sscanf(line + 2, "%llx", &h) == 1))
+        {
+            *pcmd = h;
+        }
+        else if ((line[0] == 'D') && (sscanf(line + 2, "%ld\t%ld\t%llx\t%511[^\r\n]",
+                &mtime, &size, &h, name) == 4))
+        {
+            if (*pnum == max)
+            {
+                max = max ? max * 2 : 64;
+                pnew = realloc(pfp, max * sizeof(fp_t));
+                if (!pnew)
+                {
+                    break;
+                }
+                pfp = pnew;
+            }
+            pfp[*pnum].pname = strdup(name);
+            pfp[*pnum].mtime = mtime;
+            pfp[*pnum].size = size;
+            pfp[*pnum].hash = h;
+            (*pnum)++;
+        }
+    }
+    fclose(pfd);
+    if (!pfp)
+    {
+        pfp = calloc(1, sizeof(fp_t)); //ָļû
+    }
+
+    return pfp;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ͷָ
+ ******************************************************************************
+ */
+static void
+explain_fp_free(fp_t *pfp,
+        int num)
+{
+    int i;
+
+    for (i = 0; i < num; i++)
+    {
+        free(pfp[i].pname);
+    }
+    free(pfp);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ļд¼¼ָ(ϣ)
+ * @param[in]  *pdfile : .dļ(ԵǰĿ¼, Ŀ¼)
+ *
+ * @retval  OK    : ɹ(ûָļʱ¼)
+ * @retval  ERROR : ʧ
+ *
+ * @note    -confhʱ-fixdepconfig/autoconf.hΪõconfig/<>.h,
+ *          װ¼makeʵʹõһ
+ ******************************************************************************
+ */
+status_t
+explain_refresh(const char *pdfile)
+{
+    int n;
+    int num;
+    uint64 cmd = 0;
+    fp_t *pfp;
+    char target[PATH_BUF_SIZE];
+    char tmp[PATH_BUF_SIZE];
+
+    n = snprintf(target, sizeof(target), "%s", pdfile);
+    if ((n < 2) || (n >= (int)sizeof(target) - 1) || strcmp(target + n - 2, ".d"))
+    {
+        return ERROR;
+    }
+    target[n - 1] = 'o';
+    explain_name(tmp, sizeof(tmp), NULL, target, FP_SUFFIX, E_FALSE);
+    pfp = explain_fp_read(tmp, &cmd, &num);
+    if (!pfp)
+    {
+        return OK;
+    }
+    explain_fp_free(pfp, num);
+
+    return explain_fp_write(target, cmd);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ¼±ļ
+ ******************************************************************************
+ */
+static void
+explain_blame(blame_t **ppblame,
+        int *pnum,
+        int *pmax,
+        const char *pname,
+        why_e why)
+{
+    int i;
+    blame_t *pnew;
+
+    for (i = 0; i < *pnum; i++)
+    {
+        if (!strcmp((*ppblame)[i].pname, pname))
+        {
+            (*ppblame)[i].objs++;
+            return;
+        }
+    }
+    if (*pnum == *pmax)
+    {
+        *pmax = *pmax ? *pmax * 2 : 64;
+        pnew = realloc(*ppblame, *pmax * sizeof(blame_t));
+        if (!pnew)
+        {
+            return;
+        }
+        *ppblame = pnew;
+    }
+    (*ppblame)[*pnum].pname = strdup(pname);
+    (*ppblame)[*pnum].why = why;
+    (*ppblame)[*pnum].objs = 1;
+    (*pnum)++;
+}
+
+/**
+ ******************************************************************************
+ * @brief   жһĿļΪʲôҪ±
+ * @param[in]  *pcfg    : 
+ * @param[in]  *ptarget : Ŀļ(ԱĿ¼)
+ * @param[in]  cmd      : ǰĹϣ
+ * @param[out] *pfile   : ±ļ
+ * @param[in]  len      : 泤
+ *
+ * @return  ԭ
+ *
+ * @note    makeжһ: ļĿļ±, ָ
+ *          ݸı仹ֻʱ
+ ******************************************************************************
+ */
+static why_e
+explain_obj(const make_cfg_t *pcfg,
+        const char *ptarget,
+        uint64 cmd,
+        char *pfile,
+        int len)
+{
+    int i;
+    int j;
+    int num;
+    int fp_num = 0;
+    long obj_mtime;
+    long mtime;
+    long size;
+    uint64 h;
+    uint64 fp_cmd = 0;
+    char tmp[PATH_BUF_SIZE];
+    char **pdeps;
+    fp_t *pfp;
+    why_e why = WHY_UPTODATE;
+
+    pfile[0] = 0;
+    explain_name(tmp, sizeof(tmp), pcfg->BUILD_DIR, ptarget, NULL, E_FALSE);
+    if (OK != explain_stat(tmp, &obj_mtime, &size))
+    {
+        return WHY_NO_OBJ;
+    }
+    explain_name(tmp, sizeof(tmp), pcfg->BUILD_DIR, ptarget, ".d", E_TRUE);
+    pdeps = explain_deps_read(tmp, &num);
+    if (!pdeps)
+    {
+        return WHY_NO_DEP;
+    }
+    explain_name(tmp, sizeof(tmp), pcfg->BUILD_DIR, ptarget, FP_SUFFIX, E_FALSE);
+    pfp = explain_fp_read(tmp, &fp_cmd, &fp_num);
+
+    for (i = 0; i < num; i++)
+    {
+        explain_name(tmp, sizeof(tmp), pcfg->BUILD_DIR, pdeps[i], NULL, E_FALSE);
+        if (OK != explain_stat(tmp, &mtime, &size))
+        {
+            why = WHY_DEP_GONE;
+            snprintf(pfile, len, "%s", pdeps[i]);
+            break;
+        }
+        if (mtime <= obj_mtime)
+        {
+            continue;
+        }
+
+        //Ŀļ, Աָ
+        for (j = 0; pfp && (j < fp_num) && strcmp(pfp[j].pname, pdeps[i]); j++)
+        {
+        }
+        if (!pfp || (j == fp_num))
+        {
+            if (why == WHY_UPTODATE)
+            {
+                why = WHY_NO_FP;
+                snprintf(pfile, len, "%s", pdeps[i]);
+            }
+        }
+        else if ((pfp[j].size != size) || (OK != hash_file(tmp, &h))
+                || (h != pfp[j].hash))
+        {
+            why = WHY_CONTENT;
+            snprintf(pfile, len, "%s", pdeps[i]);
+            break; //ݸıȷеԭ
+        }
+        else if ((why == WHY_UPTODATE) || (why == WHY_NO_FP))
+        {
+            why = WHY_TOUCH;
+            snprintf(pfile, len, "%s", pdeps[i]);
+        }
+    }
+
+    if ((why == WHY_UPTODATE) && pfp && (fp_cmd != cmd))
+    {
+        why = WHY_CMD;
+    }
+    explain_fp_free(pfp, fp_num);
+    explain_deps_free(pdeps);
+
+    return why;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ͸ĿļΪʲôҪ±
+ * @param[in]  *pcfg : 
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note    ͨmake -n -BõĿļǰı, 
+ *          AutoMake -buildʱ¼ָƱȽ
+ ******************************************************************************
+ */
+status_t
+explain_run(const make_cfg_t *pcfg)
+{
+    int i;
+    int cnt[WHY_NUM];
+    int blame_num = 0;
+    int blame_max = 0;
+    char *p;
+    char *q;
+    char line[READ_BUF_SIZE];
+    char target[PATH_BUF_SIZE];
+    char file[PATH_BUF_SIZE];
+    char out[PATH_BUF_SIZE];
+    char *argv[7];
+    blame_t *pblame = NULL;
+    why_e why;
+    FILE *pfd;
+    FILE *preport;
+
+    //1. гб
+    snprintf(out, sizeof(out), "%s/%s", pcfg->BUILD_DIR, EXPLAIN_CMD);
+    argv[0] = (char *)pcfg->MAKE;
+    argv[1] = "-C";
+    argv[2] = (char *)pcfg->BUILD_DIR;
+    argv[3] = "all";
+    argv[4] = "-n";
+    argv[5] = "-B";
+    argv[6] = NULL;
+    os_run(argv, out, out);
+    pfd = fopen(out, "r");
+    if (!pfd)
+    {
+        printf("޷ִ: %s -C %s -n -B\n", pcfg->MAKE, pcfg->BUILD_DIR);
+        return ERROR;
+    }
+    snprintf(file, sizeof(file), "%s/%s", pcfg->BUILD_DIR, EXPLAIN_REPORT);
+    preport = fopen(file, "w");
+
+    //2. Ŀļж
+    memset(cnt, 0x00, sizeof(cnt));
+    while (fgets(line, sizeof(line), pfd))
+    {
+        p = strstr(line, " -o ");
+        if (!p)
+        {
+            continue;
+        }
+        for (p += 4; (*p == ' ') || (*p == '"'); p++)
+        {
+        }
+        for (q = target; *p && (*p != '"') && (*p != ' ') && (*p != '\r') && (*p != '\n')
+                && (q < target + sizeof(target) - 1); )
+        {
+            *q++ = *p++;
+        }
+        *q = 0;
+        if ((q - target < 2) || strcmp(q - 2, ".o"))
+        {
+            continue; //ӵ
+        }
+
+        why = explain_obj(pcfg, target, explain_cmd_hash(line, pcfg->BUILD_DIR), file, sizeof(file));
+        cnt[why]++;
+        if (why == WHY_UPTODATE)
+        {
+            continue;
+        }
+        printf("%-40s %s%s%s\n", target, the_why[why], file[0] ? ": " : "", file);
+        if (preport)
+        {
+            fprintf(preport, "%s\t%d\t%s\t%s\n", target, why, the_why[why], file);
+        }
+        if (file[0])
+        {
+            explain_blame(&pblame, &blame_num, &blame_max, file, why);
+        }
+    }
+    fclose(pfd);
+    remove(out);
+    if (preport)
+    {
+        fclose(preport);
+    }
+
+    //3. 
+    printf("\n:\n");
+    for (i = 0; i < WHY_NUM; i++)
+    {
+        if (cnt[i])
+        {
+            printf("  %-36s %5d\n", the_why[i], cnt[i]);
+        }
+    }
+    if (cnt[WHY_CMD])
+    {
+        printf("  ע: ıĿļҪclean±\n");
+    }
+    if (blame_num)
+    {
+        printf("\nӰļ:\n");
+    }
+    for (i = 0; (i < EXPLAIN_TOP) && (i < blame_num); i++)
+    {
+        int j;
+        int max = i;
+        blame_t t;
+
+        for (j = i + 1; j < blame_num; j++)
+        {
+            if (pblame[j].objs > pblame[max].objs)
+            {
+                max = j;
+            }
+        }
+        t = pblame[i];
+        pblame[i] = pblame[max];
+        pblame[max] = t;
+        printf("  %-50s %5d  %s\n", pblame[i].pname, pblame[i].objs, the_why[pblame[i].why]);
+    }
+    for (i = 0; i < blame_num; i++)
+    {
+        free(pblame[i].pname);
+    }
+    free(pblame);
+
+    return OK;
+}
+
+/*---------------------------------explain.c---------------------------------*/
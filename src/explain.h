@@ -0,0 +1,54 @@
+/**
+ ******************************************************************************
+ * @file       explain.h
+ * @brief      API include file of explain.h.
+ * @details    This file including all API functions's declare of explain.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef EXPLAIN_H_
+#define EXPLAIN_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include "types.h"
+#include "param.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern status_t
+explain_record(const char *ptarget,
+        char *const argv[]);
+
+extern status_t
+explain_refresh(const char *pdfile);
+
+extern status_t
+explain_run(const make_cfg_t *pcfg);
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* EXPLAIN_H_ */
+/*-----------------------------End of explain.h------------------------------*/
@@ -0,0 +1,220 @@
+/**
+ ******************************************************************************
+ * @file      hash.c
+ * @brief     FNV-1a 64λϣ(ַ, ļ)ַ±
+ * @details   This file including all API functions's implement of hash.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "hash.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+#define FNV_PRIME           (1099511628211ull)
+
+/** ļС */
+#define READ_BUF_SIZE       (16384u)
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   һݵĹϣ
+ * @param[in]  *pdata : 
+ * @param[in]  len    : 
+ * @param[in]  h      : ֵ(HASH_INITһεĽ, ɷֶμ)
+ *
+ * @return  ϣֵ
+ ******************************************************************************
+ */
+uint64
+hash_fnv(const void *pdata,
+        uint32 len,
+        uint64 h)
+{
+    const uint8 *p = pdata;
+
+    while (len--)
+    {
+        h = (h ^ *p++) * FNV_PRIME;
+    }
+    return h;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ַĹϣ
+ * @param[in]  *pstr : ַ
+ *
+ * @return  ϣֵ
+ ******************************************************************************
+ */
+uint64
+hash_str(const char *pstr)
+{
+    return hash_fnv(pstr, strlen(pstr), HASH_INIT);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ļݵĹϣ
+ * @param[in]  *pfile  : ļ
+ * @param[out] *phash  : ϣֵ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ļ޷ȡ
+ ******************************************************************************
+ */
+status_t
+hash_file(const char *pfile,
+        uint64 *phash)
+{
+    FILE *pfd;
+    uint32 len;
+    uint64 h = HASH_INIT;
+    uint8 buf[READ_BUF_SIZE];
+
+    pfd = fopen(pfile, "rb");
+    if (!pfd)
+    {
+        return ERROR;
+    }
+    while ((len = fread(buf, 1, sizeof(buf), pfd)) > 0)
+    {
+        h = hash_fnv(buf, len, h);
+    }
+    fclose(pfd);
+    *phash = h;
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ַ±в()ַ
+ * @param[in]  *pt     : ±(ʼȫ0)
+ * @param[in]  *pstr   : ַ
+ * @param[in]  create  : ʱǷ
+ *
+ * @return  ±(¼ĵڼǰnum), -1ʾڻڴ治
+ ******************************************************************************
+ */
+int
+hash_idx_find(hash_idx_t *pt,
+        const char *pstr,
+        bool_e create)
+{
+    int i;
+    uint32 j;
+
+    if (pt->num * 2 >= pt->hash_size)
+    {
+        int size = pt->hash_size ? pt->hash_size * 2 : 1024;
+        int *pnew = malloc(sizeof(int) * size);
+
+        if (!pnew)
+        {
+            return -1;
+        }
+        memset(pnew, 0xff, sizeof(int) * size);
+        for (i = 0; i < pt->num; i++)
+        {
+            for (j = (uint32)hash_str(pt->pstr[i]) & (size - 1); pnew[j] >= 0;
+                    j = (j + 1) & (size - 1))
+            {
+            }
+            pnew[j] = i;
+        }
+        free(pt->phash);
+        pt->phash = pnew;
+        pt->hash_size = size;
+    }
+
+    for (j = (uint32)hash_str(pstr) & (pt->hash_size - 1); pt->phash[j] >= 0;
+            j = (j + 1) & (pt->hash_size - 1))
+    {
+        if (!strcmp(pt->pstr[pt->phash[j]], pstr))
+        {
+            return pt->phash[j];
+        }
+    }
+    if (E_TRUE != create)
+    {
+        return -1;
+    }
+
+    if (pt->num == pt->max)
+    {
+        int max = pt->max ? pt->max * 2 : 256;
+        char **pnew = realloc(pt->pstr, sizeof(char *) * max);
+
+        if (!pnew)
+        {
+            return -1;
+        }
+        pt->pstr = pnew;
+        pt->max = max;
+    }
+    pt->pstr[pt->num] = strdup(pstr);
+    if (!pt->pstr[pt->num])
+    {
+        return -1;
+    }
+    pt->phash[j] = pt->num;
+
+    return pt->num++;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ͷַ±
+ * @param[in]  *pt : ±
+ *
+ * @return  None
+ ******************************************************************************
+ */
+void
+hash_idx_free(hash_idx_t *pt)
+{
+    int i;
+
+    for (i = 0; i < pt->num; i++)
+    {
+        free(pt->pstr[i]);
+    }
+    free(pt->pstr);
+    free(pt->phash);
+    memset(pt, 0, sizeof(*pt));
+}
+
+/*----------------------------------hash.c-----------------------------------*/
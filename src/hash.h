@@ -0,0 +1,71 @@
+/**
+ ******************************************************************************
+ * @file       hash.h
+ * @brief      API include file of hash.h.
+ * @details    This file including all API functions's declare of hash.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef HASH_H_
+#define HASH_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include "types.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#define HASH_INIT           (14695981039346656037ull)   /**< FNV-1a 64λֵ */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** ַ±: Ѱַϣ, ַ˳ */
+typedef struct
+{
+    char **pstr;                /**< ±Ӧַ(strdup) */
+    int num;
+    int max;
+    int *phash;                 /**< pstr±, -1Ϊ */
+    int hash_size;
+} hash_idx_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern uint64
+hash_fnv(const void *pdata,
+        uint32 len,
+        uint64 h);
+
+extern uint64
+hash_str(const char *pstr);
+
+extern status_t
+hash_file(const char *pfile,
+        uint64 *phash);
+
+extern int
+hash_idx_find(hash_idx_t *pt,
+        const char *pstr,
+        bool_e create);
+
+extern void
+hash_idx_free(hash_idx_t *pt);
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* HASH_H_ */
+/*-------------------------------End of hash.h-------------------------------*/
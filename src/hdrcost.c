@@ -0,0 +1,517 @@
+/**
+ ******************************************************************************
+ * @file      hdrcost.c
+ * @brief     ͳƸͷļԤ(, չֽ, ʱ)
+ * @details   This file including all API functions's implement of hdrcost.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "maths.h"
+#include "param.h"
+#include "os.h"
+#include "hash.h"
+#include "hdrcost.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** ͷļͳ */
+typedef struct
+{
+    char *pname;                /**< ·(ԱĿ¼) */
+    int tus;                    /**< Դļ */
+    int last_tu;                /**< һαԴļ */
+    uint64 bytes;               /**< չֽ(ͷļ), Դļ֮ */
+    uint64 tu_bytes;            /**< ڵǰԴļչֽ */
+    double pp_ms;               /**< ֽ̯Ԥʱ */
+    int probe_ms;               /**< ʱ, -1ʾδ޷ */
+} hdr_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+#define HDRCOST_I           "hdrcost.i"     /**< Ԥ */
+#define HDRCOST_PROBE_C     "hdrcost_probe.c" /**< ͷļõԴļ */
+#define HDRCOST_REPORT      "hdrcost.txt"   /**<  */
+#define HDRCOST_PROBE       (30)            /**< ʱͷļ */
+#define HDRCOST_PROBE_RUNS  (3)             /**< ÿͷļ(ȡС) */
+#define HDRCOST_TOP         (40)            /**< Ļͷļ */
+#define HDRCOST_DEPTH       (256)           /**<  */
+
+/** лС */
+#define CMD_BUF_SIZE        (4096u)
+
+/** ·С */
+#define PATH_BUF_SIZE       (512u)
+
+/** ļС */
+#define READ_BUF_SIZE       (4096u)
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static hash_idx_t the_tu;       /**< Դļ(·ȥ, ù) */
+
+static hdr_t *the_hdr;          /**< ͷļ, the_hdr_idxһһӦ(ǰ) */
+static int the_hdr_num;
+static int the_hdr_max;
+static hash_idx_t the_hdr_idx;  /**< ͷļ */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   һԴļ(ԴĿ¼ʱ, ظĺ)
+ * @param[in]  *pfile : Դļ(ͬsubdir_mk_create·ʽ)
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+status_t
+hdrcost_add(const char *pfile)
+{
+    int len = strlen(pfile);
+
+    if ((len < 2) || strcmp(pfile + len - 2, ".c"))
+    {
+        return OK; //ֻcļ
+    }
+
+    return (hash_idx_find(&the_tu, pfile, E_TRUE) >= 0) ? OK : ERROR;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ͷļ, ½
+ * @param[in]  *pname : ͷļ·
+ *
+ * @retval  >=0 : the_hdr±
+ * @retval   -1 : ڴ治
+ ******************************************************************************
+ */
+static int
+hdrcost_find(const char *pname)
+{
+    int i;
+    hdr_t *phdr;
+
+    //1. ȱ֤the_hdrпλ, һžͱжӦ
+    if (the_hdr_num == the_hdr_max)
+    {
+        i = the_hdr_max ? the_hdr_max * 2 : 256;
+        phdr = realloc(the_hdr, i * sizeof(hdr_t));
+        if (!phdr)
+        {
+            return -1;
+        }
+        the_hdr = phdr;
+        the_hdr_max = i;
+    }
+
+    //2. , ʼ
+    i = hash_idx_find(&the_hdr_idx, pname, E_TRUE);
+    if ((i < 0) || (i < the_hdr_num))
+    {
+        return i;
+    }
+    phdr = &the_hdr[i];
+    memset(phdr, 0x00, sizeof(*phdr));
+    phdr->pname = the_hdr_idx.pstr[i];
+    phdr->last_tu = -1;
+    phdr->probe_ms = -1;
+
+    return the_hdr_num++;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ִʱ
+ * @param[in]  *pcmd : 
+ *
+ * @retval  >=0 : ʱ(ms)
+ * @retval   -1 : ʧ
+ ******************************************************************************
+ */
+static int
+hdrcost_exec(const char *pcmd)
+{
+    uint32 start = os_ms();
+
+    if (system(pcmd))
+    {
+        return -1;
+    }
+    return (int)(os_ms() - start);
+}
+
+/**
+ ******************************************************************************
+ * @brief   Ԥб(# 12 "../app/inc/a.h" 1)
+ * @param[in]  *pline : 
+ * @param[out] *pname : ļ
+ * @param[in]  len    : ļ泤
+ * @param[out] *pflag : ־(1:ͷļ 2: 0:)
+ *
+ * @retval  E_TRUE  : б
+ * @retval  E_FALSE : ͨ
+ ******************************************************************************
+ */
+static bool_e
+hdrcost_marker(const char *pline,
+        char *pname,
+        int len,
+        int *pflag)
+{
+    int n = 0;
+
+    if ((pline[0] != '#') || (pline[1] != ' ') || !isdigit((int)pline[2]))
+    {
+        return E_FALSE;
+    }
+    pline = strchr(pline, '"');
+    if (!pline)
+    {
+        return E_FALSE;
+    }
+    for (pline++; *pline && (*pline != '"') && (n < len - 1); pline++)
+    {
+        if ((*pline == '\\') && pline[1])
+        {
+            pline++; //windows·е\ת\\ .
+        }
+        pname[n++] = (*pline == '\\') ? '/' : *pline;
+    }
+    pname[n] = 0;
+    if (*pline == '"')
+    {
+        pline++;
+    }
+    *pflag = 0;
+    if (!strncmp(pline, " 1", 2) && ((pline[2] == ' ') || (pline[2] < ' ')))
+    {
+        *pflag = 1;
+    }
+    else if (!strncmp(pline, " 2", 2) && ((pline[2] == ' ') || (pline[2] < ' ')))
+    {
+        *pflag = 2;
+    }
+
+    return E_TRUE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ͳһԴļԤ
+ * @param[in]  *pfile : Ԥļ
+ * @param[in]  tu     : Դļ
+ * @param[in]  ms     : Ԥʱ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+static status_t
+hdrcost_parse(const char *pfile,
+        int tu,
+        int ms)
+{
+    int i;
+    int idx;
+    int flag;
+    int depth = 0;
+    int stack[HDRCOST_DEPTH];   /**< ǰ, -1ΪԴļ<built-in> */
+    char tu_name[PATH_BUF_SIZE];
+    char name[PATH_BUF_SIZE];
+    char line[READ_BUF_SIZE];
+    uint64 total = 0;
+    uint32 len;
+    FILE *pfd;
+
+    pfd = fopen(pfile, "r");
+    if (!pfd)
+    {
+        return ERROR;
+    }
+
+    tu_name[0] = 0;
+    stack[0] = -1;
+    while (fgets(line, sizeof(line), pfd))
+    {
+        if (!hdrcost_marker(line, name, sizeof(name), &flag))
+        {
+            len = strlen(line);
+            total += len;
+            for (i = 0; i <= depth; i++)
+            {
+                if ((stack[i] >= 0) && ((i == 0) || (stack[i] != stack[i - 1])))
+                {
+                    the_hdr[stack[i]].tu_bytes += len;
+                }
+            }
+            continue;
+        }
+
+        //б: һΪԴļ
+        if (!tu_name[0])
+        {
+            strncpy(tu_name, name, sizeof(tu_name));
+        }
+        idx = -1;
+        if ((name[0] != '<') && strcmp(name, tu_name))
+        {
+            idx = hdrcost_find(name);
+        }
+        if (flag == 1)
+        {
+            if (depth < HDRCOST_DEPTH - 1)
+            {
+                depth++;
+            }
+            if ((idx >= 0) && (the_hdr[idx].last_tu != tu))
+            {
+                the_hdr[idx].last_tu = tu;
+                the_hdr[idx].tu_bytes = 0;
+                the_hdr[idx].tus++;
+            }
+        }
+        else if ((flag == 2) && (depth > 0))
+        {
+            depth--;
+        }
+        stack[depth] = idx;
+    }
+    fclose(pfd);
+
+    //չֽ̯Ԥʱ
+    for (i = 0; i < the_hdr_num; i++)
+    {
+        if (the_hdr[i].last_tu == tu)
+        {
+            the_hdr[i].bytes += the_hdr[i].tu_bytes;
+            if (total)
+            {
+                the_hdr[i].pp_ms += (double)ms * the_hdr[i].tu_bytes / total;
+            }
+        }
+    }
+
+    return OK;
+}
+
+static int
+hdrcost_bytes_cmp(const void *pa,
+        const void *pb)
+{
+    const hdr_t *pl = pa;
+    const hdr_t *pr = pb;
+
+    return (pl->bytes < pr->bytes) ? 1 : ((pl->bytes > pr->bytes) ? -1 : 0);
+}
+
+static int
+hdrcost_cost_cmp(const void *pa,
+        const void *pb)
+{
+    const hdr_t *pl = pa;
+    const hdr_t *pr = pb;
+
+    return (pl->pp_ms < pr->pp_ms) ? 1 : ((pl->pp_ms > pr->pp_ms) ? -1 : 0);
+}
+
+/**
+ ******************************************************************************
+ * @brief   һͷļ, ʱ
+ * @param[in]  *pcfg  : 
+ * @param[in]  *pbase : ǰ׺
+ * @param[in]  *pname : ͷļ(ΪNULLʱļ, Ϊ׼)
+ *
+ * @retval  >=0 : ʱ(ms, ȡС)
+ * @retval   -1 : ͷļ޷
+ ******************************************************************************
+ */
+static int
+hdrcost_probe(const make_cfg_t *pcfg,
+        const char *pbase,
+        const char *pname)
+{
+    int i;
+    int ms;
+    int min = -1;
+    char tmp[CMD_BUF_SIZE];
+    FILE *pfd;
+
+    snprintf(tmp, sizeof(tmp), "%s/%s", pcfg->BUILD_DIR, HDRCOST_PROBE_C);
+    pfd = fopen(tmp, "w");
+    if (!pfd)
+    {
+        return -1;
+    }
+    if (pname)
+    {
+        fprintf(pfd, "#include \"%s\"\n", pname);
+    }
+    fclose(pfd);
+
+    snprintf(tmp, sizeof(tmp), "%s -fsyntax-only %s >NUL 2>&1", pbase, HDRCOST_PROBE_C);
+    for (i = 0; i < HDRCOST_PROBE_RUNS; i++)
+    {
+        ms = hdrcost_exec(tmp);
+        if (ms < 0)
+        {
+            return -1;
+        }
+        if ((min < 0) || (ms < min))
+        {
+            min = ms;
+        }
+    }
+    return min;
+}
+
+/**
+ ******************************************************************************
+ * @brief   Դļ, ֵò/ͷļ
+ * @param[in]  *pcfg : 
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note    1. ÿԴļִgcc -E, бͳƸͷļİչֽ,
+ *             ֽ̯Ԥʱ
+ *          2. չֽHDRCOST_PROBEͷļٵ-fsyntax-onlyʱ(ο)
+ *          3. ڱĿ¼ִ, makefileʹͬ-I -D
+ ******************************************************************************
+ */
+status_t
+hdrcost_run(const make_cfg_t *pcfg)
+{
+    int i;
+    int j;
+    int ms;
+    int base;
+    int pp_base;
+    char base_cmd[CMD_BUF_SIZE];
+    char tmp[CMD_BUF_SIZE];
+    char path[PATH_BUF_SIZE];
+    char pp[PATH_BUF_SIZE];
+    double total = 0;
+    FILE *preport;
+
+    if (the_tu.num <= 0)
+    {
+        printf("ûҪԴļ\n");
+        return ERROR;
+    }
+
+    //1. ǰ׺(ڱĿ¼ִ)
+    snprintf(base_cmd, sizeof(base_cmd), "cd \"%s\" && %sgcc %s %s%s",
+            pcfg->BUILD_DIR, pcfg->CROSS_COMPILE, pcfg->CCFLAGS, pcfg->OTHER_D, pcfg->I);
+    base = hdrcost_probe(pcfg, base_cmd, NULL);
+    snprintf(tmp, sizeof(tmp), "%s -E %s -o %s", base_cmd, HDRCOST_PROBE_C, HDRCOST_I);
+    pp_base = hdrcost_exec(tmp);
+    if ((base < 0) || (pp_base < 0))
+    {
+        printf("޷ִб: %s\n", base_cmd);
+        return ERROR;
+    }
+
+    //2. ԴļԤ
+    snprintf(pp, sizeof(pp), "%s/%s", pcfg->BUILD_DIR, HDRCOST_I);
+    for (i = 0; i < the_tu.num; i++)
+    {
+        for (j = 0; (j < (int)PATH_BUF_SIZE - 1) && the_tu.pstr[i][j + 3]; j++)
+        {
+            path[j] = (the_tu.pstr[i][j + 3] == '\\') ? '/' : the_tu.pstr[i][j + 3];
+        }
+        path[j] = 0;
+        printf("[%d/%d] %s\n", i + 1, the_tu.num, path);
+        snprintf(tmp, sizeof(tmp), "%s -E \"../%s\" -o %s", base_cmd, path, HDRCOST_I);
+        ms = hdrcost_exec(tmp);
+        if (ms < 0)
+        {
+            printf("Ԥʧ, \n");
+            continue;
+        }
+        total += (ms > pp_base) ? ms - pp_base : 0;
+        hdrcost_parse(pp, i, (ms > pp_base) ? ms - pp_base : 0);
+    }
+    remove(pp);
+
+    //3. չͷļʱ
+    qsort(the_hdr, the_hdr_num, sizeof(hdr_t), hdrcost_bytes_cmp);
+    for (i = 0; (i < HDRCOST_PROBE) && (i < the_hdr_num); i++)
+    {
+        ms = hdrcost_probe(pcfg, base_cmd, the_hdr[i].pname);
+        if (ms >= 0)
+        {
+            the_hdr[i].probe_ms = (ms > base) ? ms - base : 0;
+        }
+    }
+    snprintf(tmp, sizeof(tmp), "%s/%s", pcfg->BUILD_DIR, HDRCOST_PROBE_C);
+    remove(tmp);
+
+    //4. ͳһ̯Ԥʱ, ʱֻο
+    qsort(the_hdr, the_hdr_num, sizeof(hdr_t), hdrcost_cost_cmp);
+    snprintf(tmp, sizeof(tmp), "%s/%s", pcfg->BUILD_DIR, HDRCOST_REPORT);
+    preport = fopen(tmp, "w");
+    if (preport)
+    {
+        fprintf(preport, "#header\ttus\tbytes\tcost_ms\tparse_ms\n");
+    }
+    printf("\n%dԴļ, Ԥ%.0fms, %dͷļ\n", the_tu.num, total, the_hdr_num);
+    printf("%-48s %5s %12s %10s %9s\n", "header", "TUs", "bytes", "cost(ms)", "parse(ms)");
+    for (i = 0; i < the_hdr_num; i++)
+    {
+        if (i < HDRCOST_TOP)
+        {
+            if (the_hdr[i].probe_ms >= 0)
+            {
+                printf("%-48s %5d %12llu %10.0f %9d\n", the_hdr[i].pname, the_hdr[i].tus,
+                        (unsigned long long)the_hdr[i].bytes, the_hdr[i].pp_ms,
+                        the_hdr[i].probe_ms);
+            }
+            else
+            {
+                printf("%-48s %5d %12llu %10.0f %9s\n", the_hdr[i].pname, the_hdr[i].tus,
+                        (unsigned long long)the_hdr[i].bytes, the_hdr[i].pp_ms, "-");
+            }
+        }
+        if (preport)
+        {
+            fprintf(preport, "%s\t%d\t%llu\t%.0f\t%d\n", the_hdr[i].pname, the_hdr[i].tus,
+                    (unsigned long long)the_hdr[i].bytes, the_hdr[i].pp_ms,
+                    the_hdr[i].probe_ms);
+        }
+    }
+    printf("\ncost: չֽ̯Ԥʱ(Դļ֮), "
+            "parse: ͷļһεĺʱ(ο, -Ϊδ)\n");
+    printf(": %s/%s\n", pcfg->BUILD_DIR, HDRCOST_REPORT);
+    if (preport)
+    {
+        fclose(preport);
+    }
+
+    return OK;
+}
+
+/*---------------------------------hdrcost.c---------------------------------*/
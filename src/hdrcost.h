@@ -0,0 +1,50 @@
+/**
+ ******************************************************************************
+ * @file       hdrcost.h
+ * @brief      API include file of hdrcost.h.
+ * @details    This file including all API functions's declare of hdrcost.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef HDRCOST_H_
+#define HDRCOST_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include "types.h"
+#include "param.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern status_t
+hdrcost_add(const char *pfile);
+
+extern status_t
+hdrcost_run(const make_cfg_t *pcfg);
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* HDRCOST_H_ */
+/*-----------------------------End of hdrcost.h------------------------------*/
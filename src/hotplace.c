@@ -0,0 +1,451 @@
+/**
+ ******************************************************************************
+ * @file      hotplace.c
+ * @brief     ݰȵĺŵRAM/ITCM
+ * @details   This file including all API functions's implement of hotplace.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "maths.h"
+#include "param.h"
+#include "os.h"
+#include "symtab.h"
+#include "bench.h"
+#include "hotplace.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** ѡ */
+typedef struct
+{
+    const sym_t *psym;
+    uint64 heat;                /**< ָô */
+    double density;             /**< ÿֽڵheat */
+} hot_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+/** ֮ǰͻеĺ, ܷŵRAM */
+#define HOTPLACE_SKIP       "|Reset_Handler|SystemInit|__libc_init_array|ramfunc_init|"
+#define HOTPLACE_TOP        (40)            /**< Ļĺ */
+
+/** ·С */
+#define PATH_BUF_SIZE       (512u)
+
+/** ļС */
+#define READ_BUF_SIZE       (1024u)
+
+/** ƴ: ʼ.data/.bss, 캯main֮ǰ */
+#define HOTPLACE_SRC                                                            \
+    "/* Automatically-generated file. Do not edit! by AutoMake -hotplace */\n"  \
+    "#include <stdint.h>\n\n"                                                   \
+    "extern uint32_t __ramfunc_start__[];\n"                                    \
+    "extern uint32_t __ramfunc_end__[];\n"                                      \
+    "extern uint32_t __ramfunc_load__[];\n\n"                                   \
+    "__attribute__((no_instrument_function))\n"                                 \
+    "static void ramfunc_init(void)\n"                                          \
+    "{\n"                                                                       \
+    "    const uint32_t *src = __ramfunc_load__;\n"                             \
+    "    uint32_t *dst = __ramfunc_start__;\n\n"                                \
+    "    while (dst < __ramfunc_end__) {\n"                                     \
+    "        *dst++ = *src++;\n"                                                \
+    "    }\n"                                                                   \
+    "    __asm volatile (\"dsb\\n\\tisb\" ::: \"memory\");\n"                   \
+    "}\n\n"                                                                     \
+    "/* __libc_init_array runs .preinit_array first */\n"                       \
+    "__attribute__((used, section(\".preinit_array\")))\n"                      \
+    "static void (*const ramfunc_init_p)(void) = ramfunc_init;\n"
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   ɰƴ
+ * @param[in]  *pfile : ļ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+status_t
+hotplace_src_create(const char *pfile)
+{
+    return os_fupdate(pfile, HOTPLACE_SRC, strlen(HOTPLACE_SRC));
+}
+
+/**
+ ******************************************************************************
+ * @brief   ÿֽڵheatȽ(qsortʹ)
+ ******************************************************************************
+ */
+static int
+hot_cmp(const void *pa,
+        const void *pb)
+{
+    const hot_t *pl = pa;
+    const hot_t *pr = pb;
+
+    if (pl->density != pr->density)
+    {
+        return (pl->density < pr->density) ? 1 : -1;
+    }
+    return (pl->heat < pr->heat) ? 1 : ((pl->heat > pr->heat) ? -1 : 0);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ִСдӴ
+ ******************************************************************************
+ */
+static bool_e
+hotplace_has(const char *pstr,
+        const char *psub)
+{
+    int i;
+    int n = strlen(psub);
+
+    for (; *pstr; pstr++)
+    {
+        for (i = 0; (i < n) && pstr[i]
+                && ((pstr[i] | 0x20) == (psub[i] | 0x20)); i++)
+        {
+        }
+        if (i == n)
+        {
+            return E_TRUE;
+        }
+    }
+    return E_FALSE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ӽűMEMORYѡм
+ * @param[in]  *pld    : ӽű
+ * @param[out] *pram   : (ITCMʱ, һд)
+ * @param[out] *pflash : (һִед)
+ * @param[in]  len     : 泤
+ *
+ * @return  None(ҲʱΪRAMFLASH)
+ *
+ * @note    MEMORY { FLASH (rx) : ORIGIN = 0x08000000, LENGTH = 256K ... }
+ ******************************************************************************
+ */
+static void
+hotplace_regions(const char *pld,
+        char *pram,
+        char *pflash,
+        int len)
+{
+    int n;
+    uint32 size;
+    bool_e itcm = E_FALSE;
+    bool_e ram = E_FALSE;
+    bool_e flash = E_FALSE;
+    const char *p;
+    const char *pend;
+    const char *paddr;
+    char name[64];
+    char attr[16];
+
+    snprintf(pram, len, "RAM");
+    snprintf(pflash, len, "FLASH");
+    paddr = os_fmap(pld, &size);
+    if (!paddr)
+    {
+        return;
+    }
+    pend = paddr + size;
+    for (p = paddr; (p + 6 < pend) && strncmp(p, "MEMORY", 6); p++)
+    {
+    }
+    for (; (p < pend) && (*p != '{'); p++)
+    {
+    }
+
+    //ÿ:  () : ORIGIN = ..., LENGTH = ...
+    while ((p < pend) && (*p != '}'))
+    {
+        for (p++; (p < pend) && (isspace(*p) || (*p == ',')); p++)
+        {
+        }
+        for (n = 0; (p < pend) && ((*p == '_') || isdigit(*p) || (((*p | 0x20) >= 'a') && ((*p | 0x20) <= 'z')));
+                p++)
+        {
+            if (n < (int)sizeof(name) - 1)
+            {
+                name[n++] = *p;
+            }
+        }
+        name[n] = 0;
+        for (; (p < pend) && ((*p == ' ') || (*p == '\t')); p++)
+        {
+        }
+        attr[0] = 0;
+        if ((p < pend) && (*p == '('))
+        {
+            for (p++, n = 0; (p < pend) && (*p != ')'); p++)
+            {
+                if (n < (int)sizeof(attr) - 1)
+                {
+                    attr[n++] = *p | 0x20;
+                }
+            }
+            attr[n] = 0;
+        }
+        if (name[0] && attr[0])
+        {
+            if (!itcm && hotplace_has(name, "ITCM"))
+            {
+                snprintf(pram, len, "%s", name);
+                itcm = E_TRUE;
+                ram = E_TRUE;
+            }
+            else if (!ram && strchr(attr, 'w'))
+            {
+                snprintf(pram, len, "%s", name);
+                ram = E_TRUE;
+            }
+            else if (!flash && strchr(attr, 'x') && !strchr(attr, 'w'))
+            {
+                snprintf(pflash, len, "%s", name);
+                flash = E_TRUE;
+            }
+        }
+        for (; (p < pend) && (*p != '\n') && (*p != '}'); p++)
+        {
+        }
+    }
+    os_funmap(paddr);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȡ, ÿ"\tֵ[\t...]"
+ * @param[in]  *ptab  : ű
+ * @param[in]  *pprof : ļ
+ * @param[out] *phot  : ѡ(űһһӦ, heatۼ)
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ļ
+ *
+ * @note    bench_prof.txtֵΪָ, trace.txtΪô
+ ******************************************************************************
+ */
+static status_t
+hotplace_prof_load(const symtab_t *ptab,
+        const char *pprof,
+        hot_t *phot)
+{
+    unsigned long long heat;
+    char line[READ_BUF_SIZE];
+    char name[READ_BUF_SIZE];
+    const sym_t *psym;
+    FILE *pfd;
+
+    pfd = fopen(pprof, "r");
+    if (!pfd)
+    {
+        return ERROR;
+    }
+    while (fgets(line, sizeof(line), pfd))
+    {
+        if ((line[0] == '#') || (sscanf(line, "%1023[^\t]\t%llu", name, &heat) != 2))
+        {
+            continue;
+        }
+        psym = symtab_find_name(ptab, name);
+        if (psym)
+        {
+            phot[psym - ptab->psym].heat += heat;
+        }
+    }
+    fclose(pfd);
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ѡȵĺ, ӽűƬhot.ld
+ * @param[in]  *pcfg   : 
+ * @param[in]  budget  : RAMԤ(ֽ), 0ʾȡ
+ * @param[in]  *pprof  : (NULLʱ-benchɵbench_prof.txt)
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note    1. -ffunction-sections: foo.text.foo, øԴ.
+ *             Դ__attribute__((section(".ramfunc")))ǵĺҲ
+ *          2. ÿֽڵheatӸߵѡȡ, ֱԤ(תveneer)
+ *          3. hot.ldINSERT BEFORE .textԭӽű, .text*ƥ;
+ *             еַRAM(ITCM), صַFLASH, _hot/ramfunc.c
+ ******************************************************************************
+ */
+status_t
+hotplace_run(const make_cfg_t *pcfg,
+        uint32 budget,
+        const char *pprof)
+{
+    int i;
+    int num = 0;
+    int cnt = 0;
+    int len;
+    int max;
+    uint32 used = 0;
+    uint32 size;
+    uint64 total = 0;
+    uint64 heat = 0;
+    char tmp[PATH_BUF_SIZE];
+    char prof[PATH_BUF_SIZE];
+    char ram[64];
+    char flash[64];
+    hot_t *phot = NULL;
+    char *pbuf = NULL;
+    symtab_t tab;
+    status_t ret = ERROR;
+
+    snprintf(tmp, sizeof(tmp), "%s/%s", pcfg->BUILD_DIR, HOTPLACE_LD);
+    if (!budget)
+    {
+        remove(tmp);
+        printf("ȡȵ㺯RAM\n");
+        return OK;
+    }
+
+    snprintf(tmp, sizeof(tmp), "%s/%s.elf", pcfg->BUILD_DIR, pcfg->APP);
+    if (OK != symtab_load(&tab, pcfg->CROSS_COMPILE, tmp))
+    {
+        printf("ȱ: %s\n", tmp);
+        return ERROR;
+    }
+
+    do
+    {
+        //1. 
+        if (pprof)
+        {
+            snprintf(prof, sizeof(prof), "%s", pprof);
+        }
+        else
+        {
+            snprintf(prof, sizeof(prof), "%s/%s", pcfg->BUILD_DIR, BENCH_PROFILE);
+        }
+        phot = calloc(tab.num, sizeof(hot_t));
+        if (!phot)
+        {
+            break;
+        }
+        if (OK != hotplace_prof_load(&tab, prof, phot))
+        {
+            printf("Ҳ: %s(-bench, ָ-tracetrace.txt)\n", prof);
+            break;
+        }
+
+        //2. ÿֽڵheat
+        for (i = 0; i < tab.num; i++)
+        {
+            total += phot[i].heat;
+            snprintf(tmp, sizeof(tmp), "|%s|", tab.psym[i].pname);
+            if (!phot[i].heat || !tab.psym[i].size || strstr(HOTPLACE_SKIP, tmp))
+            {
+                continue;
+            }
+            phot[num].psym = &tab.psym[i];
+            phot[num].heat = phot[i].heat;
+            phot[num].density = (double)phot[i].heat / tab.psym[i].size;
+            num++;
+        }
+        qsort(phot, num, sizeof(hot_t), hot_cmp);
+
+        //3. hot.ld(ڴ, ݲʱд, ÿζ)
+        hotplace_regions(pcfg->LD, ram, flash, sizeof(ram));
+        max = PATH_BUF_SIZE + 1024;
+        for (i = 0; i < num; i++)
+        {
+            max += strlen(phot[i].psym->pname) + 16;
+        }
+        pbuf = malloc(max);
+        if (!pbuf)
+        {
+            break;
+        }
+        len = snprintf(pbuf, max, "/* Automatically-generated file. Do not edit! by AutoMake -hotplace */\n"
+                "/* profile: %s, budget: %u bytes */\n"
+                "SECTIONS\n"
+                "{\n"
+                "    .ramfunc :\n"
+                "    {\n"
+                "        . = ALIGN(4);\n"
+                "        __ramfunc_start__ = .;\n"
+                "        *(.ramfunc .ramfunc.*)\n", prof, budget);
+        printf("%-40s %12s %8s %10s\n", "function", "heat", "size", "heat/byte");
+        for (i = 0; i < num; i++)
+        {
+            size = (phot[i].psym->size + 3) & ~3u;
+            if (used + size > budget)
+            {
+                continue; //Сĺܻŵ
+            }
+            used += size;
+            heat += phot[i].heat;
+            len += sprintf(pbuf + len, "        *(.text.%s)\n", phot[i].psym->pname);
+            if (cnt++ < HOTPLACE_TOP)
+            {
+                printf("%-40s %12llu %8u %10.1f\n", phot[i].psym->pname,
+                        (unsigned long long)phot[i].heat, phot[i].psym->size, phot[i].density);
+            }
+        }
+        len += snprintf(pbuf + len, max - len, "        . = ALIGN(4);\n"
+                "        __ramfunc_end__ = .;\n"
+                "    } > %s AT > %s\n"
+                "    __ramfunc_load__ = LOADADDR(.ramfunc);\n"
+                "}\n"
+                "INSERT BEFORE .text;\n", ram, flash);
+        snprintf(tmp, sizeof(tmp), "%s/%s", pcfg->BUILD_DIR, HOTPLACE_LD);
+        if (OK != os_fupdate(tmp, pbuf, len))
+        {
+            printf("޷д: %s\n", tmp);
+            break;
+        }
+
+        printf("\n%d%uֽڷ%s(Ԥ%uֽ), ռݵ%.1f%%\n", cnt, used, ram,
+                budget, total ? heat * 100.0 / total : 0.0);
+        printf("ӽűƬ: %s/%s\n", pcfg->BUILD_DIR, HOTPLACE_LD);
+        ret = OK;
+    } while (0);
+
+    free(pbuf);
+    free(phot);
+    symtab_free(&tab);
+
+    return ret;
+}
+
+/*--------------------------------hotplace.c---------------------------------*/
@@ -0,0 +1,53 @@
+/**
+ ******************************************************************************
+ * @file       hotplace.h
+ * @brief      API include file of hotplace.h.
+ * @details    This file including all API functions's declare of hotplace.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef HOTPLACE_H_
+#define HOTPLACE_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include "types.h"
+#include "param.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#define HOTPLACE_LD         "hot.ld"    /**< ӽűƬ(Ŀ¼), ʱ */
+#define HOTPLACE_DIR        "_hot"      /**< ƴڱĿ¼еλ */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern status_t
+hotplace_run(const make_cfg_t *pcfg,
+        uint32 budget,
+        const char *pprof);
+
+extern status_t
+hotplace_src_create(const char *pfile);
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* HOTPLACE_H_ */
+/*-----------------------------End of hotplace.h-----------------------------*/
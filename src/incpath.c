@@ -0,0 +1,771 @@
+/**
+ ******************************************************************************
+ * @file      incpath.c
+ * @brief     ͳƸ-IĿ¼ͷļмδд, ˳
+ * @details   This file including all API functions's implement of incpath.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "types.h"
+#include "param.h"
+#include "os.h"
+#include "hash.h"
+#include "incpath.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** ļͷļ(һŹϣ) */
+typedef struct
+{
+    char *pname;
+    int last_tu;                /**< һμԴļ */
+    uint64 mask;                /**< ͷļ: иļ-IĿ¼ */
+    int refs;                   /**< ͷļ: -IĿ¼ҵĴ(ÿԴļһ) */
+    int *pedge;                 /**< ļ: ϵ, ÿΪ(ͷļ±, ļ±), -1ʾ */
+    int edge_num;
+    int edge_max;
+} inc_ent_t;
+
+/** : ƾidx, pent֮һһӦ */
+typedef struct
+{
+    inc_ent_t *pent;
+    int num;
+    int max;
+    hash_idx_t idx;
+} inc_tab_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+#define INCPATH_REPORT      "incpath.txt"   /**<  */
+#define INCPATH_MAX_DIRS    (64)            /**< -IĿ¼ */
+
+/** ·С */
+#define PATH_BUF_SIZE       (512u)
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static inc_tab_t the_files;     /**< Դļ(ǰthe_tu_num)ͷļ */
+static int the_tu_num;
+static inc_tab_t the_names;     /**< Ҫ-IĿ¼вҵͷļ */
+static int the_macro;           /**< #include, ޷̬ */
+
+static char *the_dir[INCPATH_MAX_DIRS]; /**< -IĿ¼(ԴĿ¼) */
+static int the_dir_num;
+static int the_hits[INCPATH_MAX_DIRS];
+static int the_misses[INCPATH_MAX_DIRS];
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   ұ, ½
+ * @param[in]  *pt    : ϣ
+ * @param[in]  *pname : 
+ *
+ * @retval  >=0 : ±
+ * @retval   -1 : ڴ治
+ ******************************************************************************
+ */
+static int
+inc_find(inc_tab_t *pt,
+        const char *pname)
+{
+    int i;
+    inc_ent_t *pent;
+
+    //1. ȱ֤pentпλ, һžͱжӦ
+    if (pt->num == pt->max)
+    {
+        i = pt->max ? pt->max * 2 : 256;
+        pent = realloc(pt->pent, i * sizeof(inc_ent_t));
+        if (!pent)
+        {
+            return -1;
+        }
+        pt->pent = pent;
+        pt->max = i;
+    }
+
+    //2. , ʼ
+    i = hash_idx_find(&pt->idx, pname, E_TRUE);
+    if ((i < 0) || (i < pt->num))
+    {
+        return i;
+    }
+    pent = &pt->pent[i];
+    memset(pent, 0x00, sizeof(*pent));
+    pent->pname = pt->idx.pstr[i];
+    pent->last_tu = -1;
+
+    return pt->num++;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ƴӲ·: '\''/', ȥ".""xx/.."
+ * @param[out] *pout  : ·
+ * @param[in]  len    : 泤
+ * @param[in]  *pdir  : Ŀ¼(Ϊմ)
+ * @param[in]  *pname : ļ
+ *
+ * @return  None
+ ******************************************************************************
+ */
+static void
+incpath_join(char *pout,
+        int len,
+        const char *pdir,
+        const char *pname)
+{
+    int i;
+    int n = 0;
+    int seg;
+    char *p;
+    char tmp[PATH_BUF_SIZE];
+
+    snprintf(tmp, sizeof(tmp), "%s%s%s", pdir, pdir[0] ? "/" : "", pname);
+    for (p = tmp; *p; p++)
+    {
+        if (*p == '\\')
+        {
+            *p = '/';
+        }
+    }
+
+    pout[0] = 0;
+    if (tmp[0] == '/')
+    {
+        pout[n++] = '/';
+        pout[n] = 0;
+    }
+    for (p = tmp; *p; p += p[i] ? i + 1 : i)
+    {
+        for (i = 0; p[i] && (p[i] != '/'); i++)
+        {
+        }
+        if ((i == 0) || ((i == 1) && (p[0] == '.')))
+        {
+            continue;
+        }
+        if ((i == 2) && (p[0] == '.') && (p[1] == '.') && (n > 0))
+        {
+            for (seg = n; (seg > 0) && (pout[seg - 1] != '/'); seg--)
+            {
+            }
+            if ((seg < n) && strcmp(pout + seg, ".."))
+            {
+                n = (seg > 1) ? seg - 1 : seg; //ȥһ
+                pout[n] = 0;
+                continue;
+            }
+        }
+        if (n + i + 2 > len)
+        {
+            break;
+        }
+        if (n && (pout[n - 1] != '/'))
+        {
+            pout[n++] = '/';
+        }
+        memcpy(pout + n, p, i);
+        n += i;
+        pout[n] = 0;
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   жļǷ
+ ******************************************************************************
+ */
+static bool_e
+incpath_exists(const char *pfile)
+{
+    struct _stat buf;
+
+    return (!_stat(pfile, &buf) && !(buf.st_mode & _S_IFDIR)) ? E_TRUE : E_FALSE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   һԴļ(ԴĿ¼ʱ)
+ * @param[in]  *pfile : Դļ(ͬsubdir_mk_create·ʽ)
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+status_t
+incpath_add(const char *pfile)
+{
+    int len = strlen(pfile);
+    char tmp[PATH_BUF_SIZE];
+
+    if ((len < 2) || strcmp(pfile + len - 2, ".c"))
+    {
+        return OK; //ֻcļ
+    }
+    incpath_join(tmp, sizeof(tmp), "", pfile + 3); //ǰ3ַ"./\"
+    if (inc_find(&the_files, tmp) < 0)
+    {
+        return ERROR;
+    }
+    the_tu_num = the_files.num;
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ¼һϵ
+ * @param[in]  idx  : ļ±
+ * @param[in]  name : ͷļ±(-1ʾڵǰĿ¼ҵ)
+ * @param[in]  file : ļ±(-1ʾûҵ)
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ڴ治
+ ******************************************************************************
+ */
+static status_t
+incpath_edge_add(int idx,
+        int name,
+        int file)
+{
+    int *pnew;
+    inc_ent_t *pent = &the_files.pent[idx];
+
+    if (pent->edge_num == pent->edge_max)
+    {
+        pent->edge_max = pent->edge_max ? pent->edge_max * 2 : 16;
+        pnew = realloc(pent->pedge, pent->edge_max * 2 * sizeof(int));
+        if (!pnew)
+        {
+            return ERROR;
+        }
+        pent->pedge = pnew;
+    }
+    pent->pedge[pent->edge_num * 2] = name;
+    pent->pedge[pent->edge_num * 2 + 1] = file;
+    pent->edge_num++;
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   gccĹһ#include
+ * @param[in]  idx    : ļ±
+ * @param[in]  *pname : ͷļ
+ * @param[in]  quote  : ǷΪ#include "..."
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ڴ治
+ *
+ * @note    "..."ļĿ¼, Ҹ-IĿ¼; <...>ֻ-IĿ¼.
+ *          -IĿ¼Ƿиļֻжһ, the_names
+ ******************************************************************************
+ */
+static status_t
+incpath_resolve(int idx,
+        const char *pname,
+        bool_e quote)
+{
+    int d;
+    int name;
+    int file;
+    char *p;
+    char dir[PATH_BUF_SIZE];
+    char tmp[PATH_BUF_SIZE];
+
+    //1. Ŀ¼
+    if (quote)
+    {
+        strncpy(dir, the_files.pent[idx].pname, sizeof(dir) - 1);
+        dir[sizeof(dir) - 1] = 0;
+        p = strrchr(dir, '/');
+        if (p)
+        {
+            *p = 0;
+        }
+        else
+        {
+            dir[0] = 0;
+        }
+        incpath_join(tmp, sizeof(tmp), dir, pname);
+        if (incpath_exists(tmp))
+        {
+            file = inc_find(&the_files, tmp);
+            return (file < 0) ? ERROR : incpath_edge_add(idx, -1, file);
+        }
+    }
+
+    //2. -IĿ¼
+    d = the_names.num;
+    name = inc_find(&the_names, pname);
+    if (name < 0)
+    {
+        return ERROR;
+    }
+    if (name == d) //һ, Ŀ¼ж
+    {
+        for (d = 0; d < the_dir_num; d++)
+        {
+            incpath_join(tmp, sizeof(tmp), the_dir[d], pname);
+            if (incpath_exists(tmp))
+            {
+                the_names.pent[name].mask |= (uint64)1 << d;
+            }
+        }
+    }
+    file = -1;
+    for (d = 0; d < the_dir_num; d++)
+    {
+        if (the_names.pent[name].mask & ((uint64)1 << d))
+        {
+            incpath_join(tmp, sizeof(tmp), the_dir[d], pname);
+            file = inc_find(&the_files, tmp);
+            if (file < 0)
+            {
+                return ERROR;
+            }
+            break;
+        }
+    }
+
+    return incpath_edge_add(idx, name, file);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ҳһļе#include()
+ * @param[in]  idx : ļ±
+ *
+ * @retval  OK    : ɹ(ļҲOK)
+ * @retval  ERROR : ڴ治
+ ******************************************************************************
+ */
+static status_t
+incpath_scan(int idx)
+{
+    int n;
+    uint32 size;
+    char end;
+    const char *p;
+    const char *pend;
+    const char *paddr;
+    char name[PATH_BUF_SIZE];
+    status_t ret = OK;
+
+    paddr = os_fmap(the_files.pent[idx].pname, &size);
+    if (!paddr)
+    {
+        return OK;
+    }
+
+    pend = paddr + size;
+    for (p = paddr; (OK == ret) && (p < pend); )
+    {
+        //# include
+        while ((p < pend) && ((*p == ' ') || (*p == '\t')))
+        {
+            p++;
+        }
+        if ((p < pend) && (*p == '#'))
+        {
+            for (p++; (p < pend) && ((*p == ' ') || (*p == '\t')); p++)
+            {
+            }
+            if ((pend - p > 7) && !strncmp(p, "include", 7)
+                    && ((p[7] == ' ') || (p[7] == '\t') || (p[7] == '"') || (p[7] == '<')))
+            {
+                for (p += 7; (p < pend) && ((*p == ' ') || (*p == '\t')); p++)
+                {
+                }
+                end = 0;
+                if (p < pend)
+                {
+                    end = (*p == '"') ? '"' : ((*p == '<') ? '>' : 0);
+                }
+                if (end)
+                {
+                    for (p++, n = 0; (p < pend) && (*p != end) && (*p != '\n')
+                            && (n < (int)sizeof(name) - 1); p++)
+                    {
+                        name[n++] = *p;
+                    }
+                    name[n] = 0;
+                    if ((p < pend) && (*p == end) && n)
+                    {
+                        ret = incpath_resolve(idx, name, (end == '"') ? E_TRUE : E_FALSE);
+                    }
+                }
+                else
+                {
+                    the_macro++;
+                }
+            }
+        }
+        //һ
+        while ((p < pend) && (*p != '\n'))
+        {
+            p++;
+        }
+        p++;
+    }
+    os_funmap(paddr);
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȡ-IĿ¼: -I"../app/inc" -> app/inc
+ * @param[in]  *pcfg : 
+ *
+ * @return  Ŀ¼(INCPATH_MAX_DIRSĲ)
+ ******************************************************************************
+ */
+static int
+incpath_dirs(const make_cfg_t *pcfg)
+{
+    int n;
+    int total = 0;
+    const char *p;
+    char tmp[PATH_BUF_SIZE];
+    char dir[PATH_BUF_SIZE];
+
+    the_dir_num = 0;
+    for (p = strstr(pcfg->I, "-I\""); p; p = strstr(p, "-I\""))
+    {
+        for (p += 3, n = 0; *p && (*p != '"') && (n < (int)sizeof(tmp) - 1); p++)
+        {
+            tmp[n++] = *p;
+        }
+        tmp[n] = 0;
+        total++;
+        if (the_dir_num < INCPATH_MAX_DIRS)
+        {
+            //Ŀ¼µ"../"ԴĿ¼
+            incpath_join(dir, sizeof(dir), "", strncmp(tmp, "../", 3) ? tmp : tmp + 3);
+            the_dir[the_dir_num] = strdup(dir);
+            if (the_dir[the_dir_num])
+            {
+                the_dir_num++;
+            }
+        }
+    }
+
+    return total;
+}
+
+/**
+ ******************************************************************************
+ * @brief   Դļذϵ: ͬһԴļͬͷļֻһ
+ *          (gccһ뵥Ԫڻҽ)
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ڴ治
+ ******************************************************************************
+ */
+static status_t
+incpath_count(void)
+{
+    int i;
+    int tu;
+    int sp;
+    int f;
+    int name;
+    int file;
+    int *pstack;
+
+    pstack = malloc((the_files.num + 1) * sizeof(int));
+    if (!pstack)
+    {
+        return ERROR;
+    }
+    for (tu = 0; tu < the_tu_num; tu++)
+    {
+        sp = 0;
+        pstack[sp++] = tu;
+        the_files.pent[tu].last_tu = tu;
+        while (sp > 0)
+        {
+            f = pstack[--sp];
+            for (i = 0; i < the_files.pent[f].edge_num; i++)
+            {
+                name = the_files.pent[f].pedge[i * 2];
+                file = the_files.pent[f].pedge[i * 2 + 1];
+                if ((name >= 0) && (the_names.pent[name].last_tu != tu))
+                {
+                    the_names.pent[name].last_tu = tu;
+                    the_names.pent[name].refs++;
+                }
+                if ((file >= 0) && (the_files.pent[file].last_tu != tu))
+                {
+                    the_files.pent[file].last_tu = tu;
+                    pstack[sp++] = file;
+                }
+            }
+        }
+    }
+    free(pstack);
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ͷļĸ-IĿ¼(һĿ¼)
+ *
+ * @retval  >=0 : Ŀ¼
+ * @retval   -1 : -IĿ¼жû(ϵͳͷļ)
+ ******************************************************************************
+ */
+static int
+incpath_first(uint64 mask)
+{
+    int d;
+
+    for (d = 0; d < the_dir_num; d++)
+    {
+        if (mask & ((uint64)1 << d))
+        {
+            return d;
+        }
+    }
+    return -1;
+}
+
+/**
+ ******************************************************************************
+ * @brief   Դļ#include, -IĿ¼/δд˳
+ * @param[in]  *pcfg : 
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note    1. ̬ɨ#include(, ֻ), gccĹ
+ *             Ŀ¼-IĿ¼в, 뵥ԪۼƲҴ
+ *          2. ˳뱣ÿͷļĽ: Ŀ¼dͷļ
+ *             Ŀ¼eҲ, deǰ. ԼʱдӶൽ
+ *          3. δеĿ¼ɾ, Ӱ
+ ******************************************************************************
+ */
+status_t
+incpath_run(const make_cfg_t *pcfg)
+{
+    int i;
+    int d;
+    int e;
+    int best;
+    int first;
+    int total;
+    int num = 0;
+    int unresolved = 0;
+    int order[INCPATH_MAX_DIRS];
+    int pos[INCPATH_MAX_DIRS];
+    uint64 pred[INCPATH_MAX_DIRS];
+    uint64 used = 0;
+    uint64 placed = 0;
+    uint64 probes_old = 0;
+    uint64 probes_new = 0;
+    char tmp[PATH_BUF_SIZE];
+    const char *p;
+    inc_ent_t *pn;
+    FILE *preport;
+
+    if (the_tu_num <= 0)
+    {
+        printf("ûҪԴļ\n");
+        return ERROR;
+    }
+    total = incpath_dirs(pcfg);
+    if (the_dir_num <= 0)
+    {
+        printf("û-IĿ¼\n");
+        return ERROR;
+    }
+    if (total > the_dir_num)
+    {
+        printf("-IĿ¼%d, ֻǰ%d\n", INCPATH_MAX_DIRS, INCPATH_MAX_DIRS);
+    }
+
+    //1. ɨԴļͷļ(ɨлļ)
+    for (i = 0; i < the_files.num; i++)
+    {
+        if (OK != incpath_scan(i))
+        {
+            printf("ڴ治\n");
+            return ERROR;
+        }
+    }
+    if (OK != incpath_count())
+    {
+        printf("ڴ治\n");
+        return ERROR;
+    }
+
+    //2. Ŀ¼/δд, ˳Լ
+    memset(the_hits, 0x00, sizeof(the_hits));
+    memset(the_misses, 0x00, sizeof(the_misses));
+    memset(pred, 0x00, sizeof(pred));
+    for (i = 0; i < the_names.num; i++)
+    {
+        pn = &the_names.pent[i];
+        if (pn->refs <= 0)
+        {
+            continue;
+        }
+        first = incpath_first(pn->mask);
+        if (first < 0)
+        {
+            unresolved += pn->refs;
+            probes_old += (uint64)the_dir_num * pn->refs;
+            for (d = 0; d < the_dir_num; d++)
+            {
+                the_misses[d] += pn->refs;
+            }
+            continue;
+        }
+        the_hits[first] += pn->refs;
+        probes_old += (uint64)(first + 1) * pn->refs;
+        for (d = 0; d < first; d++)
+        {
+            the_misses[d] += pn->refs;
+        }
+        for (e = first + 1; e < the_dir_num; e++)
+        {
+            if (pn->mask & ((uint64)1 << e))
+            {
+                pred[e] |= (uint64)1 << first; //ͬͷļ, firstҪeǰ
+            }
+        }
+    }
+
+    //3. Լʱжǰ, ûеɾ
+    for (d = 0; d < the_dir_num; d++)
+    {
+        pos[d] = -1;
+        if (the_hits[d] > 0)
+        {
+            used |= (uint64)1 << d;
+        }
+    }
+    while (placed != used)
+    {
+        best = -1;
+        for (d = 0; d < the_dir_num; d++)
+        {
+            if (!(used & ((uint64)1 << d)) || (placed & ((uint64)1 << d))
+                    || (pred[d] & used & ~placed))
+            {
+                continue;
+            }
+            if ((best < 0) || (the_hits[d] > the_hits[best]))
+            {
+                best = d;
+            }
+        }
+        if (best < 0)
+        {
+            break; //Լԭ˳, ɻ
+        }
+        pos[best] = num;
+        order[num++] = best;
+        placed |= (uint64)1 << best;
+    }
+    for (i = 0; i < the_names.num; i++)
+    {
+        pn = &the_names.pent[i];
+        first = incpath_first(pn->mask);
+        if (pn->refs > 0)
+        {
+            probes_new += (uint64)((first < 0) ? num : pos[first] + 1) * pn->refs;
+        }
+    }
+
+    //4. 
+    snprintf(tmp, sizeof(tmp), "%s/%s", pcfg->BUILD_DIR, INCPATH_REPORT);
+    preport = fopen(tmp, "w");
+    if (preport)
+    {
+        fprintf(preport, "#dir\thits\tmisses\tnew_pos\n");
+    }
+    printf("\n%dԴļ, %dļ, %dͷļ-IĿ¼(%dδҵ, ϵͳͷļ)",
+            the_tu_num, the_files.num, the_names.num, unresolved);
+    if (the_macro)
+    {
+        printf(", %d#includeδ", the_macro);
+    }
+    printf("\n%-40s %8s %8s %6s\n", "-I", "hits", "misses", "new");
+    for (d = 0; d < the_dir_num; d++)
+    {
+        printf("%-40s %8d %8d %6s\n", the_dir[d], the_hits[d], the_misses[d],
+                (pos[d] < 0) ? "-" : (snprintf(tmp, sizeof(tmp), "%d", pos[d] + 1), tmp));
+        if (preport)
+        {
+            fprintf(preport, "%s\t%d\t%d\t%d\n", the_dir[d], the_hits[d], the_misses[d], pos[d] + 1);
+        }
+    }
+    printf("\nҴ(ÿ뵥Ԫÿͷļһ): %llu -> %llu\n",
+            (unsigned long long)probes_old, (unsigned long long)probes_new);
+    printf(": I = ");
+    for (i = 0; i < num; i++)
+    {
+        printf("%s%s", i ? "|" : "", the_dir[order[i]]);
+    }
+    //ΧĿ¼
+    for (p = pcfg->I, i = 0; (p = strstr(p, "-I\"")) != NULL; p += 3, i++)
+    {
+        if (i >= the_dir_num)
+        {
+            printf("|%.*s", (int)strcspn(p + 6, "\""), p + 6);
+        }
+    }
+    printf("\n");
+    if (num < the_dir_num)
+    {
+        printf("δ, ɾ:");
+        for (d = 0; d < the_dir_num; d++)
+        {
+            if (pos[d] < 0)
+            {
+                printf(" %s", the_dir[d]);
+            }
+        }
+        printf("\n");
+    }
+    printf(": %s/%s\n", pcfg->BUILD_DIR, INCPATH_REPORT);
+    if (preport)
+    {
+        fclose(preport);
+    }
+
+    return OK;
+}
+
+/*---------------------------------incpath.c---------------------------------*/
@@ -0,0 +1,50 @@
+/**
+ ******************************************************************************
+ * @file       incpath.h
+ * @brief      API include file of incpath.h.
+ * @details    This file including all API functions's declare of incpath.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef INCPATH_H_
+#define INCPATH_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include "types.h"
+#include "param.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern status_t
+incpath_add(const char *pfile);
+
+extern status_t
+incpath_run(const make_cfg_t *pcfg);
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* INCPATH_H_ */
+/*-----------------------------End of incpath.h------------------------------*/
@@ -30,6 +30,14 @@
 # define DEFAULT_INI_FILE   "./AutoMake.ini"
 #endif
 
+/** ĬϷ, {ELF}滻Ϊ̼, {LOG}滻Ϊָ־ */
+#define DEFAULT_BENCH_SIM   "qemu-system-arm -M lm3s6965evb -nographic -semihosting " \
+                            "-icount shift=0 -accel tcg,one-insn-per-tb=on " \
+                            "-d exec,nochain -D \"{LOG}\" -kernel \"{ELF}\""
+#define DEFAULT_BENCH_CPI   "1.0"
+#define DEFAULT_MAKE        "cs-make"
+#define DEFAULT_STORE       "./_prebuilt"
+
 /*-----------------------------------------------------------------------------
  Section: Global Variables
  ----------------------------------------------------------------------------*/
@@ -54,6 +62,61 @@ cproject_cfg_get(pcfg_t *pcfg);
 /*-----------------------------------------------------------------------------
  Section: Function Definitions
  ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   (гȲ, ʱ, ض)
+ * @param[in]  *pkey : 
+ * @param[in]  *pstr : ֵ
+ * @param[out] *pout : ַ
+ * @param[in]  len   : 泤
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ڻ
+ ******************************************************************************
+ */
+static status_t
+ini_copy(const char *pkey,
+        const char *pstr,
+        char *pout,
+        int len)
+{
+    if (pstr == NULL)
+    {
+        return ERROR;
+    }
+    if (strlen(pstr) >= (size_t)len)
+    {
+        printf("%s(%dַ, %dַ)!\n", pkey, (int)strlen(pstr), len - 1);
+        return ERROR;
+    }
+    strcpy(pout, pstr);
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȡѡ(ʱʹĬֵ)
+ * @param[in]  *pini : iniֵ
+ * @param[in]  *pkey : 
+ * @param[in]  *pdef : Ĭֵ
+ * @param[out] *pout : ַ
+ * @param[in]  len   : 泤
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : 
+ ******************************************************************************
+ */
+static status_t
+ini_get_opt(dictionary *pini,
+        const char *pkey,
+        const char *pdef,
+        char *pout,
+        int len)
+{
+    return ini_copy(pkey, iniparser_getstring(pini, (char *)pkey, (char *)pdef), pout, len);
+}
+
 /**
  ******************************************************************************
  * @brief   Ĭļ
@@ -104,6 +167,30 @@ create_example_ini_file(pcfg_t *pinfo)
 
             "#·(|ָ)\n"
             "EXCLUDE            = sys/test|bsp/test\n\n"
+
+            "#׼Է({ELF}:̼, {LOG}:ָ־)\n"
+            "#BENCH_SIM         = qemu-system-arm -M lm3s6965evb ...\n\n"
+
+            "#׼Ժ(|ָ, Ϊʱȵĺ)\n"
+            "BENCH_FUNCS        = \n\n"
+
+            "#ٵĿ¼(|ָ, ǿʱ_traceĿ¼)\n"
+            "TRACE_DIRS         = \n\n"
+
+            "#make(-buildʱʹ)\n"
+            "#MAKE              = cs-make\n\n"
+            "#ʹԤĿ¼(|ָ, Դ뼰ûʱֱӲֿеĿ)\n"
+            "#PREBUILT_DIRS     = sys/os|sys/net\n\n"
+            "#Ԥֿ\n"
+            "#PREBUILT_STORE    = ./_prebuilt\n\n"
+            "#Ĳο̼(ǿʱµ.bin.delta)\n"
+            "#DELTA_REF         = ./release/v1.0.bin\n\n"
+            "#ѹ̼(|ָ, ǿʱɷֿLZѹ.lz)\n"
+            "#LZ_SECTIONS       = .text|.rodata|.data\n\n"
+            "#汾(|ָ, -matrixʱʹ; ÿ汾һ, ɸCCFLAGS/LDFLAGS/LIBS/LD)\n"
+            "#VARIANTS          = cm3|cm4f\n"
+            "#[cm4f]\n"
+            "#CCFLAGS           = -mcpu=cortex-m4 -mthumb -mfpu=fpv4-sp-d16 -mfloat-abi=hard ...\n\n"
             );
     else
     {
@@ -142,7 +229,31 @@ create_example_ini_file(pcfg_t *pinfo)
             "LD                 = %s\n\n"
 
             "#·(|ָ)\n"
-            "EXCLUDE            = %s\n\n",
+            "EXCLUDE            = %s\n\n"
+
+            "#׼Է({ELF}:̼, {LOG}:ָ־)\n"
+            "#BENCH_SIM         = qemu-system-arm -M lm3s6965evb ...\n\n"
+
+            "#׼Ժ(|ָ, Ϊʱȵĺ)\n"
+            "BENCH_FUNCS        = \n\n"
+
+            "#ٵĿ¼(|ָ, ǿʱ_traceĿ¼)\n"
+            "TRACE_DIRS         = \n\n"
+
+            "#make(-buildʱʹ)\n"
+            "#MAKE              = cs-make\n\n"
+            "#ʹԤĿ¼(|ָ, Դ뼰ûʱֱӲֿеĿ)\n"
+            "#PREBUILT_DIRS     = sys/os|sys/net\n\n"
+            "#Ԥֿ\n"
+            "#PREBUILT_STORE    = ./_prebuilt\n\n"
+            "#Ĳο̼(ǿʱµ.bin.delta)\n"
+            "#DELTA_REF         = ./release/v1.0.bin\n\n"
+            "#ѹ̼(|ָ, ǿʱɷֿLZѹ.lz)\n"
+            "#LZ_SECTIONS       = .text|.rodata|.data\n\n"
+            "#汾(|ָ, -matrixʱʹ; ÿ汾һ, ɸCCFLAGS/LDFLAGS/LIBS/LD)\n"
+            "#VARIANTS          = cm3|cm4f\n"
+            "#[cm4f]\n"
+            "#CCFLAGS           = -mcpu=cortex-m4 -mthumb -mfpu=fpv4-sp-d16 -mfloat-abi=hard ...\n\n",
 
             pinfo->I,
             pinfo->CCFLAGS,
@@ -210,96 +321,193 @@ ini_get_info(pcfg_t *pinfo)
     iniparser_dump(pini, NULL);//stderr
 
     pstr = iniparser_getstring(pini, "cfg:SRC_DIR", NULL);
-    if (pstr == NULL)
+    if (OK != ini_copy("cfg:SRC_DIR", pstr, pinfo->SRC_DIR, sizeof(pinfo->SRC_DIR)))
     {
         iniparser_freedict(pini);
         return -1;
     }
-    strncpy(pinfo->SRC_DIR, pstr, sizeof(pinfo->SRC_DIR));
 
     pstr = iniparser_getstring(pini, "cfg:BUILD_DIR", NULL);
-    if (pstr == NULL)
+    if (OK != ini_copy("cfg:BUILD_DIR", pstr, pinfo->BUILD_DIR, sizeof(pinfo->BUILD_DIR)))
     {
         iniparser_freedict(pini);
         return -1;
     }
-    strncpy(pinfo->BUILD_DIR, pstr, sizeof(pinfo->BUILD_DIR));
 
     pstr = iniparser_getstring(pini, "cfg:APP", NULL);
-    if (pstr == NULL)
+    if (OK != ini_copy("cfg:APP", pstr, pinfo->APP, sizeof(pinfo->APP)))
     {
         iniparser_freedict(pini);
         return -1;
     }
-    strncpy(pinfo->APP, pstr, sizeof(pinfo->APP));
 
     pstr = iniparser_getstring(pini, "cfg:CROSS_COMPILE", NULL);
-    if (pstr == NULL)
+    if (OK != ini_copy("cfg:CROSS_COMPILE", pstr, pinfo->CROSS_COMPILE, sizeof(pinfo->CROSS_COMPILE)))
     {
         iniparser_freedict(pini);
         return -1;
     }
-    strncpy(pinfo->CROSS_COMPILE, pstr, sizeof(pinfo->CROSS_COMPILE));
 
     pstr = iniparser_getstring(pini, "cfg:I", NULL);
-    if (pstr == NULL)
+    if (OK != ini_copy("cfg:I", pstr, pinfo->I, sizeof(pinfo->I)))
     {
         iniparser_freedict(pini);
         return -1;
     }
-    strncpy(pinfo->I, pstr, sizeof(pinfo->I));
 
     pstr = iniparser_getstring(pini, "cfg:CCFLAGS", NULL);
-    if (pstr == NULL)
+    if (OK != ini_copy("cfg:CCFLAGS", pstr, pinfo->CCFLAGS, sizeof(pinfo->CCFLAGS)))
     {
         iniparser_freedict(pini);
         return -1;
     }
-    strncpy(pinfo->CCFLAGS, pstr, sizeof(pinfo->CCFLAGS));
 
     pstr = iniparser_getstring(pini, "cfg:LDFLAGS", NULL);
-    if (pstr == NULL)
+    if (OK != ini_copy("cfg:LDFLAGS", pstr, pinfo->LDFLAGS, sizeof(pinfo->LDFLAGS)))
     {
         iniparser_freedict(pini);
         return -1;
     }
-    strncpy(pinfo->LDFLAGS, pstr, sizeof(pinfo->LDFLAGS));
 
     pstr = iniparser_getstring(pini, "cfg:L", NULL);
-    if (pstr == NULL)
+    if (OK != ini_copy("cfg:L", pstr, pinfo->L, sizeof(pinfo->L)))
     {
         iniparser_freedict(pini);
         return -1;
     }
-    strncpy(pinfo->L, pstr, sizeof(pinfo->L));
 
     pstr = iniparser_getstring(pini, "cfg:LIBS", NULL);
-    if (pstr == NULL)
+    if (OK != ini_copy("cfg:LIBS", pstr, pinfo->LIBS, sizeof(pinfo->LIBS)))
     {
         iniparser_freedict(pini);
         return -1;
     }
-    strncpy(pinfo->LIBS, pstr, sizeof(pinfo->LIBS));
 
     pstr = iniparser_getstring(pini, "cfg:LD", NULL);
-    if (pstr == NULL)
+    if (OK != ini_copy("cfg:LD", pstr, pinfo->LD, sizeof(pinfo->LD)))
     {
         iniparser_freedict(pini);
         return -1;
     }
-    strncpy(pinfo->LD, pstr, sizeof(pinfo->LD));
 
     pstr = iniparser_getstring(pini, "cfg:EXCLUDE", NULL);
-    if (pstr == NULL)
+    if (OK != ini_copy("cfg:EXCLUDE", pstr, pinfo->EXCLUDE, sizeof(pinfo->EXCLUDE)))
+    {
+        iniparser_freedict(pini);
+        return -1;
+    }
+
+    //Ϊѡ
+    if ((OK != ini_get_opt(pini, "cfg:BENCH_SIM", DEFAULT_BENCH_SIM,
+                pinfo->BENCH_SIM, sizeof(pinfo->BENCH_SIM)))
+            || (OK != ini_get_opt(pini, "cfg:BENCH_FUNCS", "",
+                pinfo->BENCH_FUNCS, sizeof(pinfo->BENCH_FUNCS)))
+            || (OK != ini_get_opt(pini, "cfg:BENCH_CPI", DEFAULT_BENCH_CPI,
+                pinfo->BENCH_CPI, sizeof(pinfo->BENCH_CPI)))
+            || (OK != ini_get_opt(pini, "cfg:TRACE_DIRS", "",
+                pinfo->TRACE_DIRS, sizeof(pinfo->TRACE_DIRS)))
+            || (OK != ini_get_opt(pini, "cfg:MAKE", DEFAULT_MAKE,
+                pinfo->MAKE, sizeof(pinfo->MAKE)))
+            || (OK != ini_get_opt(pini, "cfg:PREBUILT_DIRS", "",
+                pinfo->PREBUILT_DIRS, sizeof(pinfo->PREBUILT_DIRS)))
+            || (OK != ini_get_opt(pini, "cfg:PREBUILT_STORE", DEFAULT_STORE,
+                pinfo->PREBUILT_STORE, sizeof(pinfo->PREBUILT_STORE)))
+            || (OK != ini_get_opt(pini, "cfg:DELTA_REF", "",
+                pinfo->DELTA_REF, sizeof(pinfo->DELTA_REF)))
+            || (OK != ini_get_opt(pini, "cfg:LZ_SECTIONS", "",
+                pinfo->LZ_SECTIONS, sizeof(pinfo->LZ_SECTIONS))))
     {
         iniparser_freedict(pini);
         return -1;
     }
-    strncpy(pinfo->EXCLUDE, pstr, sizeof(pinfo->EXCLUDE));
 
     iniparser_freedict(pini);
 
     return 0;
 }
 
+/**
+ ******************************************************************************
+ * @brief   ļлȡ汾
+ * @param[out] *pcfgs : 汾Ĳ
+ * @param[in]  max    : 汾
+ *
+ * @retval     -1 ʧ(ûVARIANTS)
+ * @retval     >0 汾
+ *
+ * @note    [cfg]VARIANTS = cm3|cm4f, ÿ汾һ, еCCFLAGS, LDFLAGS,
+ *          LIBS, LD[cfg]е, ûе[cfg]
+ ******************************************************************************
+ */
+int
+ini_get_variants(pcfg_t *pcfgs,
+        int max)
+{
+    int num = 0;
+    char *pname;
+    const char *delim = "| \t";
+    char key[128];
+    char list[512];
+    dictionary *pini;
+    pcfg_t *pcfg;
+
+    pini = iniparser_load(DEFAULT_INI_FILE);
+    if (NULL == pini)
+    {
+        return -1;
+    }
+    if (OK != ini_get_opt(pini, "cfg:VARIANTS", "", list, sizeof(list)))
+    {
+        iniparser_freedict(pini);
+        return -1;
+    }
+
+    for (pname = strtok(list, delim); pname && (num < max); pname = strtok(NULL, delim))
+    {
+        pcfg = &pcfgs[num++];
+        memset(pcfg, 0x00, sizeof(*pcfg));
+        strncpy(pcfg->NAME, pname, sizeof(pcfg->NAME) - 1);
+        if ((OK != ini_get_opt(pini, "cfg:I", "", pcfg->I, sizeof(pcfg->I)))
+                || (OK != ini_get_opt(pini, "cfg:L", "", pcfg->L, sizeof(pcfg->L)))
+                || (OK != ini_get_opt(pini, "cfg:EXCLUDE", "", pcfg->EXCLUDE, sizeof(pcfg->EXCLUDE))))
+        {
+            num = 0;
+            break;
+        }
+
+        //汾еĸ[cfg]е(iniparserļִСд)
+        snprintf(key, sizeof(key), "%s:CCFLAGS", pname);
+        if (OK != ini_get_opt(pini, key, iniparser_getstring(pini, "cfg:CCFLAGS", (char *)""),
+                pcfg->CCFLAGS, sizeof(pcfg->CCFLAGS)))
+        {
+            num = 0;
+            break;
+        }
+        snprintf(key, sizeof(key), "%s:LDFLAGS", pname);
+        if (OK != ini_get_opt(pini, key, iniparser_getstring(pini, "cfg:LDFLAGS", (char *)""),
+                pcfg->LDFLAGS, sizeof(pcfg->LDFLAGS)))
+        {
+            num = 0;
+            break;
+        }
+        snprintf(key, sizeof(key), "%s:LIBS", pname);
+        if (OK != ini_get_opt(pini, key, iniparser_getstring(pini, "cfg:LIBS", (char *)""),
+                pcfg->LIBS, sizeof(pcfg->LIBS)))
+        {
+            num = 0;
+            break;
+        }
+        snprintf(key, sizeof(key), "%s:LD", pname);
+        if (OK != ini_get_opt(pini, key, iniparser_getstring(pini, "cfg:LD", (char *)""),
+                pcfg->LD, sizeof(pcfg->LD)))
+        {
+            num = 0;
+            break;
+        }
+    }
+    iniparser_freedict(pini);
+
+    return num ? num : -1;
+}
+
 /*---------------------------------ini.c-------------------------------------*/
@@ -39,6 +39,10 @@ extern "C" {
 extern int
 ini_get_info(pcfg_t *pinfo);
 
+extern int
+ini_get_variants(pcfg_t *pcfgs,
+        int max);
+
 #ifdef __cplusplus      /* Maintain C++ compatibility */
 }
 #endif /* __cplusplus */
@@ -16,6 +16,7 @@
 /*---------------------------- Includes ------------------------------------*/
 #include <ctype.h>
 #include "iniparser.h"
+#include "os.h"
 
 /*---------------------------- Defines -------------------------------------*/
 #define ASCIILINESZ         (1024)
@@ -66,36 +67,28 @@ static char * strlwc(char * s)
 
 /*-------------------------------------------------------------------------*/
 /**
-  @brief	Remove blanks at the beginning and the end of a string.
-  @param	s	String to parse.
-  @return	ptr to statically allocated string.
-
-  This function returns a pointer to a statically allocated string,
-  which is identical to the input string, except that all blank
-  characters at the end and the beg. of the string have been removed.
-  Do not free or modify the returned string! Since the returned string
-  is statically allocated, it will be modified at each function call
-  (not re-entrant).
+  @brief	Remove blanks around a slice of a line, in place.
+  @param	s		Start of the slice.
+  @param	e		End of the slice (excluded), must be writable.
+  @param	lower	Non-zero to convert the slice to lowercase.
+  @return	ptr to the first non-blank character of the slice.
+
+  The slice is terminated with a NUL written over the first trailing
+  blank, or over *e if there is none. Nothing is copied.
  */
 /*--------------------------------------------------------------------------*/
-static char * strstrip(char * s)
+static char * strslice(char * s, char * e, int lower)
 {
-    static char l[ASCIILINESZ+1];
-	char * last ;
-	
-    if (s==NULL) return NULL ;
-    
-	while (isspace((int)*s) && *s) s++;
-	memset(l, 0, ASCIILINESZ+1);
-	strcpy(l, s);
-	last = l + strlen(l);
-	while (last > l) {
-		if (!isspace((int)*(last-1)))
-			break ;
-		last -- ;
+	char * p ;
+
+	while (s<e && isspace((unsigned char)*s)) s++ ;
+	while (e>s && isspace((unsigned char)e[-1])) e-- ;
+	*e = (char)0 ;
+	if (lower) {
+		for (p=s ; p<e ; p++)
+			*p = (char)tolower((unsigned char)*p) ;
 	}
-	*last = (char)0;
-	return (char*)l ;
+	return s ;
 }
 
 /*-------------------------------------------------------------------------*/
@@ -444,25 +437,30 @@ void iniparser_unset(dictionary * ini, char * entry)
 
 /*-------------------------------------------------------------------------*/
 /**
-  @brief	Load a single line from an INI file
-  @param    input_line  Input line, may be concatenated multi-line input
-  @param    section     Output space to store section
-  @param    key         Output space to store key
-  @param    value       Output space to store value
+  @brief	Tokenize a single line from an INI file, in place
+  @param    line        Input line, may be concatenated multi-line input
+  @param    section     Set to the section name for a section line
+  @param    key         Set to the key for a key=value line
+  @param    value       Set to the value for a key=value line
   @return   line_status value
+
+  The line is scanned once: names are trimmed and lowercased where they
+  lie and terminated with a NUL, so the returned pointers point into the
+  line itself.
  */
 /*--------------------------------------------------------------------------*/
 static line_status iniparser_line(
-    char * input_line,
-    char * section,
-    char * key,
-    char * value)
-{   
+    char *  line,
+    char ** section,
+    char ** key,
+    char ** value)
+{
     line_status sta ;
-    char        line[ASCIILINESZ+1];
+    char *      p ;
+    char *      q ;
     int         len ;
 
-    strcpy(line, strstrip(input_line));
+    line = strslice(line, line+strlen(line), 0) ;
     len = (int)strlen(line);
 
     sta = LINE_UNPROCESSED ;
@@ -473,37 +471,30 @@ static line_status iniparser_line(
         /* Comment line */
         sta = LINE_COMMENT ; 
     } else if (line[0]=='[' && line[len-1]==']') {
-        /* Section name */
-        sscanf(line, "[%[^]]", section);
-        strcpy(section, strstrip(section));
-        strcpy(section, strlwc(section));
+        /* Section name, "[]" keeps the current one */
+        q = strchr(line+1, ']') ;
+        if (q>line+1) {
+            *section = strslice(line+1, q, 1) ;
+        }
         sta = LINE_SECTION ;
-    } else if (sscanf (line, "%[^=] = \"%[^\"]\"", key, value) == 2
-           ||  sscanf (line, "%[^=] = '%[^\']'",   key, value) == 2
-           ||  sscanf (line, "%[^=] = %[^;#]",     key, value) == 2) {
+    } else if ((p=strchr(line, '='))!=NULL && p!=line) {
         /* Usual key=value, with or without comments */
-        strcpy(key, strstrip(key));
-        strcpy(key, strlwc(key));
-        strcpy(value, strstrip(value));
-        /*
-         * sscanf cannot handle '' or "" as empty values
-         * this is done here
-         */
-        if (!strcmp(value, "\"\"") || (!strcmp(value, "''"))) {
-            value[0]=0 ;
+        *key = strslice(line, p, 1) ;
+        p++ ;
+        while (isspace((unsigned char)*p)) p++ ;
+        if ((*p=='"' || *p=='\'') && p[1] && p[1]!=*p) {
+            /* Quoted value, up to the closing quote */
+            q = strchr(p+1, *p) ;
+            if (!q) q = p+strlen(p) ;
+            *value = strslice(p+1, q, 0) ;
+        } else {
+            /* Up to an inline comment, empty for key=, key=; and key=# */
+            *value = strslice(p, p+strcspn(p, ";#"), 0) ;
+        }
+        /* '' or "" are empty values */
+        if (!strcmp(*value, "\"\"") || (!strcmp(*value, "''"))) {
+            (*value)[0]=0 ;
         }
-        sta = LINE_VALUE ;
-    } else if (sscanf(line, "%[^=] = %[;#]", key, value)==2
-           ||  sscanf(line, "%[^=] %[=]", key, value) == 2) {
-        /*
-         * Special cases:
-         * key=
-         * key=;
-         * key=#
-         */
-        strcpy(key, strstrip(key));
-        strcpy(key, strlwc(key));
-        value[0]=0 ;
         sta = LINE_VALUE ;
     } else {
         /* Generate syntax error */
@@ -523,6 +514,10 @@ static line_status iniparser_line(
   should not be accessed directly, but through accessor functions
   instead.
 
+  The file is mapped copy-on-write and tokenized where it lies: lines
+  continued with a backslash are joined by moving them down in place,
+  and there is no limit on the length of a line.
+
   The returned dictionary must be freed using iniparser_freedict().
  */
 /*--------------------------------------------------------------------------*/
@@ -530,66 +525,82 @@ dictionary * iniparser_load(char * ininame)
 {
     FILE * in ;
 
-    char line    [ASCIILINESZ+1] ;
-    char section [ASCIILINESZ+1] ;
-    char key     [ASCIILINESZ+1] ;
-    char tmp     [ASCIILINESZ+1] ;
-    char val     [ASCIILINESZ+1] ;
+    char * buf ;            /* Copy-on-write mapping of the file */
+    char * end ;
+    char * p ;              /* Next byte to read */
+    char * w ;              /* End of the logical line joined so far */
+    char * eol ;
+    char * e ;
+    char * line ;
+    char * last = NULL ;    /* Copy of a last line without newline */
+    char   none[1] = "" ;
+    char * section = none ;
+    char * key = NULL ;
+    char * val = NULL ;
+    char * tmp = NULL ;
+    char * t ;
+    size_t tmpsz = 0 ;
+    size_t len ;
+    uint32 size ;
+    int    more ;
 
-    int  last=0 ;
-    int  len ;
     int  lineno=0 ;
     int  errs=0;
 
     dictionary * dict ;
 
-    if ((in=fopen(ininame, "r"))==NULL) {
-        fprintf(stderr, "iniparser: cannot open %s\n", ininame);
-        return NULL ;
+    buf = os_fmap_copy(ininame, &size) ;
+    if (buf==NULL) {
+        /* Empty files cannot be mapped but are valid */
+        if ((in=fopen(ininame, "r"))==NULL) {
+            fprintf(stderr, "iniparser: cannot open %s\n", ininame);
+            return NULL ;
+        }
+        fclose(in);
     }
 
-    dict = dictionary_new(0) ;
+    /* Loaded once and then read: keep all strings in one arena */
+    dict = dictionary_new_arena(0) ;
     if (!dict) {
-        fclose(in);
+        os_funmap(buf);
         return NULL ;
     }
 
-    memset(line,    0, ASCIILINESZ);
-    memset(section, 0, ASCIILINESZ);
-    memset(key,     0, ASCIILINESZ);
-    memset(val,     0, ASCIILINESZ);
-    last=0 ;
-
-    while (fgets(line+last, ASCIILINESZ-last, in)!=NULL) {
-        lineno++ ;
-        len = (int)strlen(line)-1;
-        if (len==0)
-            continue;
-        /* Safety check against buffer overflows */
-        if (line[len]!='\n') {
-            fprintf(stderr,
-                    "iniparser: input line too long in %s (%d)\n",
-                    ininame,
-                    lineno);
-            dictionary_del(dict);
-            fclose(in);
-            return NULL ;
-        }
-        /* Get rid of \n and spaces at end of line */
-        while ((len>=0) &&
-                ((line[len]=='\n') || (isspace(line[len])))) {
-            line[len]=0 ;
-            len-- ;
-        }
-        /* Detect multi-line */
-        if (line[len]=='\\') {
-            /* Multi-line value */
-            last=len ;
-            continue ;
+    p = buf ;
+    end = buf + size ;
+    while (p<end) {
+        /* Join a multi-line value over the trailing backslashes */
+        line = w = p ;
+        do {
+            lineno++ ;
+            eol = memchr(p, '\n', (size_t)(end-p)) ;
+            if (eol==NULL) eol = end ;
+            /* Get rid of \n and spaces at end of line */
+            e = eol ;
+            while (e>p && isspace((unsigned char)e[-1])) e-- ;
+            more = (e>p && e[-1]=='\\') ;
+            if (more) e-- ;
+            if (w!=p) memmove(w, p, (size_t)(e-p)) ;
+            w += e-p ;
+            p = (eol<end) ? eol+1 : end ;
+        } while (more && p<end) ;
+
+        if (w<end) {
+            *w = 0 ;
         } else {
-            last=0 ;
+            /* No room left for the terminator in the mapping */
+            last = malloc((size_t)(w-line)+1) ;
+            if (!last) {
+                errs = -1 ;
+                fprintf(stderr, "iniparser: memory allocation failure\n");
+                break ;
+            }
+            memcpy(last, line, (size_t)(w-line)) ;
+            last[w-line] = 0 ;
+            line = last ;
         }
-        switch (iniparser_line(line, section, key, val)) {
+
+        switch (iniparser_line(line, &section, &key, &val)) {
             case LINE_EMPTY:
             case LINE_COMMENT:
             break ;
@@ -599,6 +610,16 @@ dictionary * iniparser_load(char * ininame)
             break ;
 
             case LINE_VALUE:
+            len = strlen(section) + strlen(key) + 2 ;
+            if (len>tmpsz) {
+                t = realloc(tmp, len) ;
+                if (!t) {
+                    errs = -1 ;
+                    break ;
+                }
+                tmp = t ;
+                tmpsz = len ;
+            }
             sprintf(tmp, "%s:%s", section, key);
             errs = dictionary_set(dict, tmp, val) ;
             break ;
@@ -614,8 +635,6 @@ dictionary * iniparser_load(char * ininame)
             default:
             break ;
         }
-        memset(line, 0, ASCIILINESZ);
-        last=0;
         if (errs<0) {
             fprintf(stderr, "iniparser: memory allocation failure\n");
             break ;
@@ -625,7 +644,9 @@ dictionary * iniparser_load(char * ininame)
         dictionary_del(dict);
         dict = NULL ;
     }
-    fclose(in);
+    free(tmp);
+    free(last);
+    os_funmap(buf);
     return dict ;
 }
 
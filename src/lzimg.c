@@ -0,0 +1,517 @@
+/**
+ ******************************************************************************
+ * @file      lzimg.c
+ * @brief     ̼ѹ: ֿLZ(LZ4ʽ), ̱߳, Ŀ
+ * @details   This file including all API functions's implement of lzimg.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "maths.h"
+#include "os.h"
+#include "hash.h"
+#include "lzimg.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ * ѹ̼ͷ(С), Ϊ(ÿuint32ѹ, λΪ1ʾԭ)
+ * . 黥, ֻһС
+ */
+typedef struct
+{
+    char magic[4];              /**< LZIMG_MAGIC */
+    uint8 format;               /**< LZIMG_FORMAT */
+    uint8 block_log;            /**< СΪ(1 << block_log) */
+    uint8 reserved[2];
+    uint8 raw_len[4];           /**< ԭʼ */
+    uint8 raw_hash[8];          /**< ԭʼݹϣ(FNV-1a 64) */
+} lzimg_head_t;
+
+/** һı */
+typedef struct
+{
+    const uint8 *psrc;
+    uint32 len;
+    uint8 *pdst;                /**< LZ_BOUND(len) */
+    uint32 out_len;             /**< 0Ϊ󲻱ԭС */
+    uint32 seqs;                /**<  */
+} lz_block_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+#define LZIMG_MAGIC         "AMZ1"
+#define LZIMG_FORMAT        (1u)    /**< LZ4ʽ */
+
+#define BLOCK_LOG           (16u)   /**< 64KBһ, ƫuint16 */
+#define BLOCK_SIZE          (1u << BLOCK_LOG)
+#define BLOCK_RAW           (0x80000000u)
+
+/** LZ4ʽԼ: 5ֽΪԭ, 12ֽڲʼƥ */
+#define MIN_MATCH           (4u)
+#define LAST_LITERALS       (5u)
+#define MF_LIMIT            (12u)
+
+#define HASH_BITS           (14u)
+
+/** ı볤 */
+#define LZ_BOUND(n)         ((n) + (n) / 255 + 16)
+
+/** ٶȵʱ(ms) */
+#define DECODE_MS           (50u)
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   С˶д
+ ******************************************************************************
+ */
+static void
+put_le(uint8 *p,
+        uint64 v,
+        int n)
+{
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        p[i] = (uint8)(v >> (i * 8));
+    }
+}
+
+static uint32
+get_le32(const uint8 *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32)p[3] << 24);
+}
+
+/**
+ ******************************************************************************
+ * @brief   4ֽڵĹϣ
+ ******************************************************************************
+ */
+static uint32
+lz_hash(const uint8 *p)
+{
+    uint32 v;
+
+    memcpy(&v, p, sizeof(v));
+    return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+/**
+ ******************************************************************************
+ * @brief   : 15token, 255
+ ******************************************************************************
+ */
+static uint8 *
+lz_put_len(uint8 *pdst,
+        uint32 len)
+{
+    for (len -= 15; len >= 255; len -= 255)
+    {
+        *pdst++ = 255;
+    }
+    *pdst++ = (uint8)len;
+
+    return pdst;
+}
+
+/**
+ ******************************************************************************
+ * @brief   һ: token, ԭ, ƥƫƼ
+ * @param[in]  *pdst : λ
+ * @param[in]  *plit : ԭ
+ * @param[in]  lit   : ԭ
+ * @param[in]  off   : ƥƫ, 0Ϊһ(ֻԭ)
+ * @param[in]  mlen  : ƥ䳤
+ *
+ * @return  λ
+ ******************************************************************************
+ */
+static uint8 *
+lz_put_seq(uint8 *pdst,
+        const uint8 *plit,
+        uint32 lit,
+        uint32 off,
+        uint32 mlen)
+{
+    uint8 *ptoken = pdst++;
+
+    *ptoken = (uint8)(((lit >= 15) ? 15 : lit) << 4);
+    if (lit >= 15)
+    {
+        pdst = lz_put_len(pdst, lit);
+    }
+    memcpy(pdst, plit, lit);
+    pdst += lit;
+    if (!off)
+    {
+        return pdst;
+    }
+
+    *pdst++ = (uint8)off;
+    *pdst++ = (uint8)(off >> 8);
+    mlen -= MIN_MATCH;
+    *ptoken |= (uint8)((mlen >= 15) ? 15 : mlen);
+    if (mlen >= 15)
+    {
+        pdst = lz_put_len(pdst, mlen);
+    }
+    return pdst;
+}
+
+/**
+ ******************************************************************************
+ * @brief   һ(os_parallel)
+ * @param[in]  *parg : lz_block_t
+ * @param[in]  idx   : ±
+ *
+ * @return  None
+ *
+ * @note    ̰ƥ, ÿϣֻλ; ûƥʱӴ󲽳,
+ *          ѹҲܿ
+ ******************************************************************************
+ */
+static void
+lz_encode(void *parg,
+        int idx)
+{
+    uint32 i;
+    uint32 h;
+    uint32 ref;
+    uint32 lit = 0;
+    uint32 mlen;
+    uint32 miss = 0;
+    uint32 limit;
+    uint8 *pdst;
+    uint32 table[1u << HASH_BITS];
+    lz_block_t *pblk = (lz_block_t *)parg + idx;
+    const uint8 *psrc = pblk->psrc;
+
+    pdst = pblk->pdst;
+    pblk->seqs = 0;
+    limit = (pblk->len > MF_LIMIT) ? pblk->len - MF_LIMIT : 0;
+    memset(table, 0xff, sizeof(table));
+
+    for (i = 0; i < limit; )
+    {
+        h = lz_hash(psrc + i);
+        ref = table[h];
+        table[h] = i;
+        if ((ref == 0xffffffffu) || memcmp(psrc + ref, psrc + i, MIN_MATCH))
+        {
+            i += 1 + (miss++ >> 6);
+            continue;
+        }
+        miss = 0;
+
+        //չ(ԭ), ǰԵƥԭ
+        for (mlen = MIN_MATCH; (i + mlen < pblk->len - LAST_LITERALS) && (psrc[ref + mlen] == psrc[i + mlen]); mlen++)
+        {
+        }
+        while ((i > lit) && ref && (psrc[ref - 1] == psrc[i - 1]))
+        {
+            i--;
+            ref--;
+            mlen++;
+        }
+
+        pdst = lz_put_seq(pdst, psrc + lit, i - lit, i - ref, mlen);
+        pblk->seqs++;
+        i += mlen;
+        lit = i;
+        if (i < limit)
+        {
+            table[lz_hash(psrc + i - 2)] = i - 2;
+        }
+    }
+    pdst = lz_put_seq(pdst, psrc + lit, pblk->len - lit, 0, 0);
+    pblk->seqs++;
+
+    pblk->out_len = (uint32)(pdst - pblk->pdst);
+    if (pblk->out_len >= pblk->len)
+    {
+        pblk->out_len = 0;
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   һ(ĿϵĽͬ, Խ)
+ * @param[in]  *psrc : ѹ
+ * @param[in]  slen  : ѹ
+ * @param[out] *pdst : 
+ * @param[in]  dlen  : 
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : 
+ ******************************************************************************
+ */
+static status_t
+lz_decode(const uint8 *psrc,
+        uint32 slen,
+        uint8 *pdst,
+        uint32 dlen)
+{
+    uint32 n;
+    uint32 off;
+    uint32 token;
+    uint32 pos = 0;
+    const uint8 *pend = psrc + slen;
+
+    while (psrc < pend)
+    {
+        token = *psrc++;
+
+        //ԭ
+        n = token >> 4;
+        if (n == 15)
+        {
+            do
+            {
+                if (psrc >= pend)
+                {
+                    return ERROR;
+                }
+                n += *psrc;
+            } while (*psrc++ == 255);
+        }
+        if ((n > (uint32)(pend - psrc)) || (n > dlen - pos))
+        {
+            return ERROR;
+        }
+        memcpy(pdst + pos, psrc, n);
+        psrc += n;
+        pos += n;
+        if (psrc == pend)
+        {
+            break;          //һ
+        }
+
+        //ƥ, ص, ֽڸ
+        if (pend - psrc < 2)
+        {
+            return ERROR;
+        }
+        off = psrc[0] | (psrc[1] << 8);
+        psrc += 2;
+        n = token & 0x0f;
+        if (n == 15)
+        {
+            do
+            {
+                if (psrc >= pend)
+                {
+                    return ERROR;
+                }
+                n += *psrc;
+            } while (*psrc++ == 255);
+        }
+        n += MIN_MATCH;
+        if (!off || (off > pos) || (n > dlen - pos))
+        {
+            return ERROR;
+        }
+        for (; n; n--, pos++)
+        {
+            pdst[pos] = pdst[pos - off];
+        }
+    }
+
+    return (pos == dlen) ? OK : ERROR;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ѹ̼(makefile), һ֤ѹʼٶ
+ * @param[in]  argc  : 
+ * @param[in]  **argv : <ԭʼ̼> <ѹ̼>
+ *
+ * @retval  EXIT_SUCCESS : ɹ
+ * @retval  EXIT_FAILURE : ʧ
+ *
+ * @note    ĿʱҪȡ(ÿһtokenθ),
+ *          ͬʱƽÿֽ
+ ******************************************************************************
+ */
+int
+lzimg_make(int argc,
+        char **argv)
+{
+    int i;
+    int num;
+    int threads;
+    int rounds = 0;
+    uint32 ms = os_ms();
+    uint32 enc_ms;
+    uint32 dec_ms;
+    uint32 len = 0;
+    uint32 pos;
+    uint32 src;
+    uint32 n;
+    uint32 seqs = 0;
+    uint32 lz_bytes = 0;
+    uint8 *pout = NULL;
+    uint8 *pcheck = NULL;
+    const char *perr = NULL;
+    const uint8 *praw;
+    lz_block_t *pblk = NULL;
+    lzimg_head_t *phead;
+    uint8 *ptab;
+    FILE *pfd;
+    int ret = EXIT_FAILURE;
+
+    if (argc < 2)
+    {
+        return EXIT_FAILURE;
+    }
+    //ļӳʧ(ѡеĶΪջ򲻴ʱobjcopyļ), 0, ֻͷ
+    praw = (const uint8 *)os_fmap(argv[0], &len);
+    if (!praw)
+    {
+        pfd = fopen(argv[0], "rb");
+        if (!pfd)
+        {
+            printf("ѹ̼ʧ: ޷ȡ%s\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+        fclose(pfd);
+        len = 0;
+    }
+    num = (int)((len + BLOCK_SIZE - 1) >> BLOCK_LOG);
+
+    do
+    {
+        //1. ֿ鲢б, дԵλ
+        pblk = calloc(num + 1, sizeof(*pblk));
+        pout = malloc(sizeof(lzimg_head_t) + num * 4 + LZ_BOUND(len) + num * 16);
+        pcheck = malloc(BLOCK_SIZE);
+        if (!pblk || !pout || !pcheck)
+        {
+            perr = "ڴ治";
+            break;
+        }
+        pos = 0;
+        for (i = 0; i < num; i++)
+        {
+            pblk[i].psrc = praw + ((uint32)i << BLOCK_LOG);
+            pblk[i].len = MIN(len - ((uint32)i << BLOCK_LOG), BLOCK_SIZE);
+            pblk[i].pdst = pout + sizeof(lzimg_head_t) + num * 4 + pos;
+            pos += LZ_BOUND(pblk[i].len);
+        }
+        threads = os_parallel(num, lz_encode, pblk);
+        enc_ms = os_ms() - ms;
+
+        //2. ͷ, , ݽ(ѹĿԭ)
+        phead = (lzimg_head_t *)pout;
+        memcpy(phead->magic, LZIMG_MAGIC, sizeof(phead->magic));
+        phead->format = LZIMG_FORMAT;
+        phead->block_log = BLOCK_LOG;
+        phead->reserved[0] = 0;
+        phead->reserved[1] = 0;
+        put_le(phead->raw_len, len, 4);
+        put_le(phead->raw_hash, hash_fnv(praw, len, HASH_INIT), 8);
+        ptab = pout + sizeof(lzimg_head_t);
+        pos = sizeof(lzimg_head_t) + num * 4;
+        for (i = 0; i < num; i++)
+        {
+            if (pblk[i].out_len)
+            {
+                memmove(pout + pos, pblk[i].pdst, pblk[i].out_len);
+                put_le(ptab + i * 4, pblk[i].out_len, 4);
+                pos += pblk[i].out_len;
+                seqs += pblk[i].seqs;
+                lz_bytes += pblk[i].len;
+            }
+            else
+            {
+                memcpy(pout + pos, pblk[i].psrc, pblk[i].len);
+                put_le(ptab + i * 4, pblk[i].len | BLOCK_RAW, 4);
+                pos += pblk[i].len;
+            }
+        }
+
+        //3. , һ֤, ظ㹻ʱٶ
+        ms = os_ms();
+        do
+        {
+            src = sizeof(lzimg_head_t) + num * 4;
+            for (i = 0; (i < num) && !perr; i++)
+            {
+                n = get_le32(ptab + i * 4);
+                if (!(n & BLOCK_RAW)
+                        && ((OK != lz_decode(pout + src, n, pcheck, pblk[i].len))
+                            || (!rounds && memcmp(pcheck, pblk[i].psrc, pblk[i].len))))
+                {
+                    perr = "֤ʧ";
+                }
+                src += n & ~BLOCK_RAW;
+            }
+            rounds++;
+            dec_ms = os_ms() - ms;
+        } while (!perr && (dec_ms < DECODE_MS) && (rounds < 1000));
+        if (perr)
+        {
+            break;
+        }
+
+        if (OK != os_fupdate(argv[1], (const char *)pout, (int)pos))
+        {
+            perr = "дļʧ";
+            break;
+        }
+        printf("ѹ̼: %s -> %s, %u -> %uֽ(%.1f%%), %d, %ḏ߳%ums\n",
+                argv[0], argv[1], len, pos, len ? pos * 100.0 / len : 0.0, num, threads, enc_ms);
+        if (seqs)
+        {
+            printf("  : %.0fMB/s, %u, ƽÿ%.1fֽ\n",
+                    dec_ms ? (double)lz_bytes * rounds / 1000.0 / dec_ms : 0.0,
+                    seqs, (double)lz_bytes / seqs);
+        }
+        else if (len)
+        {
+            printf("  ѹ, ȫԭ\n");
+        }
+        ret = EXIT_SUCCESS;
+    } while (0);
+
+    if (perr)
+    {
+        printf("ѹ̼%sʧ: %s\n", argv[1], perr);
+    }
+    free(pcheck);
+    free(pout);
+    free(pblk);
+    os_funmap((const char *)praw);
+
+    return ret;
+}
+
+/*----------------------------------lzimg.c----------------------------------*/
@@ -0,0 +1,47 @@
+/**
+ ******************************************************************************
+ * @file       lzimg.h
+ * @brief      API include file of lzimg.h.
+ * @details    This file including all API functions's declare of lzimg.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef LZIMG_H_
+#define LZIMG_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include "types.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#define LZIMG_SUFFIX        ".lz"       /**< ѹ̼׺, .binͬ */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern int
+lzimg_make(int argc,
+        char **argv);
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* LZIMG_H_ */
+/*------------------------------End of lzimg.h-------------------------------*/
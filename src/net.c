@@ -0,0 +1,456 @@
+/**
+ ******************************************************************************
+ * @file      net.c
+ * @brief     TCP: ʱӼշ, ʧܵļ¼, 򵥵ļ
+ * @details   This file including all API functions's implement of net.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <winsock2.h>
+#include <windows.h>
+#include "types.h"
+#include "maths.h"
+#include "os.h"
+#include "net.h"
+
+#ifdef _MSC_VER
+#pragma comment(lib, "ws2_32.lib")
+#endif
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** һ */
+typedef struct
+{
+    SOCKET s;
+    void (*pfunc)(SOCKET s);
+} net_conn_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+#define CONNECT_MS          (300)           /**< ӳʱ */
+
+#define NET_DOWN            ".net_down"     /**< ʧܵķ(Ŀ¼) */
+#define DOWN_SECONDS        (60)            /**< ʧܺڲʹ */
+
+/** ļС */
+#define READ_BUF_SIZE       (1024u)
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   ʼwinsock
+ ******************************************************************************
+ */
+status_t
+net_init(void)
+{
+    WSADATA wsa;
+
+    return WSAStartup(MAKEWORD(2, 2), &wsa) ? ERROR : OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ʱ
+ * @param[in]  *phost : IP
+ * @param[in]  port   : ˿
+ *
+ * @retval  INVALID_SOCKET : ʧ
+ * @retval             : ӵsocket
+ ******************************************************************************
+ */
+SOCKET
+net_connect(const char *phost,
+        uint16 port)
+{
+    int err = 0;
+    int len = sizeof(err);
+    u_long nb = 1;
+    SOCKET s;
+    fd_set wfds;
+    fd_set efds;
+    struct timeval tv;
+    struct hostent *ph;
+    struct sockaddr_in addr;
+
+    memset(&addr, 0x00, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = inet_addr(phost);
+    if (addr.sin_addr.s_addr == INADDR_NONE)
+    {
+        ph = gethostbyname(phost);
+        if (!ph || !ph->h_addr_list[0])
+        {
+            return INVALID_SOCKET;
+        }
+        memcpy(&addr.sin_addr, ph->h_addr_list[0], sizeof(addr.sin_addr));
+    }
+
+    s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (s == INVALID_SOCKET)
+    {
+        return s;
+    }
+    //, ʧʱwindowsefdsб
+    ioctlsocket(s, FIONBIO, &nb);
+    connect(s, (struct sockaddr *)&addr, sizeof(addr));
+    FD_ZERO(&wfds);
+    FD_SET(s, &wfds);
+    efds = wfds;
+    tv.tv_sec = CONNECT_MS / 1000;
+    tv.tv_usec = (CONNECT_MS % 1000) * 1000;
+    if ((select((int)s + 1, NULL, &wfds, &efds, &tv) <= 0) || FD_ISSET(s, &efds)
+            || getsockopt(s, SOL_SOCKET, SO_ERROR, (char *)&err, &len) || err)
+    {
+        closesocket(s);
+        return INVALID_SOCKET;
+    }
+    nb = 0;
+    ioctlsocket(s, FIONBIO, &nb);
+
+    return s;
+}
+
+/**
+ ******************************************************************************
+ * @brief   /ȫ
+ * @param[in]  s     : socket
+ * @param[in]  *pbuf : 
+ * @param[in]  len   : 
+ * @param[in]  ms    : ʱÿεȴĳʱ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧܻʱ
+ ******************************************************************************
+ */
+status_t
+net_send(SOCKET s,
+        const void *pbuf,
+        uint32 len)
+{
+    int n;
+    const char *p = pbuf;
+
+    while (len)
+    {
+        n = send(s, p, (int)MIN(len, 0x10000u), 0);
+        if (n <= 0)
+        {
+            return ERROR;
+        }
+        p += n;
+        len -= n;
+    }
+    return OK;
+}
+
+status_t
+net_recv(SOCKET s,
+        void *pbuf,
+        uint32 len,
+        int ms)
+{
+    int n;
+    char *p = pbuf;
+    fd_set fds;
+    struct timeval tv;
+
+    while (len)
+    {
+        FD_ZERO(&fds);
+        FD_SET(s, &fds);
+        tv.tv_sec = ms / 1000;
+        tv.tv_usec = (ms % 1000) * 1000;
+        if (select((int)s + 1, &fds, NULL, NULL, &tv) <= 0)
+        {
+            return ERROR;
+        }
+        n = recv(s, p, (int)MIN(len, 0x10000u), 0);
+        if (n <= 0)
+        {
+            return ERROR;
+        }
+        p += n;
+        len -= n;
+    }
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ѵ(maxֽ)
+ * @param[in]  s     : socket
+ * @param[out] *pbuf : 
+ * @param[in]  max   : յĳ
+ * @param[in]  ms    : ʱ
+ *
+ * @retval  >0 : յĳ
+ * @retval  <=0 : ʱ, ʧܻԷѹر
+ ******************************************************************************
+ */
+int
+net_recv_any(SOCKET s,
+        void *pbuf,
+        uint32 max,
+        int ms)
+{
+    fd_set fds;
+    struct timeval tv;
+
+    FD_ZERO(&fds);
+    FD_SET(s, &fds);
+    tv.tv_sec = ms / 1000;
+    tv.tv_usec = (ms % 1000) * 1000;
+    if (select((int)s + 1, &fds, NULL, NULL, &tv) <= 0)
+    {
+        return -1;
+    }
+    return recv(s, pbuf, (int)MIN(max, 0x10000u), 0);
+}
+
+/**
+ ******************************************************************************
+ * @brief   /ֽuint32
+ ******************************************************************************
+ */
+status_t
+net_send_u32(SOCKET s,
+        uint32 v)
+{
+    v = htonl(v);
+    return net_send(s, &v, sizeof(v));
+}
+
+status_t
+net_recv_u32(SOCKET s,
+        uint32 *pv,
+        int ms)
+{
+    if (OK != net_recv(s, pv, sizeof(*pv), ms))
+    {
+        return ERROR;
+    }
+    *pv = ntohl(*pv);
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   /մȵݿ
+ * @param[in]  s     : socket
+ * @param[in]  max   : ʱ󳤶
+ * @param[out] *plen : յĳ
+ * @param[in]  ms    : ʱ
+ *
+ * @retval  NULL  : ʧ
+ * @retval !NULL  : (0β), freeͷ
+ ******************************************************************************
+ */
+status_t
+net_send_blob(SOCKET s,
+        const void *pbuf,
+        uint32 len)
+{
+    if (OK != net_send_u32(s, len))
+    {
+        return ERROR;
+    }
+    return net_send(s, pbuf, len);
+}
+
+char *
+net_recv_blob(SOCKET s,
+        uint32 max,
+        uint32 *plen,
+        int ms)
+{
+    uint32 len;
+    char *pbuf;
+
+    if ((OK != net_recv_u32(s, &len, ms)) || (len > max))
+    {
+        return NULL;
+    }
+    pbuf = malloc(len + 1);
+    if (!pbuf)
+    {
+        return NULL;
+    }
+    if (OK != net_recv(s, pbuf, len, ms))
+    {
+        free(pbuf);
+        return NULL;
+    }
+    pbuf[len] = 0;
+    if (plen)
+    {
+        *plen = len;
+    }
+    return pbuf;
+}
+
+/**
+ ******************************************************************************
+ * @brief   Ƿʧܹ(бĸ̹NET_DOWN)
+ * @param[in]  *phost : 
+ * @param[in]  port   : ˿
+ *
+ * @retval  E_TRUE  : DOWN_SECONDSʧܹ, ݲʹ
+ * @retval  E_FALSE : ʹ
+ ******************************************************************************
+ */
+bool_e
+net_is_down(const char *phost,
+        uint16 port)
+{
+    long t;
+    long now = (long)time(NULL);
+    unsigned int p;
+    char host[64];
+    char line[READ_BUF_SIZE];
+    bool_e down = E_FALSE;
+    FILE *pfd;
+
+    pfd = fopen(NET_DOWN, "r");
+    while (pfd && !down && fgets(line, sizeof(line), pfd))
+    {
+        down = ((sscanf(line, "%63s %u %ld", host, &p, &t) == 3)
+                && !strcmp(host, phost) && (p == port)
+                && (now - t < DOWN_SECONDS)) ? E_TRUE : E_FALSE;
+    }
+    if (pfd)
+    {
+        fclose(pfd);
+    }
+    return down;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ¼ʧ
+ ******************************************************************************
+ */
+void
+net_down(const char *phost,
+        uint16 port)
+{
+    char line[128];
+
+    snprintf(line, sizeof(line), "%s %u %ld\n", phost, port, (long)time(NULL));
+    os_append(NET_DOWN, line);
+}
+
+/**
+ ******************************************************************************
+ * @brief   : һ(ÿһ߳)
+ ******************************************************************************
+ */
+static DWORD WINAPI
+net_conn(LPVOID p)
+{
+    net_conn_t conn = *(net_conn_t *)p;
+
+    free(p);
+    conn.pfunc(conn.s);
+    closesocket(conn.s);
+
+    return 0;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ˿, ÿӴһ̵߳pfunc(غر)
+ * @param[in]  port   : ˿
+ * @param[in]  *pfunc : Ӵ
+ *
+ * @retval  ERROR : ޷(ʱ)
+ ******************************************************************************
+ */
+status_t
+net_serve(uint16 port,
+        void (*pfunc)(SOCKET s))
+{
+    int on = 1;
+    SOCKET s;
+    HANDLE h;
+    net_conn_t *pc;
+    struct sockaddr_in addr;
+
+    if (OK != net_init())
+    {
+        return ERROR;
+    }
+    memset(&addr, 0x00, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (s != INVALID_SOCKET)
+    {
+        setsockopt(s, SOL_SOCKET, SO_REUSEADDR, (const char *)&on, sizeof(on));
+    }
+    if ((s == INVALID_SOCKET) || bind(s, (struct sockaddr *)&addr, sizeof(addr))
+            || listen(s, SOMAXCONN))
+    {
+        return ERROR;
+    }
+
+    for (;;)
+    {
+        h = NULL;
+        pc = malloc(sizeof(net_conn_t));
+        if (!pc)
+        {
+            continue;
+        }
+        pc->pfunc = pfunc;
+        pc->s = accept(s, NULL, NULL);
+        if (pc->s != INVALID_SOCKET)
+        {
+            h = CreateThread(NULL, 0, net_conn, pc, 0, NULL);
+        }
+        if (h)
+        {
+            CloseHandle(h);
+            continue;
+        }
+        if (pc->s != INVALID_SOCKET)
+        {
+            closesocket(pc->s);
+        }
+        free(pc);
+    }
+
+    return OK;
+}
+
+/*-----------------------------------net.c-----------------------------------*/
@@ -0,0 +1,100 @@
+/**
+ ******************************************************************************
+ * @file       net.h
+ * @brief      API include file of net.h.
+ * @details    This file including all API functions's declare of net.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef NET_H_
+#define NET_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <winsock2.h>
+#include "types.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern status_t
+net_init(void);
+
+extern SOCKET
+net_connect(const char *phost,
+        uint16 port);
+
+extern status_t
+net_send(SOCKET s,
+        const void *pbuf,
+        uint32 len);
+
+extern status_t
+net_recv(SOCKET s,
+        void *pbuf,
+        uint32 len,
+        int ms);
+
+extern int
+net_recv_any(SOCKET s,
+        void *pbuf,
+        uint32 max,
+        int ms);
+
+extern status_t
+net_send_u32(SOCKET s,
+        uint32 v);
+
+extern status_t
+net_recv_u32(SOCKET s,
+        uint32 *pv,
+        int ms);
+
+extern status_t
+net_send_blob(SOCKET s,
+        const void *pbuf,
+        uint32 len);
+
+extern char *
+net_recv_blob(SOCKET s,
+        uint32 max,
+        uint32 *plen,
+        int ms);
+
+extern bool_e
+net_is_down(const char *phost,
+        uint16 port);
+
+extern void
+net_down(const char *phost,
+        uint16 port);
+
+extern status_t
+net_serve(uint16 port,
+        void (*pfunc)(SOCKET s));
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* NET_H_ */
+/*-------------------------------End of net.h-------------------------------*/
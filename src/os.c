@@ -0,0 +1,588 @@
+/**
+ ******************************************************************************
+ * @file      os.c
+ * @brief     ϵͳغװ(ʱ, ߳, , ׷дļ)
+ * @details   This file including all API functions's implement of os.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <windows.h>
+#include "types.h"
+#include "os.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** os_parallel, ̰߳±ȡ */
+typedef struct
+{
+    void (*pfunc)(void *parg, int idx);
+    void *parg;
+    int num;
+    volatile long next;         /**< һδȡ± */
+} os_job_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+/** os_parallel߳(WaitForMultipleObjects) */
+#define MAX_THREADS         (64)
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static volatile long the_tmp_seq;   /**< os_fcopyʱļ */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   ȡ(߾ȼ)
+ * @return  
+ ******************************************************************************
+ */
+uint32
+os_ms(void)
+{
+    LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+
+    if (!QueryPerformanceFrequency(&freq) || !QueryPerformanceCounter(&now))
+    {
+        return GetTickCount();
+    }
+    return (uint32)(now.QuadPart * 1000 / freq.QuadPart);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȡcpu
+ * @return  cpu
+ ******************************************************************************
+ */
+int
+os_cpus(void)
+{
+    SYSTEM_INFO info;
+
+    GetSystemInfo(&info);
+    return (info.dwNumberOfProcessors > 0) ? (int)info.dwNumberOfProcessors : 1;
+}
+
+/**
+ ******************************************************************************
+ * @brief   os_parallelĹ߳: ȡ±ֱ
+ ******************************************************************************
+ */
+static DWORD WINAPI
+os_worker(LPVOID p)
+{
+    long i;
+    os_job_t *pjob = p;
+
+    while ((i = InterlockedIncrement(&pjob->next) - 1) < pjob->num)
+    {
+        pjob->pfunc(pjob->parg, (int)i);
+    }
+    return 0;
+}
+
+/**
+ ******************************************************************************
+ * @brief   cpuִ߳pfunc(parg, 0..num-1), ȫɺ󷵻
+ * @param[in]  num     : 
+ * @param[in]  *pfunc  : , ±껥
+ * @param[in]  *parg   : 
+ *
+ * @return  ʹõ߳
+ *
+ * @note    ǰ߳Ҳ, ߳ʧʱе߳
+ ******************************************************************************
+ */
+int
+os_parallel(int num,
+        void (*pfunc)(void *parg, int idx),
+        void *parg)
+{
+    int i;
+    int n = 0;
+    int max = os_cpus();
+    HANDLE threads[MAX_THREADS];
+    os_job_t job = {pfunc, parg, num, 0};
+
+    if (max > num)
+    {
+        max = num;
+    }
+    if (max > MAX_THREADS)
+    {
+        max = MAX_THREADS;
+    }
+    for (i = 1; i < max; i++)
+    {
+        threads[n] = CreateThread(NULL, 0, os_worker, &job, 0, NULL);
+        if (threads[n])
+        {
+            n++;
+        }
+    }
+    os_worker(&job);
+    if (n)
+    {
+        WaitForMultipleObjects(n, threads, TRUE, INFINITE);
+    }
+    for (i = 0; i < n; i++)
+    {
+        CloseHandle(threads[i]);
+    }
+
+    return n + 1;
+}
+
+/**
+ ******************************************************************************
+ * @brief   windowsĹ, ׷ӵ
+ * @param[out] *pcmd : 
+ * @param[in]  *parg : 
+ *
+ * @return  ׷ӵĳ
+ ******************************************************************************
+ */
+static int
+os_arg_quote(char *pcmd,
+        const char *parg)
+{
+    int n = 0;
+    int slash = 0;
+
+    if (*parg && !strpbrk(parg, " \t\""))
+    {
+        strcpy(pcmd, parg);
+        return strlen(parg);
+    }
+
+    pcmd[n++] = '"';
+    for (; *parg; parg++)
+    {
+        if (*parg == '\\')
+        {
+            slash++;
+        }
+        else
+        {
+            if (*parg == '"')
+            {
+                //ǰ\Ҫӱ, űת
+                for (slash = slash * 2 + 1; slash > 0; slash--)
+                {
+                    pcmd[n++] = '\\';
+                }
+            }
+            for (; slash > 0; slash--)
+            {
+                pcmd[n++] = '\\';
+            }
+        }
+        if (*parg != '\\')
+        {
+            pcmd[n++] = *parg;
+        }
+    }
+    //β\ǰҲҪӱ
+    for (slash *= 2; slash > 0; slash--)
+    {
+        pcmd[n++] = '\\';
+    }
+    pcmd[n++] = '"';
+    pcmd[n] = 0;
+
+    return n;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ضļ(ɱӽ̼̳)
+ ******************************************************************************
+ */
+static HANDLE
+os_redirect_open(const char *pfile,
+        DWORD std)
+{
+    SECURITY_ATTRIBUTES sa;
+
+    if (!pfile)
+    {
+        return GetStdHandle(std);
+    }
+    sa.nLength = sizeof(sa);
+    sa.lpSecurityDescriptor = NULL;
+    sa.bInheritHandle = TRUE;
+    return CreateFile(pfile, GENERIC_WRITE, FILE_SHARE_READ, &sa,
+            CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ƴ(ÿַ౻ת2)
+ * @param[in]  *argv : б, NULL
+ *
+ * @retval  NULL  : ڴ治
+ * @retval !NULL  : , freeͷ
+ ******************************************************************************
+ */
+static char *
+os_cmdline(char *const argv[])
+{
+    int i;
+    int len = 0;
+    char *pcmd;
+
+    for (i = 0; argv[i]; i++)
+    {
+        len += strlen(argv[i]) * 2 + 3;
+    }
+    pcmd = malloc(len + 1);
+    if (!pcmd)
+    {
+        return NULL;
+    }
+    for (i = 0, len = 0; argv[i]; i++)
+    {
+        if (i)
+        {
+            pcmd[len++] = ' ';
+        }
+        len += os_arg_quote(pcmd + len, argv[i]);
+    }
+    pcmd[len] = 0;
+
+    return pcmd;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ̲ȴ
+ * @param[in]  *argv : б, NULL, argv[0]Ϊ
+ * @param[in]  *pout : ׼ضļ(NULLʾض)
+ * @param[in]  *perr : ׼ضļ(NULLʾض)
+ *
+ * @retval  -1 : ޷
+ * @retval   : ˳
+ ******************************************************************************
+ */
+int
+os_run(char *const argv[],
+        const char *pout,
+        const char *perr)
+{
+    char *pcmd;
+    DWORD code = (DWORD)-1;
+    STARTUPINFO si;
+    PROCESS_INFORMATION pi;
+
+    //1. ƴ
+    pcmd = os_cmdline(argv);
+    if (!pcmd)
+    {
+        return -1;
+    }
+
+    //2. 
+    memset(&si, 0x00, sizeof(si));
+    si.cb = sizeof(si);
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+    si.hStdOutput = os_redirect_open(pout, STD_OUTPUT_HANDLE);
+    si.hStdError = (perr && pout && !strcmp(perr, pout))
+            ? si.hStdOutput : os_redirect_open(perr, STD_ERROR_HANDLE);
+
+    if (CreateProcess(NULL, pcmd, NULL, NULL, TRUE, 0, NULL, NULL, &si, &pi))
+    {
+        WaitForSingleObject(pi.hProcess, INFINITE);
+        GetExitCodeProcess(pi.hProcess, &code);
+        CloseHandle(pi.hThread);
+        CloseHandle(pi.hProcess);
+    }
+    else
+    {
+        printf("޷ִ: %s\n", pcmd);
+    }
+
+    if (pout)
+    {
+        CloseHandle(si.hStdOutput);
+    }
+    if (perr && (si.hStdError != si.hStdOutput))
+    {
+        CloseHandle(si.hStdError);
+    }
+    free(pcmd);
+
+    return (int)code;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ̨, ȴ
+ * @param[in]  *argv : б, NULL, argv[0]Ϊ
+ *
+ * @retval  OK    : Ѵ
+ * @retval  ERROR : ޷
+ *
+ * @note    ̳о̨, makeܵȴ
+ ******************************************************************************
+ */
+status_t
+os_spawn(char *const argv[])
+{
+    char *pcmd;
+    BOOL ok;
+    STARTUPINFO si;
+    PROCESS_INFORMATION pi;
+
+    pcmd = os_cmdline(argv);
+    if (!pcmd)
+    {
+        return ERROR;
+    }
+    memset(&si, 0x00, sizeof(si));
+    si.cb = sizeof(si);
+    ok = CreateProcess(NULL, pcmd, NULL, NULL, FALSE, DETACHED_PROCESS, NULL, NULL, &si, &pi);
+    if (ok)
+    {
+        CloseHandle(pi.hThread);
+        CloseHandle(pi.hProcess);
+    }
+    free(pcmd);
+
+    return ok ? OK : ERROR;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ļĩβ׷ַ
+ * @param[in]  *pfile : ļ
+ * @param[in]  *pstr  : ַ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note    бʱͬʱ׷, FILE_APPEND_DATA֤ÿд벻
+ ******************************************************************************
+ */
+status_t
+os_append(const char *pfile,
+        const char *pstr)
+{
+    HANDLE h;
+    DWORD len = 0;
+    BOOL ok;
+
+    h = CreateFile(pfile, FILE_APPEND_DATA, FILE_SHARE_READ | FILE_SHARE_WRITE,
+            NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (h == INVALID_HANDLE_VALUE)
+    {
+        return ERROR;
+    }
+    ok = WriteFile(h, pstr, strlen(pstr), &len, NULL);
+    CloseHandle(h);
+
+    return (ok && (len == strlen(pstr))) ? OK : ERROR;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ļӳ䵽ڴ
+ * @param[in]  *pfile : ļ
+ * @param[out] *plen  : ļ
+ * @param[in]  copy   : Ƿдʱ(޸ֻڱ̿ɼ, дļ)
+ *
+ * @retval  NULL  : ʧ(ļڻΪ)
+ * @retval !NULL  : ӳַ
+ ******************************************************************************
+ */
+static char *
+fmap(const char *pfile,
+        uint32 *plen,
+        bool_e copy)
+{
+    HANDLE hfile;
+    HANDLE hmap;
+    void *paddr = NULL;
+
+    *plen = 0;
+    hfile = CreateFile(pfile, GENERIC_READ, FILE_SHARE_READ, NULL,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hfile == INVALID_HANDLE_VALUE)
+    {
+        return NULL;
+    }
+    *plen = GetFileSize(hfile, NULL);
+    if ((*plen > 0) && (*plen != (uint32)-1))
+    {
+        hmap = CreateFileMapping(hfile, NULL,
+                copy ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+        if (hmap)
+        {
+            paddr = MapViewOfFile(hmap, copy ? FILE_MAP_COPY : FILE_MAP_READ,
+                    0, 0, 0);
+            CloseHandle(hmap); //ͼӳЧ
+        }
+    }
+    CloseHandle(hfile);
+    if (!paddr)
+    {
+        *plen = 0;
+    }
+
+    return paddr;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ֻʽļӳ䵽ڴ
+ * @param[in]  *pfile : ļ
+ * @param[out] *plen  : ļ
+ *
+ * @retval  NULL  : ʧ(ļڻΪ)
+ * @retval !NULL  : ӳַ, os_funmapͷ
+ *
+ * @note    ӳݲ0β
+ ******************************************************************************
+ */
+const char *
+os_fmap(const char *pfile,
+        uint32 *plen)
+{
+    return fmap(pfile, plen, E_FALSE);
+}
+
+/**
+ ******************************************************************************
+ * @brief   дʱƷʽļӳ䵽ڴ, Ծ͵޸
+ * @param[in]  *pfile : ļ
+ * @param[out] *plen  : ļ
+ *
+ * @retval  NULL  : ʧ(ļڻΪ)
+ * @retval !NULL  : ӳַ, os_funmapͷ
+ *
+ * @note    ӳݲ0β, ޸Ĳдļ
+ ******************************************************************************
+ */
+char *
+os_fmap_copy(const char *pfile,
+        uint32 *plen)
+{
+    return fmap(pfile, plen, E_TRUE);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ͷos_fmap/os_fmap_copyӳ
+ * @param[in]  *paddr : ӳַ
+ *
+ * @return  None
+ ******************************************************************************
+ */
+void
+os_funmap(const char *paddr)
+{
+    if (paddr)
+    {
+        UnmapViewOfFile(paddr);
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ݲͬʱдļ, ͬʱ޸ʱ䲻
+ * @param[in]  *pfile : ļ
+ * @param[in]  *pstr  : 
+ * @param[in]  len    : 
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+status_t
+os_fupdate(const char *pfile,
+        const char *pstr,
+        int len)
+{
+    FILE *pfd;
+    uint32 size;
+    const char *pold;
+    bool_e same;
+    bool_e ok;
+
+    pold = os_fmap(pfile, &size);
+    same = (pold && (size == (uint32)len) && !memcmp(pold, pstr, len));
+    os_funmap(pold);
+    if (same)
+    {
+        return OK;
+    }
+
+    pfd = fopen(pfile, "wb");
+    if (!pfd)
+    {
+        return ERROR;
+    }
+    ok = (fwrite(pstr, 1, len, pfd) == (size_t)len);
+    if (fclose(pfd) || !ok)
+    {
+        return ERROR;
+    }
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ļ(дʱļٸ, Ľ̲ῴһ)
+ * @param[in]  *psrc : Դļ
+ * @param[in]  *pdst : Ŀļ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+status_t
+os_fcopy(const char *psrc,
+        const char *pdst)
+{
+    char tmp[MAX_PATH];
+
+    //ʱļ̺ż, (߳)ͬʱƵͬһĿʱ
+    snprintf(tmp, sizeof(tmp), "%s.%lu.%ld", pdst, (unsigned long)GetCurrentProcessId(),
+            InterlockedIncrement(&the_tmp_seq));
+    if (!CopyFile(psrc, tmp, FALSE))
+    {
+        return ERROR;
+    }
+    if (!MoveFileEx(tmp, pdst, MOVEFILE_REPLACE_EXISTING))
+    {
+        DeleteFile(tmp);
+        return ERROR;
+    }
+    return OK;
+}
+
+/*-----------------------------------os.c------------------------------------*/
@@ -0,0 +1,86 @@
+/**
+ ******************************************************************************
+ * @file       os.h
+ * @brief      API include file of os.h.
+ * @details    This file including all API functions's declare of os.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef OS_H_
+#define OS_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include "types.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern uint32
+os_ms(void);
+
+extern int
+os_cpus(void);
+
+extern int
+os_parallel(int num,
+        void (*pfunc)(void *parg, int idx),
+        void *parg);
+
+extern int
+os_run(char *const argv[],
+        const char *pout,
+        const char *perr);
+
+extern status_t
+os_spawn(char *const argv[]);
+
+extern status_t
+os_append(const char *pfile,
+        const char *pstr);
+
+extern const char *
+os_fmap(const char *pfile,
+        uint32 *plen);
+
+extern char *
+os_fmap_copy(const char *pfile,
+        uint32 *plen);
+
+extern void
+os_funmap(const char *paddr);
+
+extern status_t
+os_fupdate(const char *pfile,
+        const char *pstr,
+        int len);
+
+extern status_t
+os_fcopy(const char *psrc,
+        const char *pdst);
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* OS_H_ */
+/*--------------------------------End of os.h--------------------------------*/
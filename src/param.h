@@ -13,7 +13,7 @@
 /*-----------------------------------------------------------------------------
  Section: Includes
  ----------------------------------------------------------------------------*/
-/* None */
+#include "types.h"
 
 /*-----------------------------------------------------------------------------
  Section: Macro Definitions
@@ -28,6 +28,7 @@ typedef struct
     char SRC_DIR[256];          /**< ԴĿ¼ */
     char BUILD_DIR[256];        /**< Ŀ¼ */
     char APP[128];              /**< Ӧó */
+    char NAME[64];              /**< .cproject(Debug/Release) */
     char CROSS_COMPILE[128];    /**< gcc */
     char I[2048];               /**< -Iͷļ */
     char CCFLAGS[512];          /**< gcc */
@@ -36,8 +37,45 @@ typedef struct
     char LIBS[512];             /**< -l̬ */
     char LD[128];               /**< ldļ */
     char EXCLUDE[1024 * 2];     /**< · */
+    char BENCH_SIM[512];        /**< ׼Է */
+    char BENCH_FUNCS[1024];     /**< ׼Ժ(|ָ) */
+    char BENCH_CPI[16];         /**< ÿָƽ */
+    char TRACE_DIRS[1024];      /**< ٵĿ¼(|ָ) */
+    char MAKE[128];             /**< make */
+    char PREBUILT_DIRS[1024];   /**< ʹԤĿ¼(|ָ) */
+    char PREBUILT_STORE[256];   /**< Ԥֿ */
+    char DELTA_REF[256];        /**< ɲĲο̼(.bin) */
+    char LZ_SECTIONS[256];      /**< ѹ̼(|ָ) */
 } pcfg_t;
 
+/**  */
+typedef struct
+{
+    char SRC_DIR[256];          /**< ԴĿ¼ */
+    char BUILD_DIR[256];        /**< Ŀ¼ */
+    char APP[128];              /**< Ӧó */
+    char NAME[64];              /**< .cproject(Debug/Release) */
+    char CROSS_COMPILE[128];    /**< gcc */
+    char *I;                    /**< -Iͷļ(path_exչ, Ȳ) */
+    char CCFLAGS[512];          /**< gcc */
+    char LDFLAGS[512];          /**< ld */
+    char *L;                    /**< -L̬·(path_exչ) */
+    char LIBS[512];             /**< -l̬ */
+    char LD[128];               /**< ldļ */
+    char EXCLUDE[1024 * 2];     /**< · */
+    char OTHER_D[64];           /**< -D */
+    char BENCH_SIM[512];        /**< ׼Է */
+    char BENCH_FUNCS[1024];     /**< ׼Ժ(|ָ) */
+    double BENCH_CPI;           /**< ÿָƽ */
+    char TRACE_DIRS[1024];      /**< ٵĿ¼(|ָ) */
+    char MAKE[128];             /**< make */
+    char PREBUILT_DIRS[1024];   /**< ʹԤĿ¼(|ָ) */
+    char PREBUILT_STORE[256];   /**< Ԥֿ */
+    char DELTA_REF[256];        /**< ɲĲο̼(.bin) */
+    char LZ_SECTIONS[256];      /**< ѹ̼(|ָ) */
+    bool_e TRACE;               /**< ǷΪٰ汾 */
+} make_cfg_t;
+
 /*-----------------------------------------------------------------------------
  Section: Globals
  ----------------------------------------------------------------------------*/
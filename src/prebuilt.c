@@ -0,0 +1,587 @@
+/**
+ ******************************************************************************
+ * @file      prebuilt.c
+ * @brief     Դ뼰ûϵͳֱӲֿеԤ
+ * @details   This file including all API functions's implement of prebuilt.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <io.h>
+#include "types.h"
+#include "maths.h"
+#include "param.h"
+#include "os.h"
+#include "hash.h"
+#include "stamp.h"
+#include "confh.h"
+#include "prebuilt.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** ʹԤĿ¼ */
+typedef struct
+{
+    char dir[256];              /**< ԴĿ¼, sys/os */
+    char name[256];             /**< make, sys_os */
+    char entry[512];            /**< ֿеλ(ԱĿ¼) */
+    uint64 key;                 /**< Դļָ */
+    int file_num;
+    bool_e hit;
+} prebuilt_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+#define PREBUILT_MAX_DIRS   (16)
+
+/** ·С */
+#define PATH_BUF_SIZE       (512u)
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static prebuilt_t the_pre[PREBUILT_MAX_DIRS];
+static int the_pre_num;
+static char the_store[PATH_BUF_SIZE];   /**< ֿ(ԱĿ¼) */
+static char the_top[PATH_BUF_SIZE];     /**< makefileĿ¼(ԱĿ¼) */
+static char the_cross[128];
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   ·תΪԴĿ¼, ָΪ'/'
+ * @param[in]  *path : ·, "./\\sys\\os\\a.c"
+ * @param[out] *pout : "sys/os/a.c"
+ * @param[in]  len   : 泤
+ *
+ * @return  None
+ ******************************************************************************
+ */
+static void
+prebuilt_rel(const char *path,
+        char *pout,
+        int len)
+{
+    int i;
+
+    while ((path[0] == '.') && ((path[1] == '/') || (path[1] == '\\')))
+    {
+        path += 2;
+    }
+    while ((*path == '/') || (*path == '\\'))
+    {
+        path++;
+    }
+    for (i = 0; (i < len - 1) && path[i]; i++)
+    {
+        pout[i] = (path[i] == '\\') ? '/' : path[i];
+    }
+    for (pout[i] = 0; (i > 0) && (pout[i - 1] == '/'); i--)
+    {
+        pout[i - 1] = 0;
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ļ(Ŀ¼ед)ԴĿ¼е·
+ ******************************************************************************
+ */
+static const char *
+prebuilt_root_path(const char *pdep)
+{
+    return strncmp(pdep, "../", 3) ? pdep : pdep + 3;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ʼһ
+ * @param[in]  *pcfg : (PREBUILT_DIRSPREBUILT_STORE)
+ * @param[in]  *ptop : makefileĿ¼(ԱĿ¼), ʱɾָ
+ *
+ * @return  None
+ ******************************************************************************
+ */
+void
+prebuilt_init(const make_cfg_t *pcfg,
+        const char *ptop)
+{
+    int i;
+    char *p;
+    char *delim = "|;";
+    char tmp[MEMBER_SIZE(make_cfg_t, PREBUILT_DIRS)];
+    prebuilt_t *ppre;
+
+    the_pre_num = 0;
+    strncpy(tmp, pcfg->PREBUILT_DIRS, sizeof(tmp) - 1);
+    tmp[sizeof(tmp) - 1] = 0;
+    for (p = strtok(tmp, delim); p && (the_pre_num < PREBUILT_MAX_DIRS); p = strtok(NULL, delim))
+    {
+        ppre = &the_pre[the_pre_num];
+        memset(ppre, 0x00, sizeof(*ppre));
+        prebuilt_rel(p, ppre->dir, sizeof(ppre->dir));
+        if (!ppre->dir[0])
+        {
+            continue;
+        }
+        for (i = 0; ppre->dir[i]; i++)
+        {
+            ppre->name[i] = (isdigit(ppre->dir[i]) || islower((ppre->dir[i] | 0x20))) ? ppre->dir[i] : '_';
+        }
+        the_pre_num++;
+    }
+
+    //ֿΪ·ʱԴĿ¼, makeڱĿ¼ִ
+    p = (char *)pcfg->PREBUILT_STORE;
+    if ((p[0] == '/') || (p[0] == '\\') || (p[0] && (p[1] == ':')))
+    {
+        snprintf(the_store, sizeof(the_store), "%s", p);
+    }
+    else
+    {
+        prebuilt_rel(p, tmp, sizeof(tmp));
+        snprintf(the_store, sizeof(the_store), "../%s", tmp);
+    }
+    snprintf(the_top, sizeof(the_top), "%s", ptop);
+    snprintf(the_cross, sizeof(the_cross), "%s", pcfg->CROSS_COMPILE);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ԴļĿ¼ָ(ʱ)
+ * @param[in]  *pfile : Դļ
+ *
+ * @retval  OK    : ɹ(κĿ¼ʱ)
+ * @retval  ERROR : ޷ȡ
+ ******************************************************************************
+ */
+status_t
+prebuilt_add(const char *pfile)
+{
+    int i;
+    int n;
+    uint64 h;
+    char rel[PATH_BUF_SIZE];
+
+    prebuilt_rel(pfile, rel, sizeof(rel));
+    for (i = 0; i < the_pre_num; i++)
+    {
+        n = strlen(the_pre[i].dir);
+        if (!strncmp(rel, the_pre[i].dir, n) && (rel[n] == '/'))
+        {
+            if (OK != hash_file(pfile, &h))
+            {
+                return ERROR;
+            }
+            the_pre[i].key = hash_fnv(rel, strlen(rel) + 1, the_pre[i].key);
+            the_pre[i].key = hash_fnv(&h, sizeof(h), the_pre[i].key);
+            the_pre[i].file_num++;
+            break;
+        }
+    }
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ֿеĿ: ÿļ(Դļͷļ)ݶû
+ * @param[in]  *pentry : ֿеλ
+ * @param[in]  root    : TRUEʱԴĿ¼ִ, FALSEʱڱĿ¼ִ
+ *
+ * @retval  NULL  : Ч
+ * @retval  NULL : һ仯ļ
+ *
+ * @note    -confhɵconfig/<>.hڱĿ¼, ҲʱεĻû,
+ *          Ƚ. -D, -DѼָ
+ ******************************************************************************
+ */
+static const char *
+prebuilt_verify(const char *pentry,
+        bool_e root)
+{
+    unsigned long long want;
+    uint64 h;
+    char tmp[PATH_BUF_SIZE];
+    static char dep[PATH_BUF_SIZE];
+    FILE *pfd;
+    const char *pbad = NULL;
+
+    snprintf(tmp, sizeof(tmp), "%s/%s", pentry, PREBUILT_LIB);
+    if (access(tmp, 0))
+    {
+        return PREBUILT_LIB;
+    }
+    snprintf(tmp, sizeof(tmp), "%s/%s", pentry, PREBUILT_DEPS);
+    pfd = fopen(tmp, "r");
+    if (!pfd)
+    {
+        return PREBUILT_DEPS;
+    }
+    while (fgets(tmp, sizeof(tmp), pfd))
+    {
+        if ((sscanf(tmp, "%llx %511[^\r\n]", &want, dep) != 2)
+                || !strncmp(dep, CONFH_DIR "/", sizeof(CONFH_DIR)))
+        {
+            continue;
+        }
+        if ((OK != hash_file(root ? prebuilt_root_path(dep) : dep, &h)) || (h != want))
+        {
+            pbad = dep;
+            break;
+        }
+    }
+    fclose(pfd);
+
+    return pbad;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ڲֿвҸĿ¼Ԥ
+ * @param[in]  *pcfg   : 
+ * @param[in]  *pflags : ʵʵı(cc_flags)
+ *
+ * @return  еĿ¼
+ *
+ * @note    ֿÿһĿ¼: <ֿ>/<Ŀ¼>-<ָ>/lib.adeps.txt.
+ *          ָΪԴļ·, , (-confhȥ-D), -I, -D;
+ *          ͷļdeps.txt(ʱ.dļ)Ƚ
+ ******************************************************************************
+ */
+int
+prebuilt_lookup(const make_cfg_t *pcfg,
+        const char *pflags)
+{
+    int i;
+    int hits = 0;
+    uint64 key;
+    char entry[PATH_BUF_SIZE];
+    const char *pbad;
+    prebuilt_t *ppre;
+
+    for (i = 0; i < the_pre_num; i++)
+    {
+        ppre = &the_pre[i];
+        if (!ppre->file_num)
+        {
+            continue;
+        }
+        key = hash_fnv(pcfg->CROSS_COMPILE, strlen(pcfg->CROSS_COMPILE) + 1, ppre->key);
+        key = hash_fnv(pflags, strlen(pflags) + 1, key);
+        key = hash_fnv(pcfg->CCFLAGS, strlen(pcfg->CCFLAGS) + 1, key);
+        key = hash_fnv(pcfg->I, strlen(pcfg->I) + 1, key);
+        key = hash_fnv(pcfg->OTHER_D, strlen(pcfg->OTHER_D) + 1, key);
+        snprintf(ppre->entry, sizeof(ppre->entry), "%s/%s-%016llx", the_store, ppre->name,
+                (unsigned long long)key);
+
+        snprintf(entry, sizeof(entry), "%s", prebuilt_root_path(ppre->entry));
+        pbad = prebuilt_verify(entry, E_TRUE);
+        ppre->hit = pbad ? E_FALSE : E_TRUE;
+        if (ppre->hit)
+        {
+            hits++;
+            printf("Ԥ: %s -> %s\n", ppre->dir, entry);
+        }
+        else
+        {
+            printf("Ԥδ(%s): %s, 󷢲\n", pbad, ppre->dir);
+        }
+    }
+    return hits;
+}
+
+/**
+ ******************************************************************************
+ * @brief   Ŀ¼ǷʹԤ(subdir.mk)
+ * @param[in]  *path : ԴĿ¼
+ *
+ * @retval  TRUE  : ʹ
+ * @retval  FALSE : Դ
+ ******************************************************************************
+ */
+bool_e
+prebuilt_hit(const char *path)
+{
+    int i;
+    int n;
+    char rel[PATH_BUF_SIZE];
+
+    prebuilt_rel(path, rel, sizeof(rel));
+    for (i = 0; i < the_pre_num; i++)
+    {
+        n = strlen(the_pre[i].dir);
+        if (the_pre[i].hit && !strncmp(rel, the_pre[i].dir, n) && ((rel[n] == '/') || !rel[n]))
+        {
+            return E_TRUE;
+        }
+    }
+    return E_FALSE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ԤĹ
+ * @param[in]  *pfd : makefileļ
+ *
+ * @return  None
+ *
+ * @note
+ *  1. : PREBUILT_LIBSΪֿеĿ. prebuilt_xx.okԴļͷļ,
+ *     ޸ʱ±Ƚ, ɾָƲ, AutoMake
+ *  2. δ: ճ, prebuilt_xx.aͬ.dеֿ.
+ *     Ŀļ$(AR_DIRS), õ
+ ******************************************************************************
+ */
+void
+prebuilt_mk_write(FILE *pfd)
+{
+    int i;
+    unsigned long long h;
+    char tmp[PATH_BUF_SIZE];
+    char dep[PATH_BUF_SIZE];
+    const prebuilt_t *ppre;
+    FILE *pdeps;
+
+    fprintf(pfd, "# Prebuilt archives from the artifact store\nPREBUILT_LIBS :=\nPREBUILT_OK :=\n"
+            "PREBUILT_PUB :=\n\n");
+    for (i = 0; i < the_pre_num; i++)
+    {
+        ppre = &the_pre[i];
+        if (!ppre->file_num)
+        {
+            continue;
+        }
+        if (!ppre->hit)
+        {
+            fprintf(pfd,
+                    "PREBUILT_%s_OBJS := $(filter $(addsuffix /%s/%%,$(AR_DIRS)),$(OBJS) $(USER_OBJS))\n"
+                    "PREBUILT_PUB += prebuilt_%s.a\n\n"
+                    "prebuilt_%s.a: $(PREBUILT_%s_OBJS)\n"
+                    "\t@echo 'Publishing: %s'\n"
+                    "\t-@$(RM) \"$@\"\n"
+                    "\t%sar rcs \"$@\" $(PREBUILT_%s_OBJS)\n"
+                    "\t$(AUTOMAKE) -publish \"%s\" \"$@\" $(PREBUILT_%s_OBJS:%%.o=%%.d)\n"
+                    "\t@echo ' '\n\n",
+                    ppre->name, ppre->dir, ppre->name, ppre->name, ppre->name, ppre->dir,
+                    the_cross, ppre->name, ppre->entry, ppre->name);
+            continue;
+        }
+
+        fprintf(pfd, "PREBUILT_LIBS += %s/%s\nPREBUILT_OK += prebuilt_%s.ok\n\nprebuilt_%s.ok:",
+                ppre->entry, PREBUILT_LIB, ppre->name, ppre->name);
+        snprintf(tmp, sizeof(tmp), "%s/%s", prebuilt_root_path(ppre->entry), PREBUILT_DEPS);
+        pdeps = fopen(tmp, "r");
+        while (pdeps && fgets(tmp, sizeof(tmp), pdeps))
+        {
+            //ͷļ(·), г
+            if ((sscanf(tmp, "%llx %511[^\r\n]", &h, dep) == 2) && !strncmp(dep, "../", 3))
+            {
+                fprintf(pfd, " \\\n %s", dep);
+            }
+        }
+        if (pdeps)
+        {
+            fclose(pdeps);
+        }
+        fprintf(pfd, "\n\t$(AUTOMAKE) -prebuilt \"%s\" \"$@\" \"%s\"\n\n", ppre->entry, the_top);
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   Ԥ(makefile)
+ * @param[in]  argc  : 
+ * @param[in]  **argv : <ֿеλ> <> <.dļ...>
+ *
+ * @retval  EXIT_SUCCESS : ɹ
+ * @retval  EXIT_FAILURE : ʧ
+ *
+ * @note    ڱĿ¼ִ. ȸƿ, дdeps.txt, ûдĲ
+ ******************************************************************************
+ */
+int
+prebuilt_publish(int argc,
+        char **argv)
+{
+    int i;
+    int n;
+    int idx;
+    int old;
+    uint64 h;
+    uint32 size;
+    int len = 0;
+    int max = 0;
+    char *p;
+    char *pout = NULL;
+    const char *q;
+    const char *pbuf;
+    char tmp[PATH_BUF_SIZE];
+    const char *pentry;
+    hash_idx_t set;             /**< ļȥ */
+    bool_e nomem = E_FALSE;
+    int ret = EXIT_FAILURE;
+
+    if (argc < 2)
+    {
+        return EXIT_FAILURE;
+    }
+    pentry = argv[0];
+    memset(&set, 0x00, sizeof(set));
+
+    do
+    {
+        //1. ֿĿ¼(ཨ)
+        snprintf(tmp, sizeof(tmp), "%s", pentry);
+        p = strrchr(tmp, '/');
+        if (p)
+        {
+            *p = 0;
+            (void)mkdir(tmp);
+        }
+        (void)mkdir(pentry);
+        snprintf(tmp, sizeof(tmp), "%s/%s", pentry, PREBUILT_LIB);
+        if (OK != os_fcopy(argv[1], tmp))
+        {
+            printf("޷: %s\n", tmp);
+            break;
+        }
+
+        //2. .dļе, "a.o: ../a.c ../inc/a.h \\", -MP"../inc/a.h:"
+        for (i = 2; (i < argc) && (E_TRUE != nomem); i++)
+        {
+            pbuf = os_fmap(argv[i], &size);
+            if (!pbuf)
+            {
+                continue;
+            }
+            for (q = pbuf; q < pbuf + size; q += n + 1)
+            {
+                for (; (q < pbuf + size) && ((*q == ' ') || (*q == '\t') || (*q == '\r') || (*q == '\n')
+                        || ((*q == '\\') && (q + 1 < pbuf + size) && ((q[1] == '\r') || (q[1] == '\n'))));
+                        q++)
+                {
+                }
+                for (n = 0; (q + n < pbuf + size) && (q[n] != ' ') && (q[n] != '\t') && (q[n] != '\r')
+                        && (q[n] != '\n'); n++)
+                {
+                }
+                if ((n <= 0) || (q[n - 1] == ':') || (n >= (int)sizeof(tmp)))
+                {
+                    continue;
+                }
+                memcpy(tmp, q, n);
+                tmp[n] = 0;
+                old = set.num;
+                idx = hash_idx_find(&set, tmp, E_TRUE);
+                if (idx < 0)
+                {
+                    nomem = E_TRUE;
+                    break;
+                }
+                if ((idx != old) || (OK != hash_file(tmp, &h)))
+                {
+                    continue;
+                }
+                if (len + n + 20 > max)
+                {
+                    max = MAX(max * 2, len + n + 20);
+                    max = MAX(max, 4096);
+                    p = realloc(pout, max);
+                    if (!p)
+                    {
+                        nomem = E_TRUE;
+                        break;
+                    }
+                    pout = p;
+                }
+                len += sprintf(pout + len, "%016llx %s\n", (unsigned long long)h, tmp);
+            }
+            os_funmap(pbuf);
+        }
+        if (E_TRUE == nomem)
+        {
+            //ɾǰdeps.txt, ѻĿⲻ
+            snprintf(tmp, sizeof(tmp), "%s/%s", pentry, PREBUILT_DEPS);
+            remove(tmp);
+            printf("ڴ治, ޷: %s\n", pentry);
+            break;
+        }
+
+        //3. д
+        snprintf(tmp, sizeof(tmp), "%s/%s", pentry, PREBUILT_DEPS);
+        if (!len || (OK != os_fupdate(tmp, pout, len)))
+        {
+            printf("޷: %s\n", tmp);
+            break;
+        }
+        printf("ѷԤ: %s(%dļ)\n", pentry, set.num);
+        ret = EXIT_SUCCESS;
+    } while (0);
+    hash_idx_free(&set);
+    free(pout);
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   Ԥļ޸ʱ±Ƚ(makefile)
+ * @param[in]  argc  : 
+ * @param[in]  **argv : <ֿеλ> <ļ> <makefileĿ¼>
+ *
+ * @retval  EXIT_SUCCESS : û, ±ļ
+ * @retval  EXIT_FAILURE : ѹ, ɾָ, ҪAutoMake
+ ******************************************************************************
+ */
+int
+prebuilt_check(int argc,
+        char **argv)
+{
+    const char *pbad;
+    FILE *pfd;
+
+    if (argc < 3)
+    {
+        return EXIT_FAILURE;
+    }
+    pbad = prebuilt_verify(argv[0], E_FALSE);
+    if (pbad)
+    {
+        stamp_clear(argv[2]);
+        printf("Ԥѹ(%s仯): %s, AutoMake\n", pbad, argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    //д, ޸ʱ
+    pfd = fopen(argv[1], "w");
+    if (!pfd)
+    {
+        return EXIT_FAILURE;
+    }
+    fprintf(pfd, "%s\n", argv[0]);
+    fclose(pfd);
+
+    return EXIT_SUCCESS;
+}
+
+/*--------------------------------prebuilt.c---------------------------------*/
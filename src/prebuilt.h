@@ -0,0 +1,71 @@
+/**
+ ******************************************************************************
+ * @file       prebuilt.h
+ * @brief      API include file of prebuilt.h.
+ * @details    This file including all API functions's declare of prebuilt.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef PREBUILT_H_
+#define PREBUILT_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include "types.h"
+#include "param.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#define PREBUILT_DEPS       "deps.txt"  /**< ֿпļָ */
+#define PREBUILT_LIB        "lib.a"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern void
+prebuilt_init(const make_cfg_t *pcfg,
+        const char *ptop);
+
+extern status_t
+prebuilt_add(const char *pfile);
+
+extern int
+prebuilt_lookup(const make_cfg_t *pcfg,
+        const char *pflags);
+
+extern bool_e
+prebuilt_hit(const char *path);
+
+extern void
+prebuilt_mk_write(FILE *pfd);
+
+extern int
+prebuilt_publish(int argc,
+        char **argv);
+
+extern int
+prebuilt_check(int argc,
+        char **argv);
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* PREBUILT_H_ */
+/*-----------------------------End of prebuilt.h-----------------------------*/
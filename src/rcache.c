@@ -0,0 +1,701 @@
+/**
+ ******************************************************************************
+ * @file      rcache.c
+ * @brief     ԶĿļ: ѰַHTTP GET/PUT, ػ
+ * @details   This file including all API functions's implement of rcache.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <io.h>
+#include <sys/stat.h>
+#include <winsock2.h>
+#include <windows.h>
+#include "types.h"
+#include "maths.h"
+#include "os.h"
+#include "hash.h"
+#include "net.h"
+#include "rcache.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+#define GET_MS              (5000)          /**< سʱ */
+#define PUT_MS              (30000)         /**< ϴʱ */
+#define MAX_OBJ             (64u << 20)     /**< Ŀļ󳤶 */
+#define MAX_HEAD            (4096)          /**< HTTPͷ󳤶 */
+
+#define CC_ID               ".cache_id"         /**< ʶ(Ŀ¼) */
+#define CACHE_DIR           ".automake_cache"   /**< ĬĿ¼ */
+#define UPLOAD_SUFFIX       ".up"               /**< ϴĿļ */
+#define KEY_SEED            (0x9e3779b97f4a7c15ull) /**< еڶϣĳֵ */
+
+/** ļС */
+#define READ_BUF_SIZE       (1024u)
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+/** : Ŀ¼, ʱļ */
+static char the_dir[MAX_PATH];
+static volatile long the_seq;
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   Զ̻ģʽ
+ * @retval  RCACHE_OFF : δAUTOMAKE_CACHE
+ * @retval  RCACHE_RO  : ֻ
+ * @retval  RCACHE_RW  : AUTOMAKE_CACHE_RWΪ1, ϴ
+ ******************************************************************************
+ */
+rcache_mode_e
+rcache_mode(void)
+{
+    const char *purl = getenv(RCACHE_ENV);
+    const char *prw = getenv(RCACHE_RW_ENV);
+
+    if (!purl || !purl[0])
+    {
+        return RCACHE_OFF;
+    }
+    return (prw && !strcmp(prw, "1")) ? RCACHE_RW : RCACHE_RO;
+}
+
+/**
+ ******************************************************************************
+ * @brief   AUTOMAKE_CACHE: [http://]host[:port][/·]
+ * @param[out] *phost     : 
+ * @param[in]  size       : phostĴС
+ * @param[out] *pport     : ˿
+ * @param[out] *ppath     : ·(/β, Ӽ)
+ * @param[in]  path_size  : ppathĴС
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : δûʽ
+ ******************************************************************************
+ */
+static status_t
+url_parse(char *phost,
+        int size,
+        uint16 *pport,
+        char *ppath,
+        int path_size)
+{
+    int n;
+    int len;
+    const char *purl = getenv(RCACHE_ENV);
+    const char *pslash;
+    const char *pcolon;
+
+    if (!purl || !purl[0])
+    {
+        return ERROR;
+    }
+    if (!strncmp(purl, "http://", 7))
+    {
+        purl += 7;
+    }
+    pslash = strchr(purl, '/');
+    if (!pslash)
+    {
+        pslash = purl + strlen(purl);
+    }
+    n = (int)(pslash - purl);
+    pcolon = memchr(purl, ':', n);
+    *pport = pcolon ? (uint16)atoi(pcolon + 1) : RCACHE_PORT;
+    if (pcolon)
+    {
+        n = (int)(pcolon - purl);
+    }
+    if (!n || (n >= size))
+    {
+        return ERROR;
+    }
+    memcpy(phost, purl, n);
+    phost[n] = 0;
+
+    len = strlen(pslash);
+    snprintf(ppath, path_size, "%s%s", pslash, (len && (pslash[len - 1] == '/')) ? "" : "/");
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ʶ: --versionĹϣ, ¼CC_IDй̹,
+ *          ޸ʱ򳤶ȸı()»ȡ
+ * @param[in]  *pcc : 
+ * @param[out] *pid : ʶ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ޷ִб
+ *
+ * @note    -v: кװ·, ͬϵͬһ汾Ҳ᲻ͬ
+ ******************************************************************************
+ */
+static status_t
+cc_id(const char *pcc,
+        uint64 *pid)
+{
+    long t;
+    long l;
+    long mtime = 0;
+    long size = 0;
+    unsigned long long h;
+    char cc[MAX_PATH];
+    char tmp[MAX_PATH];
+    char line[READ_BUF_SIZE];
+    char *argv[3];
+    status_t ret = ERROR;
+    struct _stat buf;
+    FILE *pfd;
+
+    //1. Ѽ¼
+    if (SearchPath(NULL, pcc, ".exe", sizeof(tmp), tmp, NULL) && !_stat(tmp, &buf))
+    {
+        mtime = (long)buf.st_mtime;
+        size = (long)buf.st_size;
+    }
+    pfd = fopen(CC_ID, "r");
+    while (pfd && fgets(line, sizeof(line), pfd))
+    {
+        if ((sscanf(line, "%llx %ld %ld %259[^\r\n]", &h, &t, &l, cc) == 4)
+                && (t == mtime) && (l == size) && !strcmp(cc, pcc))
+        {
+            *pid = h;
+            ret = OK;
+            break;
+        }
+    }
+    if (pfd)
+    {
+        fclose(pfd);
+    }
+    if (OK == ret)
+    {
+        return OK;
+    }
+
+    //2. ִб, еı̿ظ¼, ͬ
+    snprintf(tmp, sizeof(tmp), "%s.%lu", CC_ID, (unsigned long)GetCurrentProcessId());
+    argv[0] = (char *)pcc;
+    argv[1] = "--version";
+    argv[2] = NULL;
+    if (!os_run(argv, tmp, tmp) && (OK == hash_file(tmp, pid)))
+    {
+        snprintf(line, sizeof(line), "%016llx %ld %ld %s\n", (unsigned long long)*pid, mtime, size, pcc);
+        os_append(CC_ID, line);
+        ret = OK;
+    }
+    remove(tmp);
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   㻺ļ
+ * @param[in]  *argv : (ȥԤ, Դļ), argv[0]Ϊ
+ * @param[in]  *psrc : ԤԴļ
+ * @param[in]  len   : 
+ * @param[out] *pkey : (RCACHE_KEY_SIZE)
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ޷õʶ
+ *
+ * @note    Ϊʶ, Ԥ64λϣ, Ԥ
+ *          ȼһϣĵ32λ; ֻżȻͻ, ֻӦڿŵй
+ ******************************************************************************
+ */
+status_t
+rcache_key(char *const argv[],
+        const char *psrc,
+        uint32 len,
+        char *pkey)
+{
+    int i;
+    uint64 id;
+    uint64 h;
+
+    if (!argv[0] || (OK != cc_id(argv[0], &id)))
+    {
+        return ERROR;
+    }
+    h = hash_fnv(&id, sizeof(id), HASH_INIT);
+    for (i = 1; argv[i]; i++)
+    {
+        h = hash_fnv(argv[i], strlen(argv[i]) + 1, h); //β0, ֲ߽
+    }
+    h = hash_fnv(psrc, len, h);
+    snprintf(pkey, RCACHE_KEY_SIZE, "%016llx%08x%08x", (unsigned long long)h, len,
+            (uint32)hash_fnv(psrc, len, KEY_SEED));
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ӻ񲢷
+ * @param[in]  *pmethod : "GET""PUT"
+ * @param[in]  *pkey    : 
+ * @param[in]  *pbody   : PUT
+ * @param[in]  len      : 
+ *
+ * @retval  INVALID_SOCKET : δ, ʧܹ, ʧ
+ * @retval             : ѷ
+ ******************************************************************************
+ */
+static SOCKET
+http_request(const char *pmethod,
+        const char *pkey,
+        const void *pbody,
+        uint32 len)
+{
+    uint16 port;
+    char host[64];
+    char path[MAX_PATH];
+    char head[MAX_PATH + 256];
+    SOCKET s;
+
+    if ((OK != url_parse(host, sizeof(host), &port, path, sizeof(path)))
+            || (E_TRUE == net_is_down(host, port)) || (OK != net_init()))
+    {
+        return INVALID_SOCKET;
+    }
+    s = net_connect(host, port);
+    if (s == INVALID_SOCKET)
+    {
+        net_down(host, port);
+        return INVALID_SOCKET;
+    }
+    snprintf(head, sizeof(head), "%s %s%s HTTP/1.0\r\nHost: %s:%u\r\n"
+            "Content-Length: %u\r\nConnection: close\r\n\r\n", pmethod, path, pkey, host, port, len);
+    if ((OK != net_send(s, head, strlen(head))) || (len && (OK != net_send(s, pbody, len))))
+    {
+        closesocket(s);
+        return INVALID_SOCKET;
+    }
+    return s;
+}
+
+/**
+ ******************************************************************************
+ * @brief   HTTPͷ(ظ), ȡContent-Length
+ * @param[in]  s      : 
+ * @param[out] *pbuf  : ͷ(0β)յĲ
+ * @param[in]  size   : pbufĴС
+ * @param[out] *phead : ͷĳ()
+ * @param[out] *plen  : Content-Length, ûʱΪ0
+ * @param[in]  ms     : ʱ
+ *
+ * @retval  -1  : ʧ, ʱͷ̫
+ * @retval   : ѽյĳ
+ ******************************************************************************
+ */
+static int
+http_head(SOCKET s,
+        char *pbuf,
+        int size,
+        int *phead,
+        uint32 *plen,
+        int ms)
+{
+    int n = 0;
+    int k;
+    char *p;
+    char *pend = NULL;
+
+    //ͷû0, ֮ǰҵ
+    while (!pend)
+    {
+        k = (n < size - 1) ? net_recv_any(s, pbuf + n, size - 1 - n, ms) : 0;
+        if (k <= 0)
+        {
+            return -1;
+        }
+        n += k;
+        pbuf[n] = 0;
+        pend = strstr(pbuf, "\r\n\r\n");
+    }
+    *phead = (int)(pend + 4 - pbuf);
+
+    *plen = 0;
+    for (p = pbuf; (p = strstr(p, "\r\n")) && (p < pend); )
+    {
+        p += 2;
+        if (!strncmp(p, "Content-Length:", 15) || !strncmp(p, "content-length:", 15))
+        {
+            *plen = strtoul(p + 15, NULL, 10);
+        }
+    }
+    return n;
+}
+
+/**
+ ******************************************************************************
+ * @brief   HTTP
+ * @param[in]  s     : 
+ * @param[in]  *pbuf : http_headյ
+ * @param[in]  n     : http_headķֵ
+ * @param[in]  head  : ͷĳ
+ * @param[in]  len   : Content-Length
+ * @param[in]  ms    : ʱ
+ *
+ * @retval  NULL  : ʧܻ̫
+ * @retval !NULL  : , freeͷ
+ ******************************************************************************
+ */
+static char *
+http_body(SOCKET s,
+        const char *pbuf,
+        int n,
+        int head,
+        uint32 len,
+        int ms)
+{
+    uint32 have = (uint32)(n - head);
+    char *pbody;
+
+    if ((len > MAX_OBJ) || (have > len))
+    {
+        return NULL;
+    }
+    pbody = malloc(len + 1);
+    if (!pbody)
+    {
+        return NULL;
+    }
+    memcpy(pbody, pbuf + head, have);
+    if (OK != net_recv(s, pbody + have, len - have, ms))
+    {
+        free(pbody);
+        return NULL;
+    }
+    return pbody;
+}
+
+/**
+ ******************************************************************************
+ * @brief   Զ̻Ŀļ
+ * @param[in]  *pkey : 
+ * @param[in]  *pobj : Ŀļ
+ *
+ * @retval  OK    : , дĿļ
+ * @retval  ERROR : δл򻺴񲻿
+ ******************************************************************************
+ */
+status_t
+rcache_get(const char *pkey,
+        const char *pobj)
+{
+    int n;
+    int head = 0;
+    int code = 0;
+    uint32 len = 0;
+    char buf[MAX_HEAD];
+    char *pbody = NULL;
+    status_t ret = ERROR;
+    FILE *pfd;
+    SOCKET s;
+
+    s = http_request("GET", pkey, NULL, 0);
+    if (s == INVALID_SOCKET)
+    {
+        return ERROR;
+    }
+    do
+    {
+        n = http_head(s, buf, sizeof(buf), &head, &len, GET_MS);
+        if ((n < 0) || (sscanf(buf, "HTTP/%*s %d", &code) != 1) || (code != 200) || !len)
+        {
+            break;
+        }
+        pbody = http_body(s, buf, n, head, len, GET_MS);
+        if (!pbody)
+        {
+            break;
+        }
+
+        //Ŀļд(make޸ʱж)
+        pfd = fopen(pobj, "wb");
+        if (!pfd)
+        {
+            break;
+        }
+        n = (fwrite(pbody, 1, len, pfd) == len);
+        if (fclose(pfd) || !n)
+        {
+            remove(pobj);
+            break;
+        }
+        ret = OK;
+    } while (0);
+    closesocket(s);
+    free(pbody);
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ̨ϴĿļ: һݺAutoMake -cache-putϴ, ȴ
+ * @param[in]  *pkey : 
+ * @param[in]  *pobj : Ŀļ
+ *
+ * @return  None
+ *
+ * @note    Ϊϴڼ±벻дϴ
+ ******************************************************************************
+ */
+void
+rcache_put(const char *pkey,
+        const char *pobj)
+{
+    char self[MAX_PATH];
+    char tmp[MAX_PATH + 8];
+    char *argv[5];
+
+    if (!GetModuleFileName(NULL, self, sizeof(self)))
+    {
+        return;
+    }
+    snprintf(tmp, sizeof(tmp), "%s" UPLOAD_SUFFIX, pobj);
+    if (OK != os_fcopy(pobj, tmp))
+    {
+        return;
+    }
+    argv[0] = self;
+    argv[1] = "-cache-put";
+    argv[2] = (char *)pkey;
+    argv[3] = tmp;
+    argv[4] = NULL;
+    if (OK != os_spawn(argv))
+    {
+        remove(tmp);
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ϴ(rcache_putںִ̨): AutoMake -cache-put <> <ļ>
+ * @param[in]  argc  : 
+ * @param[in]  **argv : , ļ(ϴɾ)
+ *
+ * @retval  EXIT_SUCCESS : ɹ
+ * @retval  EXIT_FAILURE : ʧ
+ ******************************************************************************
+ */
+int
+rcache_upload(int argc,
+        char **argv)
+{
+    int head;
+    int code = 0;
+    uint32 len = 0;
+    char buf[MAX_HEAD];
+    const char *pdata;
+    SOCKET s = INVALID_SOCKET;
+
+    if (argc != 2)
+    {
+        return EXIT_FAILURE;
+    }
+    pdata = os_fmap(argv[1], &len);
+    if (pdata && (strlen(argv[0]) == RCACHE_KEY_SIZE - 1))
+    {
+        s = http_request("PUT", argv[0], pdata, len);
+    }
+    if (s != INVALID_SOCKET)
+    {
+        if ((http_head(s, buf, sizeof(buf), &head, &len, PUT_MS) < 0)
+                || (sscanf(buf, "HTTP/%*s %d", &code) != 1))
+        {
+            code = 0;
+        }
+        closesocket(s);
+    }
+    os_funmap(pdata);
+    remove(argv[1]);
+
+    return ((code >= 200) && (code < 300)) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   : ǷЧ(ֻ16ַ, ܷʴĿ¼ļ)
+ ******************************************************************************
+ */
+static bool_e
+key_valid(const char *pkey)
+{
+    int i;
+
+    for (i = 0; i < RCACHE_KEY_SIZE - 1; i++)
+    {
+        if (!isxdigit((uint8)pkey[i]))
+        {
+            return E_FALSE;
+        }
+    }
+    return pkey[i] ? E_FALSE : E_TRUE;
+}
+
+/**
+ ******************************************************************************
+ * @brief   : ͻظ
+ ******************************************************************************
+ */
+static void
+server_reply(SOCKET s,
+        int code,
+        const char *pmsg,
+        const void *pbody,
+        uint32 len)
+{
+    char head[128];
+
+    snprintf(head, sizeof(head), "HTTP/1.0 %d %s\r\nContent-Length: %u\r\n"
+            "Connection: close\r\n\r\n", code, pmsg, len);
+    if ((OK == net_send(s, head, strlen(head))) && len)
+    {
+        net_send(s, pbody, len);
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   : һ(net_serve߳е)
+ * @param[in]  s : 
+ *
+ * @return  None
+ ******************************************************************************
+ */
+static void
+server_conn(SOCKET s)
+{
+    int n;
+    int ok;
+    int head;
+    uint32 len = 0;
+    char buf[MAX_HEAD];
+    char method[8];
+    char path[MAX_PATH];
+    char file[MAX_PATH * 2];
+    char tmp[MAX_PATH * 2 + 16];
+    char *pkey;
+    char *pbody = NULL;
+    const char *pdata;
+    FILE *pfd;
+
+    n = http_head(s, buf, sizeof(buf), &head, &len, PUT_MS);
+    if ((n < 0) || (sscanf(buf, "%7s %259s", method, path) != 2))
+    {
+        return;
+    }
+    pkey = strrchr(path, '/');
+    pkey = pkey ? pkey + 1 : path;
+    if (E_TRUE != key_valid(pkey))
+    {
+        server_reply(s, 400, "Bad Request", NULL, 0);
+        return;
+    }
+    snprintf(file, sizeof(file), "%s/%s", the_dir, pkey);
+
+    if (!strcmp(method, "GET"))
+    {
+        pdata = os_fmap(file, &len);
+        if (pdata)
+        {
+            server_reply(s, 200, "OK", pdata, len);
+            os_funmap(pdata);
+        }
+        else
+        {
+            server_reply(s, 404, "Not Found", NULL, 0);
+        }
+        printf("GET %s %s\n", pkey, pdata ? "" : "δ");
+    }
+    else if (!strcmp(method, "PUT") && len
+            && (pbody = http_body(s, buf, n, head, len, PUT_MS)))
+    {
+        //дʱļٸ, ͬʱеGET
+        snprintf(tmp, sizeof(tmp), "%s.%ld", file, InterlockedIncrement(&the_seq));
+        pfd = fopen(tmp, "wb");
+        ok = pfd && (fwrite(pbody, 1, len, pfd) == len);
+        if (pfd && fclose(pfd))
+        {
+            ok = 0;
+        }
+        if (ok && MoveFileEx(tmp, file, MOVEFILE_REPLACE_EXISTING))
+        {
+            server_reply(s, 201, "Created", NULL, 0);
+        }
+        else
+        {
+            remove(tmp);
+            server_reply(s, 500, "Internal Server Error", NULL, 0);
+        }
+        printf("PUT %s %uֽ\n", pkey, len);
+        free(pbody);
+    }
+    else
+    {
+        server_reply(s, 400, "Bad Request", NULL, 0);
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ػ: AutoMake -cache-server [˿] [Ŀ¼]
+ * @param[in]  argc  : 
+ * @param[in]  **argv : [˿] [Ŀ¼]
+ *
+ * @retval  EXIT_FAILURE : ޷(ʱ)
+ *
+ * @note    ֻʵAutoMakeõGET/PUT, ڲԻСŶӹ;
+ *          Ҳɻκ֧GET/PUTHTTP
+ ******************************************************************************
+ */
+int
+rcache_server(int argc,
+        char **argv)
+{
+    int port = (argc > 0) ? atoi(argv[0]) : RCACHE_PORT;
+
+    strncpy(the_dir, (argc > 1) ? argv[1] : CACHE_DIR, sizeof(the_dir) - 1);
+    (void)mkdir(the_dir);
+    printf(": ˿%d, Ŀ¼%s\n", port, the_dir);
+    if (OK != net_serve((uint16)port, server_conn))
+    {
+        printf("޷˿%d\n", port);
+    }
+
+    return EXIT_FAILURE;
+}
+
+/*---------------------------------rcache.c----------------------------------*/
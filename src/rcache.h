@@ -0,0 +1,77 @@
+/**
+ ******************************************************************************
+ * @file       rcache.h
+ * @brief      API include file of rcache.h.
+ * @details    This file including all API functions's declare of rcache.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef RCACHE_H_
+#define RCACHE_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include "types.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+#define RCACHE_ENV          "AUTOMAKE_CACHE"    /**< Զ̻: http://host[:port][/·] */
+#define RCACHE_RW_ENV       "AUTOMAKE_CACHE_RW" /**< Ϊ1ʱϴ(Ĭֻ) */
+#define RCACHE_PORT         (3634)              /**< Ĭ϶˿ */
+#define RCACHE_KEY_SIZE     (33)                /**< : 128λϣ16ַ */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** Զ̻ģʽ */
+typedef enum
+{
+    RCACHE_OFF = 0,             /**< δAUTOMAKE_CACHE */
+    RCACHE_RO,                  /**< ֻ */
+    RCACHE_RW,                  /**< , ػϴ */
+} rcache_mode_e;
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern rcache_mode_e
+rcache_mode(void);
+
+extern status_t
+rcache_key(char *const argv[],
+        const char *psrc,
+        uint32 len,
+        char *pkey);
+
+extern status_t
+rcache_get(const char *pkey,
+        const char *pobj);
+
+extern void
+rcache_put(const char *pkey,
+        const char *pobj);
+
+extern int
+rcache_upload(int argc,
+        char **argv);
+
+extern int
+rcache_server(int argc,
+        char **argv);
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* RCACHE_H_ */
+/*-------------------------------End of rcache.h-------------------------------*/
@@ -0,0 +1,271 @@
+/**
+ ******************************************************************************
+ * @file      stamp.c
+ * @brief     ָ, ûб仯ʱmakefile
+ * @details   This file including all API functions's implement of stamp.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "types.h"
+#include "hash.h"
+#include "stamp.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** Ŀ¼ */
+typedef struct
+{
+    char *pname;
+    long mtime;                 /**< 0ʾ¼ʱձ޸Ĺ, ´αȻһ */
+} stamp_dir_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+#define STAMP_FILE          ".automake_stamp"   /**< ָļ(ڱĿ¼) */
+
+/** ·С */
+#define PATH_BUF_SIZE       (512u)
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static bool_e the_begin;        /**< Ƿڼ¼Ŀ¼ */
+static time_t the_start;        /**< ʼʱ */
+static stamp_dir_t *the_dirs;
+static int the_dir_num;
+static int the_dir_max;
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   ָ
+ * @param[in]  *pargs  : ӰɽĲ(汾, -D)
+ * @param[in]  pfiles  : ļ(NULL), ڵļҲ
+ *
+ * @return  ָ
+ ******************************************************************************
+ */
+uint64
+stamp_key(const char *pargs,
+        const char *const pfiles[])
+{
+    int i;
+    uint64 h;
+    uint64 key = hash_str(pargs);
+
+    for (i = 0; pfiles[i]; i++)
+    {
+        if (OK != hash_file(pfiles[i], &h))
+        {
+            h = 0;
+        }
+        key = hash_fnv(&h, sizeof(h), key);
+    }
+    return key;
+}
+
+/**
+ ******************************************************************************
+ * @brief   жǷϴʱһ
+ * @param[in]  *pdir     : Ŀ¼
+ * @param[in]  key       : εָ
+ * @param[out] *pobj_cnt : ϴβԴļ
+ *
+ * @retval  OK    : һ, 
+ * @retval  ERROR : Ҫ
+ *
+ * @note    ֻstatϴμ¼Ŀ¼, Ŀ¼ɾļĿ¼ı޸ʱ
+ ******************************************************************************
+ */
+status_t
+stamp_check(const char *pdir,
+        uint64 key,
+        int *pobj_cnt)
+{
+    FILE *pfd;
+    long mtime;
+    unsigned long long h;
+    status_t ret = ERROR;
+    struct _stat buf;
+    char line[PATH_BUF_SIZE + 32];
+    char name[PATH_BUF_SIZE];
+
+    snprintf(line, sizeof(line), "%s/%s", pdir, STAMP_FILE);
+    pfd = fopen(line, "r");
+    if (!pfd)
+    {
+        return ERROR;
+    }
+
+    do
+    {
+        if (!fgets(line, sizeof(line), pfd)
+                || (sscanf(line, "K %llx %d", &h, pobj_cnt) != 2)
+                || (h != key))
+        {
+            break;
+        }
+        ret = OK;
+        while ((OK == ret) && fgets(line, sizeof(line), pfd))
+        {
+            if ((sscanf(line, "D %ld\t%511[^\r\n]", &mtime, name) != 2)
+                    || _stat(name, &buf)
+                    || ((long)buf.st_mtime != mtime))
+            {
+                ret = ERROR;
+            }
+        }
+    } while (0);
+    fclose(pfd);
+
+    return ret;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ʼ: ɾָ, ʼ¼Ŀ¼
+ * @param[in]  *pdir : Ŀ¼
+ *
+ * @return  None
+ ******************************************************************************
+ */
+void
+stamp_begin(const char *pdir)
+{
+    char file[PATH_BUF_SIZE];
+
+    snprintf(file, sizeof(file), "%s/%s", pdir, STAMP_FILE);
+    remove(file); //;ʧʱ¾ָ
+    the_begin = E_TRUE;
+    the_start = time(NULL);
+    the_dir_num = 0;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ¼һĿ¼(ڶȡĿ¼֮ǰ)
+ * @param[in]  *path : Ŀ¼
+ *
+ * @return  None
+ ******************************************************************************
+ */
+void
+stamp_dir_add(const char *path)
+{
+    void *p;
+    struct _stat buf;
+
+    if (!the_begin)
+    {
+        return;
+    }
+    if (the_dir_num >= the_dir_max)
+    {
+        the_dir_max = the_dir_max ? (the_dir_max * 2) : 64;
+        p = realloc(the_dirs, the_dir_max * sizeof(*the_dirs));
+        if (!p)
+        {
+            the_begin = E_FALSE; //μ¼
+            return;
+        }
+        the_dirs = p;
+    }
+    the_dirs[the_dir_num].pname = strdup(path);
+    the_dirs[the_dir_num].mtime = 0;
+    //ͬһڱ޸ĵĿ¼, ʱͬҲѱ仯
+    if (!_stat(path, &buf) && (buf.st_mtime < the_start))
+    {
+        the_dirs[the_dir_num].mtime = (long)buf.st_mtime;
+    }
+    if (the_dirs[the_dir_num].pname)
+    {
+        the_dir_num++;
+    }
+}
+
+/**
+ ******************************************************************************
+ * @brief   ɳɹ󱣴ָ
+ * @param[in]  *pdir   : Ŀ¼
+ * @param[in]  key     : ָ
+ * @param[in]  obj_cnt : Դļ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+status_t
+stamp_save(const char *pdir,
+        uint64 key,
+        int obj_cnt)
+{
+    int i;
+    FILE *pfd;
+    char file[PATH_BUF_SIZE];
+
+    if (!the_begin)
+    {
+        return ERROR;
+    }
+    the_begin = E_FALSE;
+
+    snprintf(file, sizeof(file), "%s/%s", pdir, STAMP_FILE);
+    pfd = fopen(file, "w");
+    if (!pfd)
+    {
+        return ERROR;
+    }
+    fprintf(pfd, "K %016llx %d\n", (unsigned long long)key, obj_cnt);
+    for (i = 0; i < the_dir_num; i++)
+    {
+        fprintf(pfd, "D %ld\t%s\n", the_dirs[i].mtime, the_dirs[i].pname);
+        free(the_dirs[i].pname);
+    }
+    the_dir_num = 0;
+    fclose(pfd);
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ɾָ, ´ʱmakefile
+ * @param[in]  *pdir : Ŀ¼
+ *
+ * @return  None
+ ******************************************************************************
+ */
+void
+stamp_clear(const char *pdir)
+{
+    char file[PATH_BUF_SIZE];
+
+    snprintf(file, sizeof(file), "%s/%s", pdir, STAMP_FILE);
+    remove(file);
+}
+
+/*----------------------------------stamp.c----------------------------------*/
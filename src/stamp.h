@@ -0,0 +1,66 @@
+/**
+ ******************************************************************************
+ * @file       stamp.h
+ * @brief      API include file of stamp.h.
+ * @details    This file including all API functions's declare of stamp.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef STAMP_H_
+#define STAMP_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include "types.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern uint64
+stamp_key(const char *pargs,
+        const char *const pfiles[]);
+
+extern status_t
+stamp_check(const char *pdir,
+        uint64 key,
+        int *pobj_cnt);
+
+extern void
+stamp_begin(const char *pdir);
+
+extern void
+stamp_dir_add(const char *path);
+
+extern status_t
+stamp_save(const char *pdir,
+        uint64 key,
+        int obj_cnt);
+
+extern void
+stamp_clear(const char *pdir);
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* STAMP_H_ */
+/*------------------------------End of stamp.h-------------------------------*/
@@ -0,0 +1,225 @@
+/**
+ ******************************************************************************
+ * @file      symtab.c
+ * @brief     ͨnmȡelfеĺű
+ * @details   This file including all API functions's implement of symtab.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "symtab.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+/** ļС */
+#define READ_BUF_SIZE       (1024u)
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   ַȽ(qsortʹ)
+ ******************************************************************************
+ */
+static int
+sym_cmp(const void *pa,
+        const void *pb)
+{
+    const sym_t *pl = pa;
+    const sym_t *pr = pb;
+
+    if (pl->addr < pr->addr)
+    {
+        return -1;
+    }
+    return (pl->addr > pr->addr) ? 1 : 0;
+}
+
+/**
+ ******************************************************************************
+ * @brief   nmȡelfеĺ
+ * @param[out] *ptab   : ű
+ * @param[in]  *pcross : ǰ׺
+ * @param[in]  *pelf   : elfļ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ *
+ * @note    nm -S -nʽ: 00000134 00000020 T main
+ ******************************************************************************
+ */
+status_t
+symtab_load(symtab_t *ptab,
+        const char *pcross,
+        const char *pelf)
+{
+    FILE *pfd;
+    int max = 0;
+    unsigned int addr;
+    unsigned int size;
+    char type;
+    char line[READ_BUF_SIZE];
+    char name[READ_BUF_SIZE];
+    sym_t *pnew;
+
+    memset(ptab, 0x00, sizeof(*ptab));
+    snprintf(line, sizeof(line), "%snm -S -n --defined-only \"%s\"", pcross, pelf);
+    pfd = popen(line, "r");
+    if (!pfd)
+    {
+        printf("޷ִ: %s\n", line);
+        return ERROR;
+    }
+
+    while (fgets(line, sizeof(line), pfd))
+    {
+        if (sscanf(line, "%x %x %c %1023s", &addr, &size, &type, name) != 4)
+        {
+            continue; //ûгȵķ
+        }
+        if ((type != 'T') && (type != 't') && (type != 'W') && (type != 'w'))
+        {
+            continue; //ֻҪ
+        }
+        if (ptab->num == max)
+        {
+            max = max ? max * 2 : 256;
+            pnew = realloc(ptab->psym, max * sizeof(sym_t));
+            if (!pnew)
+            {
+                break;
+            }
+            ptab->psym = pnew;
+        }
+        ptab->psym[ptab->num].addr = addr & ~1u; //thumbλΪ1
+        ptab->psym[ptab->num].size = size;
+        ptab->psym[ptab->num].pname = strdup(name);
+        ptab->num++;
+    }
+    pclose(pfd);
+
+    if (ptab->num == 0)
+    {
+        printf("%sûҵ\n", pelf);
+        return ERROR;
+    }
+    qsort(ptab->psym, ptab->num, sizeof(sym_t), sym_cmp);
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ҵַĺ(ֲ)
+ * @param[in]  *ptab : ű
+ * @param[in]  addr  : ַ
+ *
+ * @retval  NULL : κκ
+ * @retval !NULL : 
+ ******************************************************************************
+ */
+const sym_t *
+symtab_find(const symtab_t *ptab,
+        uint32 addr)
+{
+    int lo = 0;
+    int hi = ptab->num - 1;
+    int mid;
+
+    addr &= ~1u;
+    while (lo <= hi)
+    {
+        mid = (lo + hi) / 2;
+        if (addr < ptab->psym[mid].addr)
+        {
+            hi = mid - 1;
+        }
+        else if (addr >= ptab->psym[mid].addr + ptab->psym[mid].size)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            return &ptab->psym[mid];
+        }
+    }
+    return NULL;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ֲҺ
+ * @param[in]  *ptab  : ű
+ * @param[in]  *pname : 
+ *
+ * @retval  NULL : Ҳ
+ * @retval !NULL : 
+ ******************************************************************************
+ */
+const sym_t *
+symtab_find_name(const symtab_t *ptab,
+        const char *pname)
+{
+    int i;
+
+    for (i = 0; i < ptab->num; i++)
+    {
+        if (!strcmp(ptab->psym[i].pname, pname))
+        {
+            return &ptab->psym[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ͷŷű
+ * @param[in]  *ptab : ű
+ *
+ * @return  None
+ ******************************************************************************
+ */
+void
+symtab_free(symtab_t *ptab)
+{
+    int i;
+
+    for (i = 0; i < ptab->num; i++)
+    {
+        free(ptab->psym[i].pname);
+    }
+    free(ptab->psym);
+    memset(ptab, 0x00, sizeof(*ptab));
+}
+
+/*--------------------------------symtab.c-----------------------------------*/
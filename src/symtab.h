@@ -0,0 +1,72 @@
+/**
+ ******************************************************************************
+ * @file       symtab.h
+ * @brief      API include file of symtab.h.
+ * @details    This file including all API functions's declare of symtab.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef SYMTAB_H_
+#define SYMTAB_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include "types.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/**  */
+typedef struct
+{
+    uint32 addr;                /**< ʼַ(ȥthumbλ) */
+    uint32 size;                /**<  */
+    char *pname;                /**<  */
+} sym_t;
+
+/** ű(ַ) */
+typedef struct
+{
+    sym_t *psym;
+    int num;
+} symtab_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern status_t
+symtab_load(symtab_t *ptab,
+        const char *pcross,
+        const char *pelf);
+
+extern const sym_t *
+symtab_find(const symtab_t *ptab,
+        uint32 addr);
+
+extern const sym_t *
+symtab_find_name(const symtab_t *ptab,
+        const char *pname);
+
+extern void
+symtab_free(symtab_t *ptab);
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* SYMTAB_H_ */
+/*-----------------------------End of symtab.h-------------------------------*/
@@ -0,0 +1,404 @@
+/**
+ ******************************************************************************
+ * @file      trace.c
+ * @brief     ڸ: ĿϵĻλٴ, Ͻ
+ * @details   This file including all API functions's implement of trace.c.
+ * @copyright Liuning
+ ******************************************************************************
+ */
+
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "types.h"
+#include "param.h"
+#include "symtab.h"
+#include "trace.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/** ټ¼(Ŀtrace_rec_tһ) */
+typedef struct
+{
+    uint32 fn;                  /**< ַ, bit0Ϊ1ʾ˳ */
+    uint32 ts;                  /**< DWTڼ */
+} trace_rec_t;
+
+/** ͳ */
+typedef struct
+{
+    uint32 calls;               /**< ô */
+    uint64 incl;                /**< Ӻ */
+} trace_stat_t;
+
+/*-----------------------------------------------------------------------------
+ Section: Constant Definitions
+ ----------------------------------------------------------------------------*/
+#define TRACE_MAGIC         (0x45435254u)   /**< "TRCE" */
+#define TRACE_HEAD_SIZE     (16u)           /**< magic, depth, head, rsv */
+#define TRACE_STACK         (256)           /**< ʱ */
+#define TRACE_REPORT        "trace.txt"
+
+/** Ŀϵĸٴ, ܱ-finstrument-functions׮ */
+#define TRACE_SRC                                                               \
+    "/* Automatically-generated file. Do not edit! by AutoMake */\n"            \
+    "#include <stdint.h>\n\n"                                                   \
+    "#ifndef TRACE_DEPTH\n"                                                     \
+    "#define TRACE_DEPTH 1024 /* records, power of 2 */\n"                      \
+    "#endif\n\n"                                                                \
+    "#define TRACE_MAGIC 0x45435254u\n"                                         \
+    "#define DEMCR      (*(volatile uint32_t *)0xE000EDFCu)\n"                  \
+    "#define DWT_CTRL   (*(volatile uint32_t *)0xE0001000u)\n"                  \
+    "#define DWT_CYCCNT (*(volatile uint32_t *)0xE0001004u)\n"                  \
+    "#define NO_TRACE   __attribute__((no_instrument_function))\n\n"           \
+    "typedef struct { uint32_t fn; uint32_t ts; } trace_rec_t;\n\n"             \
+    "/* dump this object (or the whole RAM) for AutoMake -trace */\n"           \
+    "struct {\n"                                                                \
+    "    uint32_t magic;\n"                                                     \
+    "    uint32_t depth;\n"                                                     \
+    "    volatile uint32_t head;\n"                                             \
+    "    uint32_t rsv;\n"                                                       \
+    "    trace_rec_t rec[TRACE_DEPTH];\n"                                       \
+    "} trace_buf __attribute__((used, aligned(8)));\n\n"                        \
+    "static NO_TRACE void trace_put(uint32_t fn)\n"                             \
+    "{\n"                                                                       \
+    "    uint32_t i;\n"                                                         \
+    "    trace_rec_t *p;\n\n"                                                   \
+    "    if (trace_buf.magic != TRACE_MAGIC) {\n"                               \
+    "        DEMCR |= 1u << 24;  /* TRCENA */\n"                                \
+    "        DWT_CTRL |= 1u;     /* CYCCNTENA */\n"                             \
+    "        trace_buf.depth = TRACE_DEPTH;\n"                                  \
+    "        trace_buf.magic = TRACE_MAGIC;\n"                                  \
+    "    }\n"                                                                   \
+    "    /* reserve a slot without locking, ISRs get their own slot */\n"      \
+    "    i = __atomic_fetch_add(&trace_buf.head, 1u, __ATOMIC_RELAXED);\n"      \
+    "    p = &trace_buf.rec[i & (TRACE_DEPTH - 1u)];\n"                         \
+    "    p->fn = fn;\n"                                                         \
+    "    p->ts = DWT_CYCCNT;\n"                                                 \
+    "}\n\n"                                                                     \
+    "NO_TRACE void __cyg_profile_func_enter(void *fn, void *site)\n"            \
+    "{\n"                                                                       \
+    "    (void)site;\n"                                                         \
+    "    trace_put((uint32_t)fn & ~1u);\n"                                      \
+    "}\n\n"                                                                     \
+    "NO_TRACE void __cyg_profile_func_exit(void *fn, void *site)\n"             \
+    "{\n"                                                                       \
+    "    (void)site;\n"                                                         \
+    "    trace_put((uint32_t)fn | 1u);\n"                                       \
+    "}\n"
+
+/*-----------------------------------------------------------------------------
+ Section: Global Variables
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Variables
+ ----------------------------------------------------------------------------*/
+static const trace_stat_t *the_stat;    /**<  */
+
+/*-----------------------------------------------------------------------------
+ Section: Local Function Prototypes
+ ----------------------------------------------------------------------------*/
+/* NONE */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Definitions
+ ----------------------------------------------------------------------------*/
+/**
+ ******************************************************************************
+ * @brief   Ŀϵĸٴ
+ * @param[in]  *pfile : ļ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+status_t
+trace_src_create(const char *pfile)
+{
+    FILE *pfd;
+
+    pfd = fopen(pfile, "w");
+    if (!pfd)
+    {
+        return ERROR;
+    }
+    fprintf(pfd, "%s", TRACE_SRC);
+    fclose(pfd);
+
+    return OK;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ȡС32λ
+ ******************************************************************************
+ */
+static uint32
+trace_get32(const uint8 *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32)p[3] << 24);
+}
+
+/**
+ ******************************************************************************
+ * @brief   ڴ澵вҸٻ
+ * @param[in]  *pbuf  : 
+ * @param[in]  size   : 񳤶
+ * @param[out] *pdepth: 
+ * @param[out] *phead : дָ
+ *
+ * @retval  NULL : Ҳ
+ * @retval !NULL : һ¼
+ *
+ * @note    ȿtrace_buf, ҲǷRAM
+ ******************************************************************************
+ */
+static const uint8 *
+trace_buf_find(const uint8 *pbuf,
+        long size,
+        uint32 *pdepth,
+        uint32 *phead)
+{
+    long i;
+    uint32 depth;
+
+    for (i = 0; i + (long)TRACE_HEAD_SIZE <= size; i += 4)
+    {
+        if (trace_get32(pbuf + i) != TRACE_MAGIC)
+        {
+            continue;
+        }
+        depth = trace_get32(pbuf + i + 4);
+        if ((depth == 0) || (depth & (depth - 1))
+                || ((size - i - TRACE_HEAD_SIZE) / sizeof(trace_rec_t) < depth))
+        {
+            continue; //ȱ2
+        }
+        *pdepth = depth;
+        *phead = trace_get32(pbuf + i + 8);
+        return pbuf + i + TRACE_HEAD_SIZE;
+    }
+    return NULL;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ʱ併Ƚ(qsortʹ)
+ ******************************************************************************
+ */
+static int
+trace_cmp(const void *pa,
+        const void *pb)
+{
+    const trace_stat_t *pl = &the_stat[*(const int *)pa];
+    const trace_stat_t *pr = &the_stat[*(const int *)pb];
+
+    if (pl->incl != pr->incl)
+    {
+        return (pl->incl < pr->incl) ? 1 : -1;
+    }
+    return (pl->calls < pr->calls) ? 1 : ((pl->calls > pr->calls) ? -1 : 0);
+}
+
+/**
+ ******************************************************************************
+ * @brief   طŸټ¼, ͳƸôͰʱ
+ * @param[in]  *ptab  : ű
+ * @param[in]  *prec  : һ¼
+ * @param[in]  depth  : 
+ * @param[in]  head   : дָ
+ * @param[out] *pstat : ͳ(űһһӦ)
+ *
+ * @return  Ч¼
+ ******************************************************************************
+ */
+static uint32
+trace_replay(const symtab_t *ptab,
+        const uint8 *prec,
+        uint32 depth,
+        uint32 head,
+        trace_stat_t *pstat)
+{
+    int j;
+    int k;
+    int sp = 0;
+    uint32 i;
+    uint32 n;
+    uint32 fn;
+    uint32 ts;
+    const sym_t *psym;
+    uint32 stack_fn[TRACE_STACK];
+    uint32 stack_ts[TRACE_STACK];
+
+    //ѻʱֻʣdepth
+    n = (head < depth) ? head : depth;
+    for (i = head - n; i != head; i++)
+    {
+        fn = trace_get32(prec + (i & (depth - 1)) * sizeof(trace_rec_t));
+        ts = trace_get32(prec + (i & (depth - 1)) * sizeof(trace_rec_t) + 4);
+
+        if (!(fn & 1u))
+        {
+            //
+            psym = symtab_find(ptab, fn);
+            if (psym)
+            {
+                pstat[psym - ptab->psym].calls++;
+            }
+            if (sp < TRACE_STACK)
+            {
+                stack_fn[sp] = fn;
+                stack_ts[sp] = ts;
+                sp++;
+            }
+            continue;
+        }
+
+        //˳: ҵӦĽ(мȱʧ˳ֱӶ)
+        fn &= ~1u;
+        for (j = sp - 1; (j >= 0) && (stack_fn[j] != fn); j--)
+        {
+        }
+        if (j < 0)
+        {
+            continue; //¼ѱ
+        }
+        //ݹʱֻͳ
+        for (k = 0; (k < j) && (stack_fn[k] != fn); k++)
+        {
+        }
+        psym = symtab_find(ptab, fn);
+        if (psym && (k == j))
+        {
+            pstat[psym - ptab->psym].incl += (uint32)(ts - stack_ts[j]);
+        }
+        sp = j;
+    }
+
+    return n;
+}
+
+/**
+ ******************************************************************************
+ * @brief   ٻĵļ
+ * @param[in]  *pcfg  : (ٰ汾)
+ * @param[in]  *pdump : ļ
+ *
+ * @retval  OK    : ɹ
+ * @retval  ERROR : ʧ
+ ******************************************************************************
+ */
+status_t
+trace_decode(const make_cfg_t *pcfg,
+        const char *pdump)
+{
+    int i;
+    int cnt = 0;
+    long size;
+    uint32 n;
+    uint32 depth = 0;
+    uint32 head = 0;
+    char tmp[512];
+    uint8 *pbuf = NULL;
+    const uint8 *prec;
+    int *pidx = NULL;
+    trace_stat_t *pstat = NULL;
+    FILE *pfd = NULL;
+    symtab_t tab;
+    status_t ret = ERROR;
+
+    snprintf(tmp, sizeof(tmp), "%s/%s.elf", pcfg->BUILD_DIR, pcfg->APP);
+    if (OK != symtab_load(&tab, pcfg->CROSS_COMPILE, tmp))
+    {
+        return ERROR;
+    }
+
+    do
+    {
+        //1. 뵼ļ
+        pfd = fopen(pdump, "rb");
+        if (!pfd)
+        {
+            printf("޷: %s\n", pdump);
+            break;
+        }
+        fseek(pfd, 0, SEEK_END);
+        size = ftell(pfd);
+        fseek(pfd, 0, SEEK_SET);
+        pbuf = malloc(size + 1);
+        if (!pbuf || (fread(pbuf, 1, size, pfd) != (size_t)size))
+        {
+            break;
+        }
+        fclose(pfd);
+        pfd = NULL;
+
+        prec = trace_buf_find(pbuf, size, &depth, &head);
+        if (!prec)
+        {
+            printf("%sҲٻ\n", pdump);
+            break;
+        }
+
+        //2. ͳ
+        pstat = calloc(tab.num, sizeof(trace_stat_t));
+        pidx = malloc(tab.num * sizeof(int));
+        if (!pstat || !pidx)
+        {
+            break;
+        }
+        n = trace_replay(&tab, prec, depth, head, pstat);
+        printf("%u¼(%u, д%u)\n\n", n, depth, head);
+
+        //3. ʱ
+        for (i = 0; i < tab.num; i++)
+        {
+            if (pstat[i].calls || pstat[i].incl)
+            {
+                pidx[cnt++] = i;
+            }
+        }
+        the_stat = pstat;
+        qsort(pidx, cnt, sizeof(int), trace_cmp);
+
+        snprintf(tmp, sizeof(tmp), "%s/%s", pcfg->BUILD_DIR, TRACE_REPORT);
+        pfd = fopen(tmp, "w");
+        if (pfd)
+        {
+            fprintf(pfd, "#function\tcalls\tinclusive_cycles\n");
+        }
+        printf("%-40s %10s %16s %12s\n", "function", "calls", "inclusive", "average");
+        for (i = 0; i < cnt; i++)
+        {
+            printf("%-40s %10u %16llu %12llu\n", tab.psym[pidx[i]].pname,
+                    pstat[pidx[i]].calls, (unsigned long long)pstat[pidx[i]].incl,
+                    pstat[pidx[i]].calls
+                    ? (unsigned long long)(pstat[pidx[i]].incl / pstat[pidx[i]].calls) : 0ull);
+            if (pfd)
+            {
+                fprintf(pfd, "%s\t%u\t%llu\n", tab.psym[pidx[i]].pname,
+                        pstat[pidx[i]].calls, (unsigned long long)pstat[pidx[i]].incl);
+            }
+        }
+        ret = OK;
+    } while (0);
+
+    if (pfd)
+    {
+        fclose(pfd);
+    }
+    free(pidx);
+    free(pstat);
+    free(pbuf);
+    symtab_free(&tab);
+
+    return ret;
+}
+
+/*---------------------------------trace.c-----------------------------------*/
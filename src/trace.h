@@ -0,0 +1,51 @@
+/**
+ ******************************************************************************
+ * @file       trace.h
+ * @brief      API include file of trace.h.
+ * @details    This file including all API functions's declare of trace.h.
+ * @copyright
+ *
+ ******************************************************************************
+ */
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#ifdef __cplusplus             /* Maintain C++ compatibility */
+extern "C" {
+#endif /* __cplusplus */
+/*-----------------------------------------------------------------------------
+ Section: Includes
+ ----------------------------------------------------------------------------*/
+#include "types.h"
+#include "param.h"
+
+/*-----------------------------------------------------------------------------
+ Section: Macro Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Type Definitions
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Globals
+ ----------------------------------------------------------------------------*/
+/* None */
+
+/*-----------------------------------------------------------------------------
+ Section: Function Prototypes
+ ----------------------------------------------------------------------------*/
+extern status_t
+trace_src_create(const char *pfile);
+
+extern status_t
+trace_decode(const make_cfg_t *pcfg,
+        const char *pdump);
+
+#ifdef __cplusplus      /* Maintain C++ compatibility */
+}
+#endif /* __cplusplus */
+#endif /* TRACE_H_ */
+/*------------------------------End of trace.h-------------------------------*/